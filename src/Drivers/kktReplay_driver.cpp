@@ -0,0 +1,323 @@
+#include "hiopNlpFormulation.hpp"
+#include "hiopInterface.hpp"
+#include "hiopLinSolverIndefDenseLapack.hpp"
+#ifdef HIOP_USE_GPU
+#include "hiopLinSolverIndefDenseMagma.hpp"
+#endif
+#include "hiopTimer.hpp"
+#include "hiopCSR_IO.hpp"
+#include "nlpDenseCons_empty.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+using namespace hiop;
+
+/**
+ * Replays the KKT linear systems saved by HiOp with the option 'write_kkt=yes' (files
+ * kkt_linsys_N.bkkt or kkt_linsys_N.iajaaa, see src/LinAlg/csr_iajaaa.md) through the dense indefinite linear
+ * solvers: each matrix is factorized and the saved right-hand sides are solved for with one multiple
+ * right-hand side solve. The factorization and solve times, the inertia, and the residuals are 
+ * reported per matrix.
+ */
+
+/** A linear system loaded from a .bkkt or .iajaaa file: the upper triangle of the symmetric matrix in
+ * CSR format (0-based) and the rhs-solution pairs */
+struct KKTDump
+{
+  int n, nnz;
+  std::vector<int> row_start, col;
+  std::vector<double> val;
+  std::vector<std::vector<double> > rhs, sol;
+};
+
+/* The row offsets in the files are 1-based. The column indexes are written 0-based by
+ * hiopCSR_IO but are 1-based for other writers of the format; they are taken as 1-based when 
+ * every column index is strictly larger than the 0-based index of its row, which does not 
+ * occur for a 0-based upper triangle with a diagonal entry. */
+static bool read_iajaaa(const char* fname, KKTDump& d)
+{
+  FILE* f = fopen(fname, "r");
+  if(NULL==f) {
+    printf("could not open '%s'\n", fname);
+    return false;
+  }
+  bool ok = (2==fscanf(f, "%d %d", &d.n, &d.nnz)) && d.n>=0 && d.nnz>=0;
+  if(ok) {
+    d.row_start.resize(d.n+1); d.col.resize(d.nnz); d.val.resize(d.nnz);
+    for(int i=0; ok && i<=d.n; i++)   ok = 1==fscanf(f, "%d", &d.row_start[i]);
+    for(int k=0; ok && k<d.nnz; k++)  ok = 1==fscanf(f, "%d", &d.col[k]);
+    for(int k=0; ok && k<d.nnz; k++)  ok = 1==fscanf(f, "%lf", &d.val[k]);
+  }
+  if(!ok || d.row_start[0]!=1 || d.row_start[d.n]!=d.nnz+1) {
+    printf("'%s' is not a valid .iajaaa file\n", fname);
+    fclose(f);
+    return false;
+  }
+  for(int i=0; i<=d.n; i++) d.row_start[i]--;
+
+  bool one_based = d.nnz>0;
+  for(int i=0; i<d.n && one_based; i++)
+    for(int k=d.row_start[i]; k<d.row_start[i+1]; k++)
+      if(d.col[k]<=i) { one_based=false; break; }
+  for(int k=0; k<d.nnz; k++) {
+    if(one_based) d.col[k]--;
+    if(d.col[k]<0 || d.col[k]>=d.n) {
+      printf("'%s': column index out of range\n", fname);
+      fclose(f);
+      return false;
+    }
+  }
+
+  //rhs-solution pairs until the end of the file
+  std::vector<double> v(d.n);
+  while(true) {
+    int i=0;
+    for(; i<d.n; i++) if(1!=fscanf(f, "%lf", &v[i])) break;
+    if(i<d.n || d.n==0) break;
+    if(d.rhs.size()==d.sol.size()) d.rhs.push_back(v); else d.sol.push_back(v);
+  }
+  if(d.rhs.size()>d.sol.size()) d.sol.push_back(std::vector<double>()); //rhs without solution
+  fclose(f);
+  return true;
+}
+
+/* the arrays of the binary dumps are copied from the memory mapping of the file */
+static bool read_bkkt(const char* fname, KKTDump& d)
+{
+  hiopCSR_BinaryView view;
+  if(!view.open(fname)) {
+    printf("'%s' is not a valid .bkkt file\n", fname);
+    return false;
+  }
+  d.n = view.n;
+  d.nnz = view.nnz;
+  d.row_start.assign(view.row_start, view.row_start+d.n+1);
+  d.col.assign(view.col, view.col+d.nnz);
+  d.val.assign(view.val, view.val+d.nnz);
+  for(int k=0; k<d.nnz; k++) {
+    if(d.col[k]<0 || d.col[k]>=d.n) {
+      printf("'%s': column index out of range\n", fname);
+      return false;
+    }
+  }
+  for(int k=0; k<view.num_vecs; k++) {
+    std::vector<std::vector<double> >& dest = k%2 ? d.sol : d.rhs;
+    dest.push_back(std::vector<double>(view.vec(k), view.vec(k)+d.n));
+  }
+  if(d.rhs.size()>d.sol.size()) d.sol.push_back(std::vector<double>()); //rhs without solution
+  return true;
+}
+
+static bool ends_with(const std::string& name, const std::string& suf)
+{
+  return name.size()>=suf.size() && name.compare(name.size()-suf.size(), suf.size(), suf)==0;
+}
+
+/* ||M*x-b||_inf / (1+||b||_inf) with M given by its upper triangle */
+static double rel_residual(const KKTDump& d, const double* x, const double* b)
+{
+  std::vector<double> r(b, b+d.n);
+  for(int i=0; i<d.n; i++)
+    for(int k=d.row_start[i]; k<d.row_start[i+1]; k++) {
+      const int j=d.col[k];
+      r[i] -= d.val[k]*x[j];
+      if(j!=i) r[j] -= d.val[k]*x[i];
+    }
+  double nrmr=0., nrmb=0.;
+  for(int i=0; i<d.n; i++) { nrmr = std::max(nrmr, std::fabs(r[i])); nrmb = std::max(nrmb, std::fabs(b[i])); }
+  return nrmr/(1+nrmb);
+}
+
+/* counter N of kkt_linsys_N.bkkt or kkt_linsys_N.iajaaa; -1 if the name does not match */
+static int dump_counter(const std::string& name)
+{
+  const std::string pre="kkt_linsys_", suf=ends_with(name, ".bkkt") ? ".bkkt" : ".iajaaa";
+  if(name.size()<=pre.size()+suf.size()) return -1;
+  if(name.compare(0, pre.size(), pre)!=0) return -1;
+  if(!ends_with(name, suf)) return -1;
+  const std::string num = name.substr(pre.size(), name.size()-pre.size()-suf.size());
+  if(num.find_first_not_of("0123456789")!=std::string::npos) return -1;
+  return atoi(num.c_str());
+}
+
+/* the dumps in a directory ordered on the counter, or the path itself if it is a file */
+static std::vector<std::string> list_dumps(const char* path)
+{
+  std::vector<std::pair<int,std::string> > files;
+  struct stat st;
+  if(0==stat(path, &st) && S_ISDIR(st.st_mode)) {
+    DIR* dir = opendir(path);
+    if(dir) {
+      struct dirent* ent;
+      while(NULL!=(ent=readdir(dir))) {
+	const int counter = dump_counter(ent->d_name);
+	if(counter>=0) files.push_back(std::make_pair(counter, std::string(path)+"/"+ent->d_name));
+      }
+      closedir(dir);
+    }
+    std::sort(files.begin(), files.end());
+  } else {
+    files.push_back(std::make_pair(0, std::string(path)));
+  }
+  std::vector<std::string> names;
+  for(auto& p : files) names.push_back(p.second);
+  return names;
+}
+
+static hiopLinSolverIndefDense* create_solver(const std::string& backend, int n, hiopNlpFormulation* nlp)
+{
+  if(backend=="lapack") {
+    return new hiopLinSolverIndefDenseLapack(n, nlp);
+  }
+#ifdef HIOP_USE_GPU
+  if(backend=="magma-buka") {
+    return new hiopLinSolverIndefDenseMagmaBuKa(n, nlp);
+  }
+  if(backend=="magma-nopiv") {
+    return new hiopLinSolverIndefDenseMagmaNopiv(n, nlp);
+  }
+#endif
+  return NULL;
+}
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver '%s' that replays the KKT linear systems saved with the option 'write_kkt=yes' "
+	 "through a dense indefinite linear solver and reports per matrix the factorization and solve "
+	 "times, the inertia, and the residuals.\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s path [solver] [-n11 k] [-ldl]'\n", exeName);
+  printf("Arguments: \n");
+  printf("  'path': a directory with kkt_linsys_N.bkkt or kkt_linsys_N.iajaaa files (replayed in the "
+	 "order of N) or one such file\n");
+  printf("  'solver': 'lapack' (default)%s\n",
+#ifdef HIOP_USE_GPU
+	 ", 'magma-buka', or 'magma-nopiv'"
+#else
+	 ""
+#endif
+	 );
+  printf("  '-n11 k': the leading k x k block is positive definite and its Schur complement negative "
+	 "definite (see hiopLinSolverIndefDense::set_quasidefinite_hint) [optional]\n");
+  printf("  '-ldl': use only Bunch-Kaufman (option dense_fact_strategy=ldl) [optional]\n");
+}
+
+int main(int argc, char **argv)
+{
+  std::string backend="lapack";
+  const char* path=NULL;
+  int n11=-1;
+  bool ldl_only=false;
+  for(int i=1; i<argc; i++) {
+    if(0==strcmp(argv[i], "-n11") && i+1<argc) {
+      n11 = atoi(argv[++i]);
+    } else if(0==strcmp(argv[i], "-ldl")) {
+      ldl_only = true;
+    } else if(NULL==path) {
+      path = argv[i];
+    } else {
+      backend = argv[i];
+    }
+  }
+  if(NULL==path) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  EmptyProblem problem;
+  hiopNlpDenseConstraints nlp(problem);
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+  if(ldl_only) nlp.options->SetStringValue("dense_fact_strategy", "ldl");
+
+  std::vector<std::string> files = list_dumps(path);
+  if(files.empty()) {
+    printf("no kkt_linsys_N.bkkt or kkt_linsys_N.iajaaa files found in '%s'\n", path);
+    return 1;
+  }
+
+  printf("%-32s %7s %9s %11s %11s %7s %7s %11s %11s\n", "file", "n", "nnz",
+	 "fact(sec)", "solve(sec)", "neg", "pos", "rel.resid", "sol.diff");
+  int num_failed=0;
+  double tm_fact_total=0., tm_solve_total=0.;
+  for(const std::string& fname : files) {
+    KKTDump d;
+    const bool ok = ends_with(fname, ".bkkt") ? read_bkkt(fname.c_str(), d) : read_iajaaa(fname.c_str(), d);
+    if(!ok) {
+      num_failed++;
+      continue;
+    }
+
+    hiopLinSolverIndefDense* solver = create_solver(backend, d.n, &nlp);
+    if(NULL==solver) {
+      printf("unknown or unavailable solver '%s'\n", backend.c_str());
+      usage(argv[0]);
+      return 1;
+    }
+    if(n11>=0 && n11<=d.n) solver->set_quasidefinite_hint(n11);
+
+    hiopMatrixDenseRowMajor& M = solver->sysMatrix();
+    M.setToZero();
+    double** MM = M.local_data();
+    for(int i=0; i<d.n; i++)
+      for(int k=d.row_start[i]; k<d.row_start[i+1]; k++)
+	MM[i][d.col[k]] = d.val[k];
+
+    hiopTimer tm_fact, tm_solve;
+    tm_fact.start();
+    const int neg = solver->matrixChanged();
+    tm_fact.stop();
+
+    double tm_solve_avg=0., resid=0., sol_diff=0.;
+    bool solve_ok = true;
+    const int nrhs = d.rhs.size();
+    if(neg>=0 && nrhs>0) {
+      //the saved right-hand sides are solved for at once, as the rows of a dense matrix
+      hiopMatrixDense* X = LinearAlgebraFactory::createMatrixDense(nrhs, d.n);
+      double** XX = X->local_data();
+      for(int r=0; r<nrhs; r++)
+	memcpy(XX[r], d.rhs[r].data(), d.n*sizeof(double));
+      tm_solve.start();
+      solve_ok = solver->solve(*X);
+      tm_solve.stop();
+
+      for(int r=0; r<nrhs; r++) {
+	resid = std::max(resid, rel_residual(d, XX[r], d.rhs[r].data()));
+	if(d.sol[r].size()==(size_t)d.n) {
+	  for(int i=0; i<d.n; i++) 
+	    sol_diff = std::max(sol_diff, std::fabs(XX[r][i]-d.sol[r][i]) / (1+std::fabs(d.sol[r][i])));
+	}
+      }
+      tm_solve_avg = tm_solve.getElapsedTime()/nrhs;
+      delete X;
+    }
+    delete solver;
+
+    const char* base = strrchr(fname.c_str(), '/');
+    base = base ? base+1 : fname.c_str();
+    if(neg<0) {
+      printf("%-32s %7d %9d %11.4e %11s %7s %7s %11s %11s  (singular)\n", base, d.n, d.nnz,
+	     tm_fact.getElapsedTime(), "-", "-", "-", "-", "-");
+      num_failed++;
+    } else {
+      //the inertia when the matrix is nonsingular
+      printf("%-32s %7d %9d %11.4e %11.4e %7d %7d %11.4e %11.4e%s\n", base, d.n, d.nnz,
+	     tm_fact.getElapsedTime(), tm_solve_avg, neg, d.n-neg, 
+	     nrhs>0 ? resid : 0., sol_diff, solve_ok ? "" : "  (solve failed)");
+      if(!solve_ok) num_failed++;
+    }
+    tm_fact_total += tm_fact.getElapsedTime();
+    tm_solve_total += tm_solve.getElapsedTime();
+  }
+  printf("%d systems: total factorization time %.4e sec, total solve time %.4e sec, %d failed\n",
+	 (int)files.size(), tm_fact_total, tm_solve_total, num_failed);
+  return num_failed>0;
+}
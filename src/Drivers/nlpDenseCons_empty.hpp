@@ -0,0 +1,30 @@
+#ifndef HIOP_EXAMPLE_EMPTY
+#define HIOP_EXAMPLE_EMPTY
+
+#include "hiopInterface.hpp"
+
+#ifdef HIOP_USE_MPI
+#include "mpi.h"
+#endif
+
+/** The linear solvers need a NLP formulation for the options, the log, the statistics, and
+ * the workspaces; this empty problem (no variables and no constraints) provides it to the 
+ * drivers and tests that use the linear solvers on their own, e.g., kktReplay.exe. */
+class EmptyProblem : public hiop::hiopInterfaceDenseConstraints
+{
+public:
+  bool get_prob_sizes(long long& n, long long& m) { n=0; m=0; return true; }
+  bool get_vars_info(const long long& n, double *xlow, double* xupp, NonlinearityType* type) { return true; }
+  bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type) { return true; }
+  bool eval_f(const long long& n, const double* x, bool new_x, double& obj_value) { obj_value=0.; return true; }
+  bool eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf) { return true; }
+  bool eval_cons(const long long& n, const long long& m, const long long& num_cons, const long long* idx_cons,
+		 const double* x, bool new_x, double* cons) { return true; }
+  bool eval_Jac_cons(const long long& n, const long long& m, const long long& num_cons, const long long* idx_cons,
+		     const double* x, bool new_x, double** Jac) { return true; }
+  bool get_starting_point(const long long& global_n, double* x0) { return true; }
+#ifdef HIOP_USE_MPI
+  bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=MPI_COMM_SELF; return true; }
+#endif
+};
+#endif
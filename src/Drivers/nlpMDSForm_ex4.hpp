@@ -412,6 +412,12 @@ public:
       memcpy(z_bndU0, sol_zu_, n*sizeof(double));
       memcpy(lambda0, sol_lambda_, m*sizeof(double));
 
+    } else if(sol_x_) {
+
+      //primal restart
+      duals_avail = false;
+      memcpy(x0, sol_x_, n*sizeof(double));
+
     } else {
       duals_avail = false;
       return false;
@@ -644,6 +650,34 @@ public:
     }
     return true;
   }
+
+  /** gradient, full Jacobian, and Hessian evaluated in one call */
+  virtual bool
+  eval_derivs(const long long& n, const long long& m,
+	      const double* x, bool new_x,
+	      const double& obj_factor, const double* lambda, bool new_lambda,
+	      const long long& nsparse, const long long& ndense,
+	      double* gradf,
+	      const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS,
+	      double** JacD,
+	      const int& nnzHSS, int* iHSS, int* jHSS, double* MHSS,
+	      double** HDD,
+	      int& nnzHSD, int* iHSD, int* jHSD, double* MHSD)
+  {
+    if(gradf!=NULL) {
+      if(!eval_grad_f(n, x, new_x, gradf)) return false;
+    }
+    if(MJacS!=NULL || JacD!=NULL) {
+      if(!eval_Jac_cons(n, m, x, new_x, nsparse, ndense, nnzJacS, iJacS, jJacS, MJacS, JacD))
+	return false;
+    }
+    if(MHSS!=NULL || HDD!=NULL) {
+      if(!eval_Hess_Lagr(n, m, x, new_x, obj_factor, lambda, new_lambda, nsparse, ndense,
+			 nnzHSS, iHSS, jHSS, MHSS, HDD, nnzHSD, iHSD, jHSD, MHSD))
+	return false;
+    }
+    return true;
+  }
 };
 
 #endif
@@ -17,9 +17,13 @@ static bool parse_arguments(int argc, char **argv,
 			    bool& self_check,
 			    long long& n_sp,
 			    long long& n_de,
-			    bool& one_call_cons)
+			    bool& one_call_cons,
+			    bool& scaled,
+			    bool& primal_restart)
 {
   self_check=false;
+  scaled=false;
+  primal_restart=false;
   n_sp = 1000;
   n_de = 1000;
   one_call_cons = false;
@@ -28,6 +32,15 @@ static bool parse_arguments(int argc, char **argv,
     //no arguments
     return true;
     break;
+  case 6: // 5 arguments
+    {
+      if(std::string(argv[5]) == "-scaled")
+	scaled=true;
+      else if(std::string(argv[5]) == "-primal_restart")
+	primal_restart=true;
+      else
+	return false;
+    }
   case 5: // 4 arguments
     {
       if(std::string(argv[4]) == "-selfcheck")
@@ -49,7 +62,7 @@ static bool parse_arguments(int argc, char **argv,
     }
     break;
   default: 
-    return false; //5 or more arguments
+    return false; //6 or more arguments
   }
 
   if(self_check && n_sp!=400 && n_de!=100)
@@ -63,7 +76,8 @@ static void usage(const char* exeName)
   printf("HiOp driver %s that solves a synthetic problem of variable size in the "
 	 "mixed dense-sparse formulation.\n", exeName);
   printf("Usage: \n");
-  printf("  '$ %s sp_vars_size de_vars_size eq_ineq_combined_nlp -selfcheck'\n", exeName);
+  printf("  '$ %s sp_vars_size de_vars_size eq_ineq_combined_nlp -selfcheck [-scaled | -primal_restart]'\n",
+	 exeName);
   printf("Arguments, all integers, excepting string '-selfcheck'\n");
   printf("  'sp_vars_size': # of sparse variables [default 400, optional]\n");
   printf("  'de_vars_size': # of dense variables [default 100, optional]\n");
@@ -71,6 +85,10 @@ static void usage(const char* exeName)
 	 "de_vars_size being 100 (these two exact values must be passed as arguments). [optional]\n");
   printf("  'eq_ineq_combined_nlp': 0 or 1, specifying whether the NLP formulation with split "
 	 "constraints should be used (0) or not (1) [default 0, optional]\n");
+  printf("  '-scaled': solves the problem with the gradient-based scaling (options 'scaling_type' "
+	 "and 'scaling_max_grad'), which changes the objective scaling [optional]\n");
+  printf("  '-primal_restart': the warm-started re-solve is given only the primal solution of the "
+	 "first solve [optional]\n");
 }
 
 
@@ -94,9 +112,9 @@ int main(int argc, char **argv)
   magma_init();
 #endif
 
-  bool selfCheck, one_call_cons;
+  bool selfCheck, one_call_cons, scaled, primal_restart;
   long long n_sp, n_de;
-  if(!parse_arguments(argc, argv, selfCheck, n_sp, n_de, one_call_cons)) {
+  if(!parse_arguments(argc, argv, selfCheck, n_sp, n_de, one_call_cons, scaled, primal_restart)) {
     usage(argv[0]);
     return 1;
   }
@@ -124,6 +142,11 @@ int main(int argc, char **argv)
   nlp.options->SetIntegerValue("verbosity_level", 3);
   nlp.options->SetNumericValue("mu0", 1e-1);
   nlp.options->SetNumericValue("tolerance", 1e-5);
+  if(scaled) {
+    //the objective and constraints with gradients larger than 1 at the starting point are scaled
+    nlp.options->SetStringValue("scaling_type", "gradient");
+    nlp.options->SetNumericValue("scaling_max_grad", 1.);
+  }
 
   hiopAlgFilterIPMNewton solver(&nlp);
   status = solver.run();
@@ -157,20 +180,24 @@ int main(int argc, char **argv)
   solver.getDualSolutions(zl, zu, lambdas);
 
   my_nlp->set_solution_primal(x);
-  my_nlp->set_solution_duals(zl, zu, lambdas);
+  if(!primal_restart) {
+    my_nlp->set_solution_duals(zl, zu, lambdas);
+  }
 
   //
   // set options for solver re-optimization
   //
   
-  //less agressive log-barrier parameter is always a safe bet
-  nlp.options->SetNumericValue("mu0", 1e-6);
+  //warm start: the primal-dual solution is only slightly pushed inside the bounds and the
+  //log-barrier parameter is restarted from its final value of the previous solve; without the
+  //duals, the primal solution is pushed inside the bounds as a cold starting point would be
+  nlp.options->SetStringValue("warm_start", "yes");
+  if(!primal_restart) {
+    nlp.options->SetNumericValue("mu0", solver.getBarrierParameter());
+  }
   nlp.options->SetNumericValue("tolerance", 1e-8);
 
   //nlp.options->SetIntegerValue("verbosity_level", 7);
-
-  //nlp.options->SetNumericValue("kappa1", 1e-15);
-  //nlp.options->SetNumericValue("kappa2", 1e-15);
   
   //solve
   status = solver.run();
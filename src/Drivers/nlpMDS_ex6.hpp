@@ -0,0 +1,170 @@
+#ifndef HIOP_EXAMPLE_EX6
+#define HIOP_EXAMPLE_EX6
+
+#include "hiopInterface.hpp"
+
+#ifdef HIOP_USE_MPI
+#include "mpi.h"
+#else
+#define MPI_COMM_WORLD 0
+#define MPI_COMM_SELF 0
+#define MPI_Comm int
+#endif
+
+#include <cassert>
+#include <cstdio>
+#include <cmath>
+
+/** Test problem for the second-order corrections (SOC) of the line search of the Filter IPM
+ * Newton of HiOp: 'k' uncoupled copies of the classical example of the Maratos effect
+ *
+ *  min   sum { 2(x_i^2+y_i^2-1) - x_i : i=1,...,k }
+ *  s.t.  x_i^2 + y_i^2 = 1, i=1,...,k
+ *
+ * started from points (cos t_i, sin t_i) on the unit circle, t_i in [0.1, 0.6), with the
+ * solution x_i=1, y_i=0 and optimal objective -k. The full Newton steps from points on the
+ * circle increase the infeasibility and are rejected by the filter, while the steps corrected
+ * with the second-order correction are accepted.
+ *
+ * All the variables are dense in the MDS formulation, ordered as [x_1,y_1,...,x_k,y_k].
+ */
+class Ex6 : public hiop::hiopInterfaceMDS
+{
+public:
+  Ex6(int k)
+    : k_(k)
+  {
+    if(k_<1) k_ = 1;
+  }
+  virtual ~Ex6()
+  {
+  }
+
+  bool get_prob_sizes(long long& n, long long& m)
+  {
+    n = 2*k_;
+    m = k_;
+    return true;
+  }
+
+  bool get_vars_info(const long long& n, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    assert(n==2*k_);
+    for(int i=0; i<n; i++) {
+      xlow[i] = -1e+20;
+      xupp[i] = 1e+20;
+      type[i] = hiopNonlinear;
+    }
+    return true;
+  }
+
+  bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type)
+  {
+    assert(m==k_);
+    for(int i=0; i<m; i++) {
+      clow[i] = cupp[i] = 0.;
+      type[i] = hiopNonlinear;
+    }
+    return true;
+  }
+
+  bool get_sparse_dense_blocks_info(int& nx_sparse, int& nx_dense,
+				    int& nnz_sparse_Jace, int& nnz_sparse_Jaci,
+				    int& nnz_sparse_Hess_Lagr_SS, int& nnz_sparse_Hess_Lagr_SD)
+  {
+    nx_sparse = 0;
+    nx_dense = 2*k_;
+    nnz_sparse_Jace = nnz_sparse_Jaci = 0;
+    nnz_sparse_Hess_Lagr_SS = nnz_sparse_Hess_Lagr_SD = 0;
+    return true;
+  }
+
+  bool eval_f(const long long& n, const double* x, bool new_x, double& obj_value)
+  {
+    obj_value = 0.;
+    for(int i=0; i<k_; i++) {
+      const double xi=x[2*i], yi=x[2*i+1];
+      obj_value += 2.*(xi*xi+yi*yi-1.) - xi;
+    }
+    return true;
+  }
+
+  bool eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf)
+  {
+    for(int i=0; i<k_; i++) {
+      gradf[2*i]   = 4.*x[2*i] - 1.;
+      gradf[2*i+1] = 4.*x[2*i+1];
+    }
+    return true;
+  }
+
+  bool eval_cons(const long long& n, const long long& m,
+		 const long long& num_cons, const long long* idx_cons,
+		 const double* x, bool new_x, double* cons)
+  {
+    for(int j=0; j<num_cons; j++) {
+      const int i = idx_cons[j];
+      assert(i>=0 && i<k_);
+      cons[j] = x[2*i]*x[2*i] + x[2*i+1]*x[2*i+1] - 1.;
+    }
+    return true;
+  }
+
+  bool eval_Jac_cons(const long long& n, const long long& m,
+		     const long long& num_cons, const long long* idx_cons,
+		     const double* x, bool new_x,
+		     const long long& nsparse, const long long& ndense,
+		     const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS,
+		     double** JacD)
+  {
+    assert(nsparse==0 && nnzJacS==0);
+    if(JacD!=NULL) {
+      for(int j=0; j<num_cons; j++) {
+	const int i = idx_cons[j];
+	for(int l=0; l<ndense; l++) JacD[j][l] = 0.;
+	JacD[j][2*i]   = 2.*x[2*i];
+	JacD[j][2*i+1] = 2.*x[2*i+1];
+      }
+    }
+    return true;
+  }
+
+  bool eval_Hess_Lagr(const long long& n, const long long& m,
+		      const double* x, bool new_x, const double& obj_factor,
+		      const double* lambda, bool new_lambda,
+		      const long long& nsparse, const long long& ndense,
+		      const int& nnzHSS, int* iHSS, int* jHSS, double* MHSS,
+		      double** HDD,
+		      int& nnzHSD, int* iHSD, int* jHSD, double* MHSD)
+  {
+    assert(nnzHSS==0 && nnzHSD==0);
+    if(HDD!=NULL) {
+      for(int i=0; i<ndense; i++)
+	for(int j=0; j<ndense; j++)
+	  HDD[i][j] = 0.;
+      //the Hessian of the Lagrangian obj_factor*f + lambda^T c is diagonal
+      for(int i=0; i<k_; i++) {
+	HDD[2*i][2*i] = HDD[2*i+1][2*i+1] = 4.*obj_factor + 2.*lambda[i];
+      }
+    }
+    return true;
+  }
+
+  bool get_starting_point(const long long& global_n, double* x0)
+  {
+    assert(global_n==2*k_);
+    for(int i=0; i<k_; i++) {
+      const double t = 0.1 + 0.5*i/k_;
+      x0[2*i]   = cos(t);
+      x0[2*i+1] = sin(t);
+    }
+    return true;
+  }
+
+  /** pass the COMM_SELF communicator since this example is only intended to run inside 1 MPI process */
+  virtual bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=MPI_COMM_SELF; return true;}
+protected:
+  int k_;
+};
+
+#endif
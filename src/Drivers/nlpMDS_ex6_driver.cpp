@@ -0,0 +1,139 @@
+#include "nlpMDS_ex6.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#include <cstdlib>
+#include <string>
+
+using namespace hiop;
+
+static bool parse_arguments(int argc, char **argv, bool& self_check, int& k)
+{
+  self_check = false;
+  k = 50;
+
+  switch(argc) {
+  case 1:
+    //no arguments
+    return true;
+    break;
+  case 3: // 2 arguments
+    {
+      if(std::string(argv[2]) == "-selfcheck")
+	self_check=true;
+      else
+	return false;
+    }
+  case 2: //1 argument
+    {
+      if(std::string(argv[1]) == "-selfcheck") {
+	if(argc!=2) return false;
+	self_check=true;
+      } else {
+	k = atoi(argv[1]);
+	if(k<=0) return false;
+      }
+    }
+    break;
+  default: 
+    return false; //3 or more arguments
+  }
+  return true;
+};
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that solves copies of the Maratos example (see nlpMDS_ex6.hpp) with and "
+	 "without the second-order corrections of the line search.\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s num_copies -selfcheck'\n", exeName);
+  printf("Arguments:\n");
+  printf("  'num_copies': # of copies of the problem [default 50, optional, positive integer].\n");
+  printf("  '-selfcheck': checks the optimal objectives, that second-order corrections are accepted, "
+	 "and that they reduce the number of iterations and of objective evaluations. [optional]\n");
+}
+
+struct RunInfo
+{
+  hiopSolveStatus status;
+  double obj_value;
+  int iters, evals_obj, soc_accepted;
+};
+
+static RunInfo solve(int k, int max_soc_iter)
+{
+  Ex6 nlp_interface(k);
+  hiopNlpMDS nlp(nlp_interface);
+
+  nlp.options->SetStringValue("dualsUpdateType", "linear");
+  nlp.options->SetStringValue("dualsInitialization", "zero");
+  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  nlp.options->SetIntegerValue("max_soc_iter", max_soc_iter);
+  nlp.options->SetIntegerValue("verbosity_level", 3);
+
+  hiopAlgFilterIPMNewton solver(&nlp);
+  RunInfo info;
+  info.status = solver.run();
+  info.obj_value = solver.getObjective();
+  info.iters = solver.getNumIterations();
+  info.evals_obj = nlp.runStats.nEvalObj;
+  info.soc_accepted = nlp.runStats.nSOCAccepted;
+  return info;
+}
+
+int main(int argc, char **argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+	   "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+  bool selfCheck;
+  int k;
+  if(!parse_arguments(argc, argv, selfCheck, k)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  RunInfo nosoc = solve(k, 0);
+  RunInfo soc = solve(k, 4);
+
+  printf("Without SOC: status %d obj %18.12e iterations %d obj. evals %d SOC accepted %d\n",
+	 nosoc.status, nosoc.obj_value, nosoc.iters, nosoc.evals_obj, nosoc.soc_accepted);
+  printf("With SOC:    status %d obj %18.12e iterations %d obj. evals %d SOC accepted %d\n",
+	 soc.status, soc.obj_value, soc.iters, soc.evals_obj, soc.soc_accepted);
+
+  int ret = 0;
+  if(nosoc.status<0 || soc.status<0) {
+    printf("solve trouble: returned %d (without SOC) and %d (with SOC)\n", nosoc.status, soc.status);
+    ret = -1;
+  } else if(selfCheck) {
+    if(fabs(nosoc.obj_value+k)>1e-6*k || fabs(soc.obj_value+k)>1e-6*k) {
+      printf("selfcheck: objective mismatch for Ex6 with %d copies: %18.12e and %18.12e were "
+	     "returned by HiOp while %d is the optimal objective\n", k, nosoc.obj_value, soc.obj_value, -k);
+      ret = -1;
+    }
+    if(nosoc.soc_accepted!=0 || soc.soc_accepted==0) {
+      printf("selfcheck: second-order corrections accepted: %d with max_soc_iter=0 and %d with "
+	     "max_soc_iter=4\n", nosoc.soc_accepted, soc.soc_accepted);
+      ret = -1;
+    }
+    if(soc.iters>=nosoc.iters || soc.evals_obj>=nosoc.evals_obj) {
+      printf("selfcheck: the second-order corrections did not reduce the number of iterations "
+	     "(%d vs %d without) and of objective evaluations (%d vs %d without)\n",
+	     soc.iters, nosoc.iters, soc.evals_obj, nosoc.evals_obj);
+      ret = -1;
+    }
+  }
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret;
+}
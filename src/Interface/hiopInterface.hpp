@@ -455,6 +455,34 @@ public:
 			      double** HDD,
 			      int& nnzHSD, int* iHSD, int* jHSD, double* MHSD) = 0;
 
+  /** Optional: evaluates in one call the gradient of the objective, the Jacobian of all the
+   * constraints and the Hessian of the Lagrangian at the same point 'x'.
+   *
+   * HiOp calls this method once at each accepted trial point, instead of calling 'eval_grad_f',
+   * 'eval_Jac_cons' and 'eval_Hess_Lagr' one after another. The objective and constraints
+   * have already been evaluated at 'x' during the line search, so the implementer can reuse
+   * subexpressions cached at that time and shared by the derivatives.
+   *
+   * Notes
+   * 1) An output is requested only when its pointers are non-null: 'gradf' for the gradient,
+   * 'MJacS'/'JacD' for the Jacobian and 'MHSS'/'HDD' for the Hessian.
+   * 2) The arguments of the Jacobian are as in the one-call 'eval_Jac_cons' above (constraints
+   * are not split in equalities and inequalities) and the arguments of the Hessian are as in
+   * 'eval_Hess_Lagr'.
+   *
+   * The default implementation returns false, case in which HiOp falls back (permanently)
+   * to the individual evaluation methods.
+   */
+  virtual bool eval_derivs(const long long& n, const long long& m,
+			   const double* x, bool new_x,
+			   const double& obj_factor, const double* lambda, bool new_lambda,
+			   const long long& nsparse, const long long& ndense,
+			   double* gradf,
+			   const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS,
+			   double** JacD,
+			   const int& nnzHSS, int* iHSS, int* jHSS, double* MHSS,
+			   double** HDD,
+			   int& nnzHSD, int* iHSD, int* jHSD, double* MHSD) { return false; }
 };
 } //end of namespace
 #endif
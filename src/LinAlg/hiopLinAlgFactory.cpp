@@ -49,9 +49,12 @@
 #include <hiopVectorPar.hpp>
 #include <hiopMatrixDenseRowMajor.hpp>
 #include <hiopMatrixSparseTriplet.hpp>
+#include <hiopMatrixSparseCSR.hpp>
 
 #include "hiopLinAlgFactory.hpp"
 
+#include <cassert>
+
 using namespace hiop;
 
 /**
@@ -85,10 +88,14 @@ hiopMatrixDense* LinearAlgebraFactory::createMatrixDense(
 }
 
 /**
- * @brief Creates an instance of a sparse matrix of the appropriate implementation
- * depending on the build.
+ * @brief Creates an instance of a sparse matrix of the implementation given by 'format'.
  */
-hiopMatrixSparse* LinearAlgebraFactory::createMatrixSparse(int rows, int cols, int nnz)
+hiopMatrixSparse* LinearAlgebraFactory::createMatrixSparse(int rows, int cols, int nnz, 
+							   const std::string& format)
 {
+  assert(format == "triplet" || format == "csr");
+  if(format == "csr") {
+    return new hiopMatrixSparseCSR(rows, cols, nnz);
+  }
   return new hiopMatrixSparseTriplet(rows, cols, nnz);
 }
@@ -52,6 +52,8 @@
 #include <hiopMatrixDense.hpp>
 #include <hiopMatrixSparse.hpp>
 
+#include <string>
+
 namespace hiop {
 
 /**
@@ -76,7 +78,12 @@ public:
     MPI_Comm comm = MPI_COMM_SELF,
     const long long& m_max_alloc = -1);
 
-  static hiopMatrixSparse* createMatrixSparse(int rows, int cols, int nnz);
+  /**
+   * @brief Creates a sparse matrix in the format 'format': "triplet" (default) for 
+   * hiopMatrixSparseTriplet or "csr" for hiopMatrixSparseCSR (see option 'sparse_format').
+   */
+  static hiopMatrixSparse* createMatrixSparse(int rows, int cols, int nnz, 
+					      const std::string& format="triplet");
 };
 
 } // namespace hiop
@@ -51,6 +51,9 @@
 #include "hiopMatrix.hpp"
 
 #include "hiopOptions.hpp"
+#include "hiopLinAlgFactory.hpp"
+
+#include <algorithm>
 
 namespace hiop {
   hiopLinSolver::hiopLinSolver()
@@ -63,13 +66,71 @@ namespace hiop {
 
   
   hiopLinSolverIndefDense::hiopLinSolverIndefDense(int n, hiopNlpFormulation* nlp)
-    : M(n,n)
+    : ws_(nlp->get_dense_linsolver_ws_pool().acquire(n)), M(*ws_->M)
   {
     nlp_ = nlp;
     perf_report_ = "on"==hiop::tolower(nlp->options->GetString("time_kkt"));
   }
   hiopLinSolverIndefDense::~hiopLinSolverIndefDense()
   { 
+    if(nlp_) {
+      nlp_->get_dense_linsolver_ws_pool().release(ws_);
+    }
+  }
+
+  hiopDenseLinSolverWorkspace::hiopDenseLinSolverWorkspace(int n_)
+    : n(n_), lwork_fact(-1), in_use(false)
+  {
+    M = new hiopMatrixDenseRowMajor(n, n);
+    ipiv = new int[n];
+    diag = new double[n];
+    dwork = LinearAlgebraFactory::createVector(0);
+  }
+  hiopDenseLinSolverWorkspace::~hiopDenseLinSolverWorkspace()
+  {
+    delete M;
+    delete [] ipiv;
+    delete [] diag;
+    delete dwork;
+  }
+
+  hiopDenseLinSolverWorkspacePool::~hiopDenseLinSolverWorkspacePool()
+  {
+    for(auto ws : ws_) {
+      assert(!ws->in_use && "linear solver outlived the NLP formulation");
+      delete ws;
+    }
+  }
+
+  hiopDenseLinSolverWorkspace* hiopDenseLinSolverWorkspacePool::acquire(int n)
+  {
+    for(auto ws : ws_) {
+      if(!ws->in_use && ws->n==n) {
+	ws->in_use = true;
+	return ws;
+      }
+    }
+    //no idle workspace of the requested size; drop the idle ones of other sizes
+    size_t i=0;
+    while(i<ws_.size()) {
+      if(!ws_[i]->in_use) {
+	delete ws_[i];
+	ws_.erase(ws_.begin()+i);
+      } else {
+	i++;
+      }
+    }
+    hiopDenseLinSolverWorkspace* ws = new hiopDenseLinSolverWorkspace(n);
+    ws->in_use = true;
+    ws_.push_back(ws);
+    return ws;
+  }
+
+  void hiopDenseLinSolverWorkspacePool::release(hiopDenseLinSolverWorkspace* ws)
+  {
+    assert(ws->in_use);
+    assert(std::find(ws_.begin(), ws_.end(), ws) != ws_.end());
+    ws->in_use = false;
   }
 
 }
@@ -52,6 +52,7 @@
 #include "hiopNlpFormulation.hpp"
 #include "hiopMatrix.hpp"
 #include "hiopVectorPar.hpp"
+#include "hiopLinSolverWorkspacePool.hpp"
 
 #include "hiop_blasdefs.hpp"
 
@@ -87,13 +88,23 @@ public:
    * exit is contains the solution(s).  
    */
   virtual bool solve ( hiopVector& x ) = 0;
+
+  /** Solves a linear system with multiple right-hand sides using the same factorization.
+   * param 'x' is on entry a dense matrix whose rows are the right-hand sides. On exit
+   * each row contains the corresponding solution.
+   */
   virtual bool solve ( hiopMatrix& x ) { assert(false && "not yet supported"); return true;}
 public: 
   hiopNlpFormulation* nlp_;
   bool perf_report_; 
 };
 
-/** Base class for Indefinite Dense Solvers */
+/** Base class for Indefinite Dense Solvers 
+ * 
+ * The system matrix and the factorization buffers are acquired from the NLP's pool of 
+ * workspaces (see hiopDenseLinSolverWorkspacePool) and are released back to the pool 
+ * on destruction.
+ */
 class hiopLinSolverIndefDense : public hiopLinSolver
 {
 public:
@@ -101,10 +112,17 @@ public:
   virtual ~hiopLinSolverIndefDense();
 
   inline hiopMatrixDenseRowMajor& sysMatrix() { return M; }
+
+  /** Informs the solver that the leading 'n11' x 'n11' block of the system matrix is expected 
+   * to be positive definite and the Schur complement of this block to be negative definite 
+   * (quasi-definite KKT matrix). Solvers can use this to select a cheaper factorization; by
+   * default the hint is ignored. */
+  virtual void set_quasidefinite_hint(int n11) {}
 protected:
-  hiopMatrixDenseRowMajor M;
+  hiopDenseLinSolverWorkspace* ws_;
+  hiopMatrixDenseRowMajor& M;
 protected:
-  hiopLinSolverIndefDense() : M(0,0) { assert(false); }
+  hiopLinSolverIndefDense() : ws_(new hiopDenseLinSolverWorkspace(0)), M(*ws_->M) { assert(false); }
 };
 
 } //end namespace
@@ -53,20 +53,36 @@
 
 namespace hiop {
 
-/** Wrapper for LAPACK's DSYTRF */
+/** Wrapper for LAPACK's DSYTRF 
+ *
+ * When the KKT system informs the solver that the matrix is expected to be quasi-definite
+ * (see 'set_quasidefinite_hint') and the option 'dense_fact_strategy' is 'auto', the solver 
+ * first attempts the block factorization
+ *   [ A  B^T ]   [ L  0 ] [ I  0 ] [ L^T  W^T ]
+ *   [ B  C   ] = [ W  I ] [ 0  S ] [  0    I  ],  A = L*L^T, W = B*L^{-T}, S = C - W*W^T,
+ * using Cholesky (DPOTRF) for A and for -S. The inertia is then given by Haynsworth's 
+ * formula, In(M) = In(A) + In(S), without inspecting any pivots. If the Cholesky of -S fails, 
+ * S is factorized with DSYTRF (inertia of S from its pivots); if the Cholesky of A fails, the
+ * whole matrix is factorized with DSYTRF.
+ */
 class hiopLinSolverIndefDenseLapack : public hiopLinSolverIndefDense
 {
 public:
   hiopLinSolverIndefDenseLapack(int n, hiopNlpFormulation* nlp)
-    : hiopLinSolverIndefDense(n, nlp)
+    : hiopLinSolverIndefDense(n, nlp), n11_(-1), fact_type_(factLDL)
   {
-    ipiv = new int[n];
-    dwork = LinearAlgebraFactory::createVector(0);
+    //pivots and work array are from the workspace of the pool, see hiopLinSolverIndefDense
+    assert(ws_->n == n);
+    use_chol_ = "auto"==nlp->options->GetString("dense_fact_strategy");
   }
   virtual ~hiopLinSolverIndefDenseLapack()
   {
-    delete [] ipiv;
-    delete dwork;
+  }
+
+  void set_quasidefinite_hint(int n11)
+  {
+    assert(n11<=M.n());
+    n11_ = n11;
   }
 
   /** Triggers a refactorization of the matrix, if necessary. 
@@ -74,75 +90,177 @@ public:
   int matrixChanged()
   {
     assert(M.n() == M.m());
-    int N=M.n(), lda = N, info;
+    int N=M.n();
     if(N==0) return 0;
 
+    //a factorization of the upper triangle is N^3/3 flops
+    hiopProfRegion prof_fact(nlp_->prof, "denseFactorization");
+    prof_fact.add_work(4.*N*(N+1.), N*(double)N*N/3.);
+
+    if(use_chol_ && n11_>=0) {
+      int negEigVal = factorizeQuasiDef();
+      if(negEigVal>=-1) {
+	return negEigVal;
+      }
+      //the (1,1) block is not positive definite; 'factorizeQuasiDef' restored the matrix from
+      //the backup of A, the only block it modified
+      nlp_->log->printf(hovScalars,
+			"hiopLinSolverIndefDenseLapack: (1,1) block not positive definite, "
+			"using Bunch-Kaufman\n");
+    }
+
+    fact_type_ = factLDL;
     nlp_->runStats.linsolv.tmFactTime.start();
+    bool fact_ok = factorizeLDL(0, N);
+    nlp_->runStats.linsolv.tmFactTime.stop();
+    if(!fact_ok) {
+      //matrix is singular
+      return -1;
+    }
+    
+    nlp_->runStats.linsolv.tmInertiaComp.start();
+    int negEigVal=0, nullEigVal=0;
+    inertiaFromPivots(0, N, negEigVal, nullEigVal);
+    nlp_->runStats.linsolv.tmInertiaComp.stop();
+    
+    if(nullEigVal>0) return -1;
+    return negEigVal;
+  }
+    
+  /** solves a linear system.
+   * param 'x' is on entry the right hand side(s) of the system to be solved. On
+   * exit is contains the solution(s).  */
+  bool solve ( hiopVector& x_ )
+  {
+    assert(M.n() == M.m());
+    assert(x_.get_size()==M.n());
     
-    double dwork_tmp;
+    hiopVectorPar* x = dynamic_cast<hiopVectorPar*>(&x_);
+    assert(x != NULL);
+    return solveRhsBlock(x->local_data(), 1);
+  }
+
+  /** solves a linear system with multiple right-hand sides, which are the rows of 'x_'.
+   * The triangular solves are done for all right-hand sides at once by a single DSYTRS. */
+  bool solve ( hiopMatrix& x_ )
+  {
+    hiopMatrixDense* x = dynamic_cast<hiopMatrixDense*>(&x_);
+    assert(x != NULL);
+    assert(x->n() == M.n());
+    if(x->m()==0) return true;
+    return solveRhsBlock(x->local_buffer(), x->m());
+  }
+
+protected:
+  /** Solves in place with the factors for the 'nrhs' right-hand sides stored contiguously 
+   * in 'rhs' (rows of a row-major matrix are the columns of the column-major LAPACK matrix) */
+  bool solveRhsBlock(double* rhs, int nrhs)
+  {
+    assert(M.n() == M.m());
+    int N=M.n(), LDA = N, info;
+    if(N==0) return true;
+
+    //the factors are read once for all the right-hand sides
+    hiopProfRegion prof_solve(nlp_->prof, "denseSolve");
+    prof_solve.add_work(4.*N*(N+1.) + 16.*N*nrhs, 2.*N*(double)N*nrhs);
+    nlp_->runStats.linsolv.tmTriuSolves.start();
+
     char uplo='L'; // M is upper in C++ so it's lower in fortran
+    int NRHS=nrhs, LDB=N;
+    if(fact_type_ == factLDL) {
+      DSYTRS(&uplo, &N, &NRHS, M.local_buffer(), &LDA, ws_->ipiv, rhs, &LDB, &info);
+    } else {
+      info = solveQuasiDef(rhs, nrhs);
+    }
+    if(info<0) {
+      nlp_->log->printf(hovError, "hiopLinSolverIndefDenseLapack: DSYTRS returned error %d\n", info);
+    } else if(info>0) {
+      nlp_->log->printf(hovError, "hiopLinSolverIndefDenseLapack: DSYTRS returned warning %d\n", info);
+    }
+    nlp_->runStats.linsolv.tmTriuSolves.stop();
+    return info==0;
+  }
+
+  /** DSYTRF of the diagonal block of size 'n' starting at (offset, offset); the pivots are
+   * stored in ipiv starting at 'offset'. Returns false if the factorization fails or the block
+   * is singular. */
+  bool factorizeLDL(int offset, int n)
+  {
+    int N=M.n(), lda=N, info;
+    char uplo='L'; // M is upper in C++ so it's lower in fortran
+    double* A = M.local_buffer() + offset + (size_t)offset*N;
+    int* ipiv = ws_->ipiv + offset;
 
     //
-    //query sizes
+    //query sizes; done only once per workspace since the optimal size depends only on N 
     //
-    int lwork=-1;
-    DSYTRF(&uplo, &N, M.local_buffer(), &lda, ipiv, &dwork_tmp, &lwork, &info );
-    assert(info==0);
-
-    lwork=(int)dwork_tmp;
-    if(lwork != dwork->get_size()) {
-      delete dwork;
-      dwork = NULL;
-      dwork = LinearAlgebraFactory::createVector(lwork);
+    if(ws_->lwork_fact<0) {
+      double dwork_tmp;
+      int lwork_query=-1;
+      DSYTRF(&uplo, &N, M.local_buffer(), &lda, ws_->ipiv, &dwork_tmp, &lwork_query, &info );
+      assert(info==0);
+      ws_->lwork_fact = (int)dwork_tmp;
     }
+    //the optimal size for N is also sufficient for the blocks of size n<N
+    int lwork = ws_->lwork_fact;
+    if(lwork != ws_->dwork->get_size()) {
+      delete ws_->dwork;
+      ws_->dwork = LinearAlgebraFactory::createVector(lwork);
+    }
+    hiopVector* dwork = ws_->dwork;
 
-    bool rank_deficient=false;
     //
     // factorization
     //
-    DSYTRF(&uplo, &N, M.local_buffer(), &lda, ipiv, dwork->local_data(), &lwork, &info );
+    DSYTRF(&uplo, &n, A, &lda, ipiv, dwork->local_data(), &lwork, &info );
     if(info<0) {
       nlp_->log->printf(hovError,
 		       "hiopLinSolverIndefDense error: %d argument to dsytrf has an illegal value.\n",
 		       -info);
-      return -1;
+      return false;
     } else {
       if(info>0) {
 	nlp_->log->printf(hovWarning,
 			 "hiopLinSolverIndefDense error: %d entry in the factorization's diagonal\n"
 			 "is exactly zero. Division by zero will occur if it a solve is attempted.\n",
 			 info);
-	//matrix is singular
-	return -1;
+	return false;
       }
     }
     assert(info==0);
-    nlp_->runStats.linsolv.tmFactTime.stop();
-    
-    nlp_->runStats.linsolv.tmInertiaComp.start();
+    return true;
+  }
+
+  /** Inertia of the diagonal block of size 'n' starting at (offset, offset) factorized by
+   * 'factorizeLDL'. Only negative and null eigenvalues are returned.
+   */
+  void inertiaFromPivots(int offset, int n, int& negEigVal, int& nullEigVal)
+  {
     //
     // Compute the inertia. Only negative eigenvalues are returned.
     // Code originally written by M. Schanenfor PIPS based on
     // LINPACK's dsidi Fortran routine (http://www.netlib.org/linpack/dsidi.f)
     // 04/08/2020 - petra: fixed the test for non-positive pivots (was only for negative pivots)
-    int negEigVal=0;
+    negEigVal=0;
+    nullEigVal=0;
     int posEigVal=0;
-    int nullEigVal=0;
     double t=0;
     double** MM = M.get_M();
-    for(int k=0; k<N; k++) {
+    const int* ipiv = ws_->ipiv + offset;
+    for(int k=0; k<n; k++) {
       //c       2 by 2 block
       //c       use det (d  s)  =  (d/t * c - t) * t  ,  t = dabs(s)
       //c               (s  c)
       //c       to avoid underflow/overflow troubles.
       //c       take two passes through scaling.  use  t  for flag.
-      double d = MM[k][k];
+      const int kk = offset+k;
+      double d = MM[kk][kk];
       if(ipiv[k] <= 0) {
 	if(t==0) {
-	  assert(k+1<N);
-	  if(k+1<N) {
-	    t=fabs(MM[k][k+1]);
-	    d=(d/t) * MM[k+1][k+1]-t;
+	  assert(k+1<n);
+	  if(k+1<n) {
+	    t=fabs(MM[kk][kk+1]);
+	    d=(d/t) * MM[kk+1][kk+1]-t;
 	  }
 	} else {
 	  d=t;
@@ -161,45 +279,156 @@ public:
       }
     }
     //printf("(pos,null,neg)=(%d,%d,%d)\n", posEigVal, nullEigVal, negEigVal);
-    nlp_->runStats.linsolv.tmInertiaComp.stop();
+  }
+
+  /** Backs up (if 'to_upper') the diagonal block of size 'n' starting at (offset, offset) 
+   * before an in-place Cholesky, or restores it from the backup. The strict (fortran) lower 
+   * triangle is copied into the unreferenced strict upper triangle and the diagonal into the 
+   * 'diag' buffer of the workspace. 
+   */
+  void mirrorDiagBlock(int offset, int n, bool to_upper)
+  {
+    double** MM = M.get_M();
+    double* diag = ws_->diag;
+    //fortran lower (i,j), i>j, is MM[j][i] in C++
+    for(int j=offset; j<offset+n; j++) {
+      if(to_upper) {
+	diag[j] = MM[j][j];
+      } else {
+	MM[j][j] = diag[j];
+      }
+      for(int i=j+1; i<offset+n; i++) {
+	if(to_upper) {
+	  MM[i][j] = MM[j][i];
+	} else {
+	  MM[j][i] = MM[i][j];
+	}
+      }
+    }
+  }
+
+  /** Cholesky of the diagonal block of size 'n' starting at (offset, offset), possibly 
+   * negated. Returns false if the block is not (numerically) definite, in which case the 
+   * block contains partial factors. */
+  bool factorizeChol(int offset, int n, bool negate)
+  {
+    int N=M.n(), lda=N, info;
+    char uplo='L';
+    double** MM = M.get_M();
+    if(negate) {
+      for(int j=offset; j<offset+n; j++) {
+	for(int i=j; i<offset+n; i++) {
+	  MM[j][i] = -MM[j][i];
+	}
+      }
+    }
+    DPOTRF(&uplo, &n, M.local_buffer() + offset + (size_t)offset*N, &lda, &info);
+    if(info!=0) return false;
+    //same threshold as for the pivots of the LDL^T: tiny pivots mean null eigenvalues
+    for(int k=offset; k<offset+n; k++) {
+      if(MM[k][k]*MM[k][k] < 1e-14) return false;
+    }
+    return true;
+  }
+
+  /** Attempts the block factorization described in the class description. Returns the number
+   * of negative eigenvalues, -1 if the matrix is singular, or -2 if A is not positive definite, 
+   * in which case the matrix is restored to its original content. */
+  int factorizeQuasiDef()
+  {
+    int N=M.n(), lda=N, n1=n11_, n2=N-n11_;
+    double* A = M.local_buffer();
     
+    nlp_->runStats.linsolv.tmFactTime.start();
+
+    //back up A since it is overwritten by DPOTRF even when DPOTRF fails
+    mirrorDiagBlock(0, n1, true);
+    if(!factorizeChol(0, n1, false)) {
+      mirrorDiagBlock(0, n1, false);
+      nlp_->runStats.linsolv.tmFactTime.stop();
+      return -2;
+    }
+
+    if(n2>0) {
+      //W = B*L^{-T}, with B the (fortran) block (n1:N, 0:n1), overwritten by W
+      char side='R', uplo='L', transA='T', diag='N';
+      double one=1., minusone=-1.;
+      DTRSM(&side, &uplo, &transA, &diag, &n2, &n1, &one, A, &lda, A+n1, &lda);
+      //S = C - W*W^T in the lower triangle of C
+      char trans='N';
+      DSYRK(&uplo, &trans, &n2, &n1, &minusone, A+n1, &lda, &one, A+n1+(size_t)n1*N, &lda);
+
+      //back up S, which is negated and overwritten by DPOTRF
+      mirrorDiagBlock(n1, n2, true);
+      if(factorizeChol(n1, n2, true)) {
+	fact_type_ = factCholChol;
+      } else {
+	nlp_->log->printf(hovScalars, 
+			  "hiopLinSolverIndefDenseLapack: Schur complement not negative definite, "
+			  "using Bunch-Kaufman for it\n");
+	mirrorDiagBlock(n1, n2, false);
+	fact_type_ = factCholLDL;
+	if(!factorizeLDL(n1, n2)) {
+	  nlp_->runStats.linsolv.tmFactTime.stop();
+	  return -1;
+	}
+      }
+    } else {
+      fact_type_ = factCholChol;
+    }
+    nlp_->runStats.linsolv.tmFactTime.stop();
+
+    //Haynsworth: In(M) = In(A) + In(S), with A positive definite
+    if(fact_type_ == factCholChol) {
+      return n2;
+    }
+    nlp_->runStats.linsolv.tmInertiaComp.start();
+    int negEigVal=0, nullEigVal=0;
+    inertiaFromPivots(n1, n2, negEigVal, nullEigVal);
+    nlp_->runStats.linsolv.tmInertiaComp.stop();
     if(nullEigVal>0) return -1;
     return negEigVal;
   }
-    
-  /** solves a linear system.
-   * param 'x' is on entry the right hand side(s) of the system to be solved. On
-   * exit is contains the solution(s).  */
-  bool solve ( hiopVector& x_ )
-  {
-    assert(M.n() == M.m());
-    assert(x_.get_size()==M.n());
-    int N=M.n(), LDA = N, info;
-    if(N==0) return true;
 
-    nlp_->runStats.linsolv.tmTriuSolves.start();
+  /** Solves with the block factors computed by 'factorizeQuasiDef': 
+   *   z1 = L^{-1} r1,  S x2 = r2 - W z1,  x1 = L^{-T} (z1 - W^T x2)
+   */
+  int solveQuasiDef(double* rhs, int nrhs)
+  {
+    int N=M.n(), lda=N, ldb=N, n1=n11_, n2=N-n11_, info=0;
+    double* A = M.local_buffer();
+    double one=1., minusone=-1.;
+    char side='L', uplo='L', transN='N', transT='T', diag='N';
     
-    hiopVectorPar* x = dynamic_cast<hiopVectorPar*>(&x_);
-    assert(x != NULL);
-
-    char uplo='L'; // M is upper in C++ so it's lower in fortran
-    int NRHS=1, LDB=N;
-    DSYTRS(&uplo, &N, &NRHS, M.local_buffer(), &LDA, ipiv, x->local_data(), &LDB, &info);
-    if(info<0) {
-      nlp_->log->printf(hovError, "hiopLinSolverIndefDenseLapack: DSYTRS returned error %d\n", info);
-    } else if(info>0) {
-      nlp_->log->printf(hovError, "hiopLinSolverIndefDenseLapack: DSYTRS returned warning %d\n", info);
+    DTRSM(&side, &uplo, &transN, &diag, &n1, &nrhs, &one, A, &lda, rhs, &ldb);
+    if(n2>0) {
+      DGEMM(&transN, &transN, &n2, &nrhs, &n1, &minusone, A+n1, &lda, rhs, &ldb, &one, rhs+n1, &ldb);
+      if(fact_type_ == factCholChol) {
+	//the factors are of -S
+	DPOTRS(&uplo, &n2, &nrhs, A+n1+(size_t)n1*N, &lda, rhs+n1, &ldb, &info);
+	for(int k=0; k<nrhs; k++) {
+	  double* x2 = rhs + n1 + (size_t)k*ldb;
+	  for(int i=0; i<n2; i++) x2[i] = -x2[i];
+	}
+      } else {
+	DSYTRS(&uplo, &n2, &nrhs, A+n1+(size_t)n1*N, &lda, ws_->ipiv+n1, rhs+n1, &ldb, &info);
+      }
+      DGEMM(&transT, &transN, &n1, &nrhs, &n2, &minusone, A+n1, &lda, rhs+n1, &ldb, &one, rhs, &ldb);
     }
-    nlp_->runStats.linsolv.tmTriuSolves.stop();
-    return info==0;
+    DTRSM(&side, &uplo, &transT, &diag, &n1, &nrhs, &one, A, &lda, rhs, &ldb);
+    return info;
   }
 
 protected:
-  int* ipiv;
-  hiopVector* dwork;
+  enum FactType {factLDL=0, factCholChol, factCholLDL};
+  //size of the (1,1) block expected to be positive definite; -1 when no hint was given
+  int n11_;
+  //whether Cholesky is attempted on quasi-definite matrices (option 'dense_fact_strategy')
+  bool use_chol_;
+  //factorization currently held in M
+  FactType fact_type_;
 private:
   hiopLinSolverIndefDenseLapack()
-    : ipiv(NULL), dwork(NULL)
   {
     assert(false);
   }
@@ -126,22 +126,35 @@ namespace hiop
 
   bool hiopLinSolverIndefDenseMagmaBuKa::solve(hiopVector& x_)
   {
-    assert(M.n() == M.m());
     assert(x_.get_size() == M.n());
+    hiopVectorPar* x = dynamic_cast<hiopVectorPar*>(&x_);
+    assert(x != NULL);
+    return solveRhsBlock(x->local_data(), 1);
+  }
+
+  bool hiopLinSolverIndefDenseMagmaBuKa::solve(hiopMatrix& x_)
+  {
+    hiopMatrixDense* x = dynamic_cast<hiopMatrixDense*>(&x_);
+    assert(x != NULL);
+    assert(x->n() == M.n());
+    if(x->m() == 0) return true;
+    return solveRhsBlock(x->local_buffer(), x->m());
+  }
+
+  bool hiopLinSolverIndefDenseMagmaBuKa::solveRhsBlock(double* rhs, int nrhs)
+  {
+    assert(M.n() == M.m());
     int N = M.n();
     int LDA = N;
     int LDB = N;
-    int NRHS = 1;
+    int NRHS = nrhs;
     if(N == 0) return true;
 
     nlp_->runStats.linsolv.tmTriuSolves.start();
-    
-    hiopVectorPar* x = dynamic_cast<hiopVectorPar*>(&x_);
-    assert(x != NULL);
 
     char uplo='L'; // M is upper in C++ so it's lower in fortran
     int info;
-    DSYTRS(&uplo, &N, &NRHS, M.local_buffer(), &LDA, ipiv, x->local_data(), &LDB, &info);
+    DSYTRS(&uplo, &N, &NRHS, M.local_buffer(), &LDA, ipiv, rhs, &LDB, &info);
     if(info<0) {
       nlp_->log->printf(hovError, "hiopLinSolverMagmaBuKa: (LAPACK) DSYTRS returned error %d\n", info);
       assert(false);
@@ -228,6 +241,7 @@ namespace hiop
     assert(MAGMA_SUCCESS == magmaRet);
     magmaRet = magma_dmalloc(&device_rhs_, nrhs*lddb_ );
     assert(MAGMA_SUCCESS == magmaRet);
+    nrhs_alloc_ = nrhs;
 
     nFakeNegEigs_ = 0;
   }
@@ -252,25 +266,45 @@ namespace hiop
 
   bool hiopLinSolverIndefDenseMagmaNopiv::solve( hiopVector& x_ )
   {
-    assert(M.n() == M.m());
     assert(x_.get_size()==M.n());
+    hiopVectorPar* x = dynamic_cast<hiopVectorPar*>(&x_);
+    assert(x != NULL);
+    return solveRhsBlock(x->local_data(), 1);
+  }
+
+  bool hiopLinSolverIndefDenseMagmaNopiv::solve( hiopMatrix& x_ )
+  {
+    hiopMatrixDense* x = dynamic_cast<hiopMatrixDense*>(&x_);
+    assert(x != NULL);
+    assert(x->n() == M.n());
+    if(x->m() == 0) return true;
+    return solveRhsBlock(x->local_buffer(), x->m());
+  }
+
+  bool hiopLinSolverIndefDenseMagmaNopiv::solveRhsBlock(double* rhs, int nrhs)
+  {
+    assert(M.n() == M.m());
     int N=M.n(), LDA = N, LDB=N;
     if(N==0) return true;
 
     magma_int_t info; 
 
-    hiopVectorPar* x = dynamic_cast<hiopVectorPar*>(&x_);
-    assert(x != NULL);
-    
     magma_uplo_t uplo=MagmaLower; // M is upper in C++ so it's lower in fortran
-    magma_int_t NRHS=1;
+    magma_int_t NRHS=nrhs;
+
+    if(nrhs > nrhs_alloc_) {
+      magma_free(device_rhs_);
+      int magmaRet = magma_dmalloc(&device_rhs_, nrhs*lddb_);
+      assert(MAGMA_SUCCESS == magmaRet);
+      nrhs_alloc_ = nrhs;
+    }
 
 
     double gflops = ( FLOPS_DPOTRF( N ) + FLOPS_DPOTRS( N, NRHS ) ) / 1e9;
 
     nlp_->runStats.linsolv.tmDeviceTransfer.start();
     magma_dsetmatrix(N, N,    M.local_buffer(), LDA, device_M_,   ldda_, magma_device_queue_);
-    magma_dsetmatrix(N, NRHS, x->local_data(),  LDB, device_rhs_, lddb_, magma_device_queue_);
+    magma_dsetmatrix(N, NRHS, rhs,  LDB, device_rhs_, lddb_, magma_device_queue_);
     nlp_->runStats.linsolv.tmDeviceTransfer.stop();
     
     nlp_->runStats.linsolv.tmTriuSolves.start();
@@ -300,7 +334,7 @@ namespace hiop
     }
 
     nlp_->runStats.linsolv.tmDeviceTransfer.start();
-    magma_dgetmatrix(N, NRHS, device_rhs_, lddb_, x->local_data(), LDB, magma_device_queue_);
+    magma_dgetmatrix(N, NRHS, device_rhs_, lddb_, rhs, LDB, magma_device_queue_);
     nlp_->runStats.linsolv.tmDeviceTransfer.stop();
     return true;
   }
@@ -47,10 +47,16 @@ public:
    */
   bool solve(hiopVector& x_in);
 
+  /** Solves with multiple right-hand sides, which are the rows of 'x_in' */
+  bool solve(hiopMatrix& x_in);
+
   inline hiopMatrixDense& sysMatrix() 
   { 
     return M; 
   }
+protected:
+  /** Solves in place for the 'nrhs' right-hand sides stored contiguously in 'rhs' */
+  bool solveRhsBlock(double* rhs, int nrhs);
 protected:
   int* ipiv;
 
@@ -83,6 +89,9 @@ public:
    */
   bool solve(hiopVector& x_in);
 
+  /** Solves with multiple right-hand sides, which are the rows of 'x_in' */
+  bool solve(hiopMatrix& x_in);
+
   inline hiopMatrixDense& sysMatrix() 
   { 
     return M; 
@@ -93,10 +102,15 @@ public:
     nFakeNegEigs_ = nNegEigs;
   }
 
+protected:
+  /** Factorizes and solves in place for the 'nrhs' right-hand sides stored contiguously in 'rhs' */
+  bool solveRhsBlock(double* rhs, int nrhs);
 protected:
   magma_queue_t magma_device_queue_;
   magmaDouble_ptr device_M_, device_rhs_;
   magma_int_t ldda_, lddb_;
+  //number of right-hand sides 'device_rhs_' is allocated for
+  int nrhs_alloc_;
   int nFakeNegEigs_;
 private:
   hiopLinSolverIndefDenseMagmaNopiv() 
@@ -1,10 +1,21 @@
 #include "hiopLinSolverUMFPACKZ.hpp"
 
+#include <algorithm>
+
+#ifdef HIOP_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace hiop
 {
+  //number of columns of the right-hand side solved by a thread before writing them into X
+  static const int umfpackz_rhs_block_size = 32;
+
   hiopLinSolverUMFPACKZ::hiopLinSolverUMFPACKZ(hiopMatrixComplexSparseTriplet& sysmat,
 					       hiopNlpFormulation* nlp_/*=NULL*/)
-    : m_symbolic(NULL), m_numeric(NULL), m_null(NULL), sys_mat(sysmat), nlp(nlp_)
+    : m_symbolic(NULL), m_numeric(NULL), m_null(NULL), sys_mat(sysmat), nlp(nlp_),
+      m_ws_nthreads(0), m_ws_blocksize(umfpackz_rhs_block_size),
+      m_ws_rhs(NULL), m_ws_sol(NULL), m_ws_wi(NULL), m_ws_w(NULL)
   {
     n = sys_mat.n();
     nnz = sys_mat.numberOfNonzeros();
@@ -34,12 +45,12 @@ namespace hiop
   hiopLinSolverUMFPACKZ::~hiopLinSolverUMFPACKZ()
   {
     if(m_symbolic) {
-      umfpack_di_free_symbolic(&m_symbolic);
+      umfpack_zi_free_symbolic(&m_symbolic);
       m_symbolic = NULL;
     }
 
     if(m_numeric) {
-      umfpack_di_free_numeric(&m_numeric) ;
+      umfpack_zi_free_numeric(&m_numeric) ;
       m_numeric = NULL;
     }
     
@@ -47,6 +58,30 @@ namespace hiop
     delete[] m_rowidx;
     delete[] m_vals;
     //delete[] m_valsim;
+
+    delete[] m_ws_rhs;
+    delete[] m_ws_sol;
+    delete[] m_ws_wi;
+    delete[] m_ws_w;
+  }
+
+  void hiopLinSolverUMFPACKZ::alloc_solve_workspace(int nthreads)
+  {
+    if(nthreads <= m_ws_nthreads) return;
+
+    delete[] m_ws_rhs;
+    delete[] m_ws_sol;
+    delete[] m_ws_wi;
+    delete[] m_ws_w;
+
+    m_ws_nthreads = nthreads;
+    m_ws_rhs = new double[2*(size_t)n*nthreads];
+    m_ws_sol = new double[2*(size_t)n*m_ws_blocksize*nthreads];
+    m_ws_wi  = new int[(size_t)n*nthreads];
+    m_ws_w   = new double[10*(size_t)n*nthreads];
+
+    //the rhs is kept zero between solves; only the nonzeros of each column are scattered
+    for(size_t i=0; i<2*(size_t)n*nthreads; i++) m_ws_rhs[i] = 0.;
   }
   
   int hiopLinSolverUMFPACKZ::matrixChanged()
@@ -101,18 +136,24 @@ namespace hiop
       //umfpack_zi_report_matrix (n, n, m_colptr, m_rowidx, m_vals, (double*) NULL, 1, m_control) ;
     }
     
-    status = umfpack_zi_symbolic(n, n, m_colptr, m_rowidx, m_vals, (double*) NULL,
-				 &m_symbolic, m_control, m_info);
-    if(status<0) {
-      //printf("[start]report info on symbolic factorization\n");
-      umfpack_zi_report_info (m_control, m_info);
-      //printf("[done ]report info on symbolic factorization\n");
-      
-      umfpack_zi_report_status (m_control, status);
-      printf("UMFPACK: error in the symbolic factorization: status=%d\n", status);
-      return -1;
+    //the symbolic analysis depends only on the sparsity pattern, which does not change
+    if(NULL == m_symbolic) {
+      status = umfpack_zi_symbolic(n, n, m_colptr, m_rowidx, m_vals, (double*) NULL,
+				   &m_symbolic, m_control, m_info);
+      if(status<0) {
+	//printf("[start]report info on symbolic factorization\n");
+	umfpack_zi_report_info (m_control, m_info);
+	//printf("[done ]report info on symbolic factorization\n");
+	
+	umfpack_zi_report_status (m_control, status);
+	printf("UMFPACK: error in the symbolic factorization: status=%d\n", status);
+	m_symbolic = NULL;
+	return -1;
+      }
+      //umfpack_zi_report_symbolic (m_symbolic, m_control) ;
     }
-    //umfpack_zi_report_symbolic (m_symbolic, m_control) ;
+
+    release_numeric();
 
     status = umfpack_zi_numeric(m_colptr, m_rowidx, m_vals, (double*) NULL,
 				m_symbolic, &m_numeric, m_control, m_info);
@@ -131,8 +172,17 @@ namespace hiop
     return 0;
   }
 
+  void hiopLinSolverUMFPACKZ::release_numeric()
+  {
+    if(m_numeric) {
+      umfpack_zi_free_numeric(&m_numeric);
+      m_numeric = NULL;
+    }
+  }
+
   bool hiopLinSolverUMFPACKZ::solve(const std::complex<double>* rhs_in, std::complex<double>* x)
   {
+    assert(m_numeric && "matrixChanged was not called or the numeric factorization was released");
     const double* rhs = reinterpret_cast<const double*>(rhs_in);
     double* sol = reinterpret_cast<double*>(x);
     int status = umfpack_zi_solve(UMFPACK_A, m_colptr, m_rowidx, m_vals, (double*) NULL,
@@ -171,86 +221,122 @@ namespace hiop
     assert(n==X.m()); 
     
     if(n==0) return true;
+    assert(m_numeric && "matrixChanged was not called or the numeric factorization was released");
 
-    int nrhs = X.n();
+    const int nrhs = X.n();
     if(0==nrhs) return true;
 
-    const int* B_irow = B.storage()->i_row();
-    const int* B_jcol = B.storage()->j_col();
-    const auto*B_M    = B.storage()->M();
     const int B_nnz = B.numberOfNonzeros();
     std::complex<double>** X_M = X.get_M();
 
-    double rhs[2*n];
-    double sol[2*n];
-    
-    // Columns of B need to be copied into the rhs array.
-    // B is triplet format, ordered after rows then after cols.
-    // To avoid scanning B for each rhs / column of B, we keep indexes (array
-    // of size n) of each of (i, col) of the last seen column 'col' in B_irow and B_jcol
-    
-    int idxsB_col[n];
-    idxsB_col[0]=0;
-    
-    int status;
-    for(int col_current=0; col_current<nrhs; col_current++) {
-      //update idxB_col
-      for(int row=0; row<n; row++) {
-	
-	if(row!=0) idxsB_col[row] = idxsB_col[row-1];
-      
-	assert(idxsB_col[row]<=B_nnz);
-	//skip all elems in previous rows
-	while(idxsB_col[row]<B_nnz &&
-	      B_irow[idxsB_col[row]]<row) {
-	  idxsB_col[row]++;
+    //
+    // convert B to column form once, so that the columns of B are scattered directly into 
+    // the rhs; the conversion also takes care of the (row, col) ordering of B's triplets
+    //
+    int* B_colptr = new int[nrhs+1];
+    int* B_rowidx = new int[B_nnz];
+    double* B_vals = new double[2*B_nnz]; //packed complex
+    int status = umfpack_zi_triplet_to_col(n, nrhs, B_nnz,
+					   B.storage()->i_row(), B.storage()->j_col(),
+					   reinterpret_cast<const double*>(B.storage()->M()), (double*) NULL,
+					   B_colptr, B_rowidx, B_vals, (double*) NULL, (int*) NULL);
+    if(status<0) {
+      umfpack_zi_report_status(m_control, status);
+      printf("umfpack_zi_triplet_to_col failed for the right-hand sides\n");
+      delete[] B_colptr;
+      delete[] B_rowidx;
+      delete[] B_vals;
+      return false;
+    }
+
+    const int nblocks = (nrhs + m_ws_blocksize - 1) / m_ws_blocksize;
+#ifdef HIOP_USE_OPENMP
+    const int nthreads = std::max(1, std::min(omp_get_max_threads(), nblocks));
+#else
+    const int nthreads = 1;
+#endif
+    alloc_solve_workspace(nthreads);
+
+    int fail_status = 0, fail_col = -1;
+
+    // UMFPACK's solve only reads the numeric factorization and the control parameters; each
+    // thread uses its own slice of the workspace and its own info array
+#ifdef HIOP_USE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+#endif
+    for(int blk=0; blk<nblocks; blk++) {
+#ifdef HIOP_USE_OPENMP
+      const int t = omp_get_thread_num();
+#else
+      const int t = 0;
+#endif
+      int failed;
+#ifdef HIOP_USE_OPENMP
+#pragma omp atomic read
+#endif
+      failed = fail_status;
+      if(failed) continue;
+
+      double* rhs = m_ws_rhs + 2*(size_t)n*t;
+      double* sol_blk = m_ws_sol + 2*(size_t)n*m_ws_blocksize*t;
+      int* Wi = m_ws_wi + (size_t)n*t;
+      double* W = m_ws_w + 10*(size_t)n*t;
+      double info[UMFPACK_INFO];
+
+      const int col_beg = blk*m_ws_blocksize;
+      const int ncols = std::min(m_ws_blocksize, nrhs-col_beg);
+
+      for(int j=0; j<ncols; j++) {
+	const int col = col_beg+j;
+	//scatter column 'col' of B into the (zero) rhs
+	for(int p=B_colptr[col]; p<B_colptr[col+1]; p++) {
+	  rhs[2*B_rowidx[p]]   = B_vals[2*p];
+	  rhs[2*B_rowidx[p]+1] = B_vals[2*p+1];
 	}
-	//skip elems in current row till 'col_current' is found or an higher column
-	//is found, which means elem at (row,col_current) is 0.0 
-	while(idxsB_col[row]<B_nnz &&
-	      B_irow[idxsB_col[row]]==row &&
-	      B_jcol[idxsB_col[row]]<col_current) {
-	  idxsB_col[row]++;
+	//solve for rhs. NULL pointers mean we work with packed complex arrays (re and imag
+	//are interleaved contiguously)
+	int st = umfpack_zi_wsolve(UMFPACK_A, m_colptr, m_rowidx, m_vals, (double*) NULL,
+				   sol_blk+2*(size_t)n*j, (double*) NULL,
+				   rhs, (double*) NULL,
+				   m_numeric, m_control, info, Wi, W);
+	//reset the rhs 
+	for(int p=B_colptr[col]; p<B_colptr[col+1]; p++) {
+	  rhs[2*B_rowidx[p]] = rhs[2*B_rowidx[p]+1] = 0.;
 	}
-	assert(idxsB_col[row]<=B_nnz);
-
-	if(idxsB_col[row]<B_nnz &&
-	   B_irow[idxsB_col[row]]==row &&
-	   B_jcol[idxsB_col[row]]==col_current) {
-	  rhs[2*row]   = B_M[idxsB_col[row]].real();
-	  rhs[2*row+1] = B_M[idxsB_col[row]].imag();
-	} else {
-	  rhs[2*row] = rhs[2*row+1] = 0.;
+	if(st<0) {
+#ifdef HIOP_USE_OPENMP
+#pragma omp critical(umfpackz_solve_fail)
+#endif
+	  {
+	    if(0==fail_status) {
+	      fail_status = st;
+	      fail_col = col;
+	    }
+	  }
+	  break;
 	}
       }
 
-      //solve for rhs. NULL pointers mean we work with packed complex arrays (re and imag
-      //are interleaved contiguously)
-      status = umfpack_zi_solve(UMFPACK_A, m_colptr, m_rowidx, m_vals, (double*) NULL,
-				sol, (double*) NULL,
-				rhs, (double*) NULL,
-				m_numeric, m_control, m_info);
-      if(status<0) {
-	umfpack_zi_report_info(m_control, m_info);
-	umfpack_zi_report_status(m_control, status);
-	printf("eumfpack_zi_solve failed for rhs=%d", col_current);
-	return false;
-      }
-
-      //norm of residual
-      //double resnrm = resid_abs_norm(n, m_colptr, m_rowidx, m_vals, sol, rhs);
-      //printf("solve %d -> abs resid abs nrm: %g\n", col_current, resnrm);
-      
-      //copy to X 
+      //copy the block of solutions to X, row by row
       for(int row=0; row<n; row++) {
-	X_M[row][col_current] = std::complex<double>(sol[2*row], sol[2*row+1]);
+	std::complex<double>* X_row = X_M[row] + col_beg;
+	for(int j=0; j<ncols; j++) {
+	  const double* sol = sol_blk + 2*(size_t)n*j;
+	  X_row[j] = std::complex<double>(sol[2*row], sol[2*row+1]);
+	}
       }
-    }  //end of for loop over columns
+    } //end of for loop over blocks of columns
+
+    delete[] B_colptr;
+    delete[] B_rowidx;
+    delete[] B_vals;
+
+    if(fail_status<0) {
+      umfpack_zi_report_status(m_control, fail_status);
+      printf("umfpack_zi_solve failed for rhs=%d\n", fail_col);
+      return false;
+    }
     return true;
-    //   printf ("\nx (solution of Ax=b): ") ;
-    //   (void) umfpack_zi_report_vector (n, x, xz, Control) ;
-    //   rnorm = resid (FALSE, Ap, Ai, Ax, Az) ;
-    //   printf ("maxnorm of residual: %g\n\n", rnorm) ;
   }
 
   double hiopLinSolverUMFPACKZ::resid_abs_norm(int n, int* Ap, int* Ai, double* Ax/*packed*/,
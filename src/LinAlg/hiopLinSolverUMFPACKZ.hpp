@@ -65,14 +65,25 @@ namespace hiop
     virtual ~hiopLinSolverUMFPACKZ();
     
     /** Triggers a refactorization of the matrix, if necessary. 
-     * Returns -1 if trouble in factorization is encountered. */
+     * Returns -1 if trouble in factorization is encountered. 
+     *
+     * The sparsity pattern of the system matrix is assumed fixed for the lifetime of the 
+     * solver: the symbolic analysis is done on the first call and reused afterwards, only
+     * the numeric factorization is redone when the values change. */
     virtual int matrixChanged();
+
+    /** Frees the numeric factorization (the symbolic analysis is kept). The next call to 
+     * 'matrixChanged' recomputes it. */
+    void release_numeric();
     
     /** solves a linear system.
      * param 'x' is on entry the right hand side(s) of the system to be solved. On
      * exit is contains the solution(s).  */
     virtual bool solve(hiopVector& x);
     virtual bool solve(hiopMatrix& X);
+    /** Solves for multiple right-hand sides given by the columns of the sparse B. The columns 
+     * are solved in blocks, concurrently when HiOp is built with HIOP_USE_OPENMP; the threads
+     * share the numeric factorization. */
     virtual bool solve(const hiopMatrixComplexSparseTriplet& B, hiopMatrixComplexDense& X);
 
     /** same as above but right-side and solution are separated */
@@ -91,7 +102,18 @@ namespace hiop
 
     double m_control [UMFPACK_CONTROL], m_info [UMFPACK_INFO];
 
+    /* Heap workspace of the multiple right-hand sides solve, one slice per thread, reused
+     * across calls and grown when needed. Each slice holds a dense rhs (2*n), the solutions
+     * of a block of columns (2*n*m_ws_blocksize), and UMFPACK's solve workspace Wi (n) and
+     * W (10*n) */
+    int m_ws_nthreads, m_ws_blocksize;
+    double* m_ws_rhs;
+    double* m_ws_sol;
+    int* m_ws_wi;
+    double* m_ws_w;
   private:
+    void alloc_solve_workspace(int nthreads);
+
     //returns the "abs" norm of the residual A*x-b
     double resid_abs_norm(int n, int* Ap, int* Ai, double* Ax/*packed*/,
 			  double* x/*packed*/,
@@ -0,0 +1,113 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#ifndef HIOP_LINSOLVER_WORKSPACE_POOL
+#define HIOP_LINSOLVER_WORKSPACE_POOL
+
+#include "hiopMatrixDenseRowMajor.hpp"
+#include "hiopVector.hpp"
+
+#include <vector>
+
+namespace hiop
+{
+
+/** 
+ * Storage used by the dense (indefinite) linear solvers: the system matrix, which is 
+ * factorized in place, the pivots, a backup of the diagonal of the matrix, and the LAPACK 
+ * work array together with the optimal size of the work array as returned by LAPACK's 
+ * workspace query.
+ */
+struct hiopDenseLinSolverWorkspace
+{
+  hiopDenseLinSolverWorkspace(int n);
+  ~hiopDenseLinSolverWorkspace();
+
+  int n;
+  hiopMatrixDenseRowMajor* M;
+  int* ipiv;
+  //backup of the diagonal of M while an in-place Cholesky is attempted
+  double* diag;
+  hiopVector* dwork;
+  //optimal length of the work array for the factorization; -1 when not queried yet
+  int lwork_fact;
+  bool in_use;
+};
+
+/**
+ * Pool of workspaces of the dense linear solvers. The linear solvers acquire the workspace 
+ * when they are created and release it back to the pool when they are destroyed, so that 
+ * switching between linear solvers (e.g., between the quick and stable modes) and repeated 
+ * solves (e.g., 'run' called multiple times) do not reallocate the large buffers and do not 
+ * repeat the workspace queries. 
+ *
+ * The pool is owned by the NLP formulation (see hiopNlpFormulation::get_dense_linsolver_ws_pool).
+ * Free workspaces of sizes different from the size requested are deallocated when a new 
+ * workspace needs to be created; hence, the pool holds at most one idle workspace per size
+ * in use.
+ */
+class hiopDenseLinSolverWorkspacePool
+{
+public:
+  hiopDenseLinSolverWorkspacePool() {};
+  ~hiopDenseLinSolverWorkspacePool();
+
+  /* returns a workspace of size 'n' that is not in use by other linear solver */
+  hiopDenseLinSolverWorkspace* acquire(int n);
+  /* marks the workspace as not in use; its storage is kept for subsequent 'acquire' calls */
+  void release(hiopDenseLinSolverWorkspace* ws);
+private:
+  std::vector<hiopDenseLinSolverWorkspace*> ws_;
+private:
+  hiopDenseLinSolverWorkspacePool(const hiopDenseLinSolverWorkspacePool&) {};
+  hiopDenseLinSolverWorkspacePool& operator=(const hiopDenseLinSolverWorkspacePool&) {return *this;};
+};
+
+} //end namespace
+
+#endif
@@ -58,6 +58,7 @@ namespace hiop
 class hiopVector;
 class hiopVectorPar;
 class hiopMatrixDense;
+class hiopOmpParams;
 
 /* See readme.md for some conventions on matrices */ 
 class hiopMatrix
@@ -69,6 +70,9 @@ public:
   virtual hiopMatrix* alloc_clone() const=0;
   virtual hiopMatrix* new_copy() const=0;
 
+  /// @brief sets the threading parameters of the kernels; ignored by the non-threaded matrices
+  virtual void set_omp_params(const hiopOmpParams* params) {}
+
   virtual void setToZero()=0;
   virtual void setToConstant(double c)=0;
 
@@ -178,6 +182,21 @@ public:
  
   virtual double max_abs_value() = 0;
 
+  /**
+   * @brief Returns in 'ret' the maximum absolute value of each row of 'this'
+   *
+   * @pre 'ret' is a local/non-distributed vector of size this->m()
+   */
+  virtual void row_max_abs_value(hiopVector& ret) = 0;
+
+  /**
+   * @brief Scales the i-th row of 'this' by the i-th entry of 'vec_scal' or, when 'inv_scale' 
+   * is true, by its reciprocal
+   *
+   * @pre 'vec_scal' is a local/non-distributed vector of size this->m()
+   */
+  virtual void scale_row(hiopVector& vec_scal, const bool inv_scale) = 0;
+
   /** @brief return false is any of the entry is a nan, inf, or denormalized */
   virtual bool isfinite() const = 0;
   
@@ -177,6 +177,16 @@ namespace hiop
     
     virtual double max_abs_value();
 
+    virtual void row_max_abs_value(hiopVector& ret)
+    {
+      assert(false && "not yet implemented");
+    }
+
+    virtual void scale_row(hiopVector& vec_scal, const bool inv_scale)
+    {
+      assert(false && "not yet implemented");
+    }
+
     virtual bool isfinite() const;
     
     //virtual void print(int maxRows=-1, int maxCols=-1, int rank=-1) const;
@@ -150,6 +150,16 @@ namespace hiop
     }
     
     virtual double max_abs_value();
+
+    virtual void row_max_abs_value(hiopVector& ret)
+    {
+      assert(false && "not yet implemented");
+    }
+
+    virtual void scale_row(hiopVector& vec_scal, const bool inv_scale)
+    {
+      assert(false && "not yet implemented");
+    }
     
     /* return false is any of the entry is a nan, inf, or denormalized */
     virtual bool isfinite() const
@@ -120,6 +120,25 @@ public:
   /* Contains dgemm wrapper needed by the above */
   virtual void timesMatTrans_local(double beta, hiopMatrix& W, double alpha, const hiopMatrix& X) const{assert(false && "not implemented in base class");}
 
+  /** 
+   * @brief W = beta*W + alpha*this*this^T; only the upper triangle of W is updated
+   * @pre 'W' need to be local/non-distributed and square with this->m() rows.
+   *
+   * 'this' can be distributed, in which case only the packed upper triangle of W is reduced.
+   */
+  virtual void symTimesMatTrans(double beta, hiopMatrix& W, double alpha) const{assert(false && "not implemented in base class");}
+  /* Contains dsyrk wrapper needed by the above */
+  virtual void symTimesMatTrans_local(double beta, hiopMatrix& W, double alpha) const{assert(false && "not implemented in base class");}
+
+  /**
+   * @brief copies the upper triangle of 'this' row by row in 'buffer', which should have m*(m+1)/2 
+   * elements; used to communicate only the upper triangle of symmetric matrices
+   * @pre 'this' is local/non-distributed and square
+   */
+  virtual void packUpperTriangle(double* buffer) const{assert(false && "not implemented in base class");}
+  /// @brief the inverse of the above; the lower triangle of 'this' is not touched
+  virtual void unpackUpperTriangle(const double* buffer){assert(false && "not implemented in base class");}
+
   virtual void addDiagonal(const double& alpha, const hiopVector& d_){assert(false && "not implemented in base class");}
   virtual void addDiagonal(const double& value){assert(false && "not implemented in base class");}
   virtual void addSubDiagonal(const double& alpha, long long start_on_dest_diag, const hiopVector& d_){assert(false && "not implemented in base class");}
@@ -172,6 +191,13 @@ public:
 
   virtual double max_abs_value(){assert(false && "not implemented in base class"); return 0;}
 
+  virtual void row_max_abs_value(hiopVector& ret){assert(false && "not implemented in base class");}
+
+  virtual void scale_row(hiopVector& vec_scal, const bool inv_scale)
+  {
+    assert(false && "not implemented in base class");
+  }
+
   virtual bool isfinite() const {assert(false && "not implemented in base class"); return false;}
   
   virtual void print(FILE* f=NULL, const char* msg=NULL, int maxRows=-1, int maxCols=-1, int rank=-1) const
@@ -198,6 +224,13 @@ public:
    */
   virtual void copyRowsFrom(const hiopMatrix& src_gen, const long long* rows_idxs, long long n_rows){assert(false && "not implemented in base class");}
   
+  /// @brief non-owning view of a contiguous range of rows of the storage of 'this'
+  virtual hiopMatrixDense* new_rows_view(int row_start, int num_rows) const
+  {
+    assert(false && "not implemented in base class");
+    return NULL;
+  }
+
   /// @brief copies 'src' into this as a block starting at (i_block_start,j_block_start)
   virtual void copyBlockFromMatrix(const long i_block_start, const long j_block_start,
 			   const hiopMatrixDense& src){assert(false && "not implemented in base class");}
@@ -212,10 +245,8 @@ public:
   virtual void replaceRow(long long row, const hiopVector& vec){assert(false && "not implemented in base class");}
   /// @brief copies row 'irow' in the vector 'row_vec' (sizes should match)
   virtual void getRow(long long irow, hiopVector& row_vec){assert(false && "not implemented in base class");}
-#ifdef HIOP_DEEPCHECKS
   virtual void overwriteUpperTriangleWithLower(){assert(false && "not implemented in base class");}
   virtual void overwriteLowerTriangleWithUpper(){assert(false && "not implemented in base class");}
-#endif
   virtual long long get_local_size_n() const {assert(false && "not implemented in base class"); return 0;}
   virtual long long get_local_size_m() const {assert(false && "not implemented in base class"); return 0;}
   virtual MPI_Comm get_mpi_comm() const { return comm_; }
@@ -58,9 +58,14 @@
 
 #include "hiopVectorPar.hpp"
 
+#include "hiopOmp.hpp"
+
 namespace hiop
 {
 
+// size of the square tiles used by the transposed kernels
+static const int TRANSPOSE_TILE_SIZE = 32;
+
 hiopMatrixDenseRowMajor::hiopMatrixDenseRowMajor(const long long& m, 
 				 const long long& glob_n, 
 				 long long* col_part/*=NULL*/, 
@@ -94,12 +99,14 @@ hiopMatrixDenseRowMajor::hiopMatrixDenseRowMajor(const long long& m,
 
   //internal buffers 
   buff_mxnlocal_ = NULL;//new double[max_rows_*n_local_];
+  owns_data_ = true;
+  omp_ = hiopOmpParams::defaults();
 }
 hiopMatrixDenseRowMajor::~hiopMatrixDenseRowMajor()
 {
   if(buff_mxnlocal_) delete[] buff_mxnlocal_;
   if(M_) {
-    if(M_[0]) delete[] M_[0];
+    if(owns_data_ && M_[0]) delete[] M_[0];
     delete[] M_;
   }
 }
@@ -121,6 +128,8 @@ hiopMatrixDenseRowMajor::hiopMatrixDenseRowMajor(const hiopMatrixDenseRowMajor&
     M_[i]=M_[0]+i*n_local_;
 
   buff_mxnlocal_ = NULL;
+  owns_data_ = true;
+  omp_ = dm.omp_;
 }
 
 void hiopMatrixDenseRowMajor::appendRow(const hiopVector& row)
@@ -280,7 +289,6 @@ void hiopMatrixDenseRowMajor::getRow(long long irow, hiopVector& row_vec)
   memcpy(vec.local_data(), M_[irow], n_local_*sizeof(double));
 }
 
-#ifdef HIOP_DEEPCHECKS
 void hiopMatrixDenseRowMajor::overwriteUpperTriangleWithLower()
 {
   assert(n_local_==n_global_ && "Use only with local, non-distributed matrices");
@@ -295,7 +303,6 @@ void hiopMatrixDenseRowMajor::overwriteLowerTriangleWithUpper()
     for(int j=0; j<i; j++)
       M_[i][j] = M_[j][i];
 }
-#endif
 
 hiopMatrixDense* hiopMatrixDenseRowMajor::alloc_clone() const
 {
@@ -310,6 +317,28 @@ hiopMatrixDense* hiopMatrixDenseRowMajor::new_copy() const
   return c;
 }
 
+hiopMatrixDense* hiopMatrixDenseRowMajor::new_rows_view(int row_start, int num_rows) const
+{
+  assert(row_start>=0 && num_rows>=0);
+  if(row_start<0 || num_rows<0 || row_start+num_rows>max_rows_) {
+    return NULL;
+  }
+  hiopMatrixDenseRowMajor* v = new hiopMatrixDenseRowMajor();
+  v->m_local_ = num_rows; v->n_global_ = n_global_; v->n_local_ = n_local_;
+  v->glob_jl_ = glob_jl_; v->glob_ju_ = glob_ju_;
+  v->comm_ = comm_; v->myrank_ = myrank_;
+  v->max_rows_ = num_rows;
+  v->owns_data_ = false;
+  v->buff_mxnlocal_ = NULL;
+  v->omp_ = omp_;
+
+  v->M_ = new double*[num_rows==0?1:num_rows];
+  v->M_[0] = max_rows_==0 ? NULL : M_[0]+(long long)row_start*n_local_;
+  for(int i=1; i<num_rows; i++)
+    v->M_[i] = v->M_[0]+i*n_local_;
+  return v;
+}
+
 void hiopMatrixDenseRowMajor::setToZero()
 {
   setToConstant(0.0);
@@ -641,6 +670,73 @@ void hiopMatrixDenseRowMajor::timesMatTrans(double beta, hiopMatrix& W_, double
   memcpy(WM[0], Wglob, n2Red*sizeof(double));
 #endif
 }
+/* W = beta*W + alpha*this*this^T, upper triangle only */
+void hiopMatrixDenseRowMajor::symTimesMatTrans_local(double beta, hiopMatrix& W_, double alpha) const
+{
+  auto& W = dynamic_cast<hiopMatrixDenseRowMajor&>(W_);
+#ifdef HIOP_DEEPCHECKS
+  assert(W.m()==m_local_);
+  assert(W.n()==m_local_);
+#endif
+  assert(W.n_local_==W.n_global_ && "not intended for the case when the result matrix is distributed.");
+  if(m_local_==0) return;
+  if(n_local_==0) {
+    //as DSYRK, do not multiply by beta when it is zero so that W's garbage is not propagated
+    for(int i=0; i<m_local_; i++)
+      for(int j=i; j<m_local_; j++)
+	W.M_[i][j] = 0.0==beta ? 0.0 : beta*W.M_[i][j];
+    return;
+  }
+
+  /* C = alpha*op(A)*op(A)^T + beta*C; 'this' is seen by Fortran as the n_local x m matrix this^T, 
+   * so op(A)=A^T, and the C++ upper triangle of W is the Fortran lower triangle */
+  char uplo='L', trans='T';
+  int N=m_local_, K=n_local_, lda=n_local_, ldw=W.n_local_;
+  DSYRK(&uplo, &trans, &N, &K, &alpha, this->M_[0], &lda, &beta, W.M_[0], &ldw);
+}
+/* W = beta*W + alpha*this*this^T, upper triangle only */
+void hiopMatrixDenseRowMajor::symTimesMatTrans(double beta, hiopMatrix& W_, double alpha) const
+{
+  auto& W = dynamic_cast<hiopMatrixDenseRowMajor&>(W_); 
+  assert(W.n_local_==W.n_global_ && "not intended for the case when the result matrix is distributed.");
+#ifdef HIOP_DEEPCHECKS
+  assert(this->m()==W.m());
+  assert(this->m()==W.n());
+#endif
+  if(W.m()==0) return;
+
+  if(0==myrank_) symTimesMatTrans_local(beta,W_,alpha);
+  else          symTimesMatTrans_local(0.,  W_,alpha);
+
+#ifdef HIOP_USE_MPI
+  //only the m*(m+1)/2 elements of the upper triangle are reduced
+  int n2Red=W.m()*(W.m()+1)/2;
+  double* Wpacked = W.new_mxnlocal_buff();
+  W.packUpperTriangle(Wpacked);
+  int ierr = MPI_Allreduce(MPI_IN_PLACE, Wpacked, n2Red, MPI_DOUBLE, MPI_SUM, comm_); assert(ierr==MPI_SUCCESS);
+  W.unpackUpperTriangle(Wpacked);
+#endif
+}
+
+void hiopMatrixDenseRowMajor::packUpperTriangle(double* buffer) const
+{
+  assert(n_local_==n_global_ && "Use only with local, non-distributed matrices");
+  assert(n_local_==m_local_);
+  for(int i=0; i<m_local_; i++) {
+    memcpy(buffer, M_[i]+i, (m_local_-i)*sizeof(double));
+    buffer += m_local_-i;
+  }
+}
+
+void hiopMatrixDenseRowMajor::unpackUpperTriangle(const double* buffer)
+{
+  assert(n_local_==n_global_ && "Use only with local, non-distributed matrices");
+  assert(n_local_==m_local_);
+  for(int i=0; i<m_local_; i++) {
+    memcpy(M_[i]+i, buffer, (m_local_-i)*sizeof(double));
+    buffer += m_local_-i;
+  }
+}
 void hiopMatrixDenseRowMajor::addDiagonal(const double& alpha, const hiopVector& d_)
 {
   const hiopVectorPar& d = dynamic_cast<const hiopVectorPar&>(d_);
@@ -722,33 +818,44 @@ void hiopMatrixDenseRowMajor::addToSymDenseMatrixUpperTriangle(int row_start, in
   assert(row_start>=0 && m()+row_start<=W.m());
   assert(col_start>=0 && n()+col_start<=W.n());
   assert(W.n()==W.m());
+  assert((m_local_==0 || n_local_==0 || row_start+m_local_-1<=col_start) && 
+	 "source entries need to map inside the upper triangular part of destination");
 
   double** WM = W.get_M();
+  int n=n_local_, one=1;
+  //rows of 'this' are added to contiguous segments of rows of W
+  HIOP_OMP_FOR(m_local_*n_local_, omp_)
   for(int i=0; i<m_local_; i++) {
-    const int iW = i+row_start;
-    for(int j=0; j<n_local_; j++) {
-      const int jW = j+col_start;
-      assert(iW<=jW && "source entries need to map inside the upper triangular part of destination");
-      WM[iW][jW] += alpha*this->M_[i][j];
-    }
+    DAXPY(&n, &alpha, M_[i], &one, WM[i+row_start]+col_start, &one);
   }
 }
 
-/* block of W += alpha*this' */
+/* block of W += alpha*this' 
+ * The transposition is done on square tiles so that both the reads from 'this' and the 
+ * writes in W stay in cache; the rows of W are written contiguously inside a tile. */
 void hiopMatrixDenseRowMajor::transAddToSymDenseMatrixUpperTriangle(int row_start, int col_start, 
 							    double alpha, hiopMatrixDense& W) const
 {
   assert(row_start>=0 && n()+row_start<=W.m());
   assert(col_start>=0 && m()+col_start<=W.n());
   assert(W.n()==W.m());
+  assert((m_local_==0 || n_local_==0 || row_start+n_local_-1<=col_start) && 
+	 "source entries need to map inside the upper triangular part of destination");
 
   double** WM = W.get_M();
-  for(int ir=0; ir<m_local_; ir++) {
-    const int jW = ir+col_start;
-    for(int jc=0; jc<n_local_; jc++) {
-      const int iW = jc+row_start;
-      assert(iW<=jW && "source entries need to map inside the upper triangular part of destination");
-      WM[iW][jW] += alpha*this->M_[ir][jc];
+  const int bs = TRANSPOSE_TILE_SIZE;
+  //each thread owns distinct rows of W, i.e., distinct columns 'jc' of 'this'
+  HIOP_OMP_FOR(m_local_*n_local_, omp_)
+  for(int jc0=0; jc0<n_local_; jc0+=bs) {
+    const int jc1 = std::min(jc0+bs, n_local_);
+    for(int ir0=0; ir0<m_local_; ir0+=bs) {
+      const int ir1 = std::min(ir0+bs, m_local_);
+      for(int jc=jc0; jc<jc1; jc++) {
+	double* WMrow = WM[jc+row_start]+col_start;
+	for(int ir=ir0; ir<ir1; ir++) {
+	  WMrow[ir] += alpha*M_[ir][jc];
+	}
+      }
     }
   }
 }
@@ -771,14 +878,13 @@ addUpperTriangleToSymDenseMatrixUpperTriangle(int diag_start,
   assert(this->n()==this->m());
   assert(diag_start+this->n() <= W.n());
   double** WM = W.get_M();
+  int one=1;
+  //the upper triangular part of row i of 'this' is added to a contiguous segment of row i of W
+  HIOP_OMP_FOR(n_local_*n_local_/2, omp_)
   for(int i=0; i<n_local_; i++) {
     const int iW = i+diag_start;
-    for(int j=i; j<m_local_; j++) {
-      const int jW = j+diag_start;
-      assert(iW<=jW && "source entries need to map inside the upper triangular part of destination");
-      assert(iW<W.n() && jW<W.m());
-      WM[iW][jW] += alpha*this->M_[i][j];
-    }
+    int len = m_local_-i;
+    DAXPY(&len, &alpha, M_[i]+i, &one, WM[iW]+iW, &one);
   }
 }
 
@@ -795,6 +901,37 @@ double hiopMatrixDenseRowMajor::max_abs_value()
   return maxv;
 }
 
+void hiopMatrixDenseRowMajor::row_max_abs_value(hiopVector& ret_vec)
+{
+  assert(ret_vec.get_local_size() == m_local_);
+  double* ret = ret_vec.local_data();
+  for(int i=0; i<m_local_; i++) {
+    double maxv = 0.;
+    const double* Mi = M_[i];
+    for(int j=0; j<n_local_; j++) {
+      maxv = fmax(maxv, fabs(Mi[j]));
+    }
+    ret[i] = maxv;
+  }
+#ifdef HIOP_USE_MPI
+  if(n_local_<n_global_ && m_local_>0) {
+    int ierr=MPI_Allreduce(MPI_IN_PLACE, ret, m_local_, MPI_DOUBLE, MPI_MAX, comm_);
+    assert(ierr==MPI_SUCCESS);
+  }
+#endif
+}
+
+void hiopMatrixDenseRowMajor::scale_row(hiopVector& vec_scal, const bool inv_scale)
+{
+  assert(vec_scal.get_local_size() == m_local_);
+  const double* s = vec_scal.local_data_const();
+  int one=1;
+  for(int i=0; i<m_local_; i++) {
+    double si = inv_scale ? 1./s[i] : s[i];
+    DSCAL(&n_local_, &si, M_[i], &one);
+  }
+}
+
 #ifdef HIOP_DEEPCHECKS
 bool hiopMatrixDenseRowMajor::assertSymmetry(double tol) const
 {
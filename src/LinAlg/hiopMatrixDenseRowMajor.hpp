@@ -121,6 +121,25 @@ public:
   /* Contains dgemm wrapper needed by the above */
   virtual void timesMatTrans_local(double beta, hiopMatrix& W, double alpha, const hiopMatrix& X) const;
 
+  /** 
+   * @brief W = beta*W + alpha*this*this^T; only the upper triangle of W is updated
+   * @pre 'W' need to be local/non-distributed and square with this->m() rows.
+   *
+   * 'this' can be distributed, in which case only the packed upper triangle of W is reduced.
+   */
+  virtual void symTimesMatTrans(double beta, hiopMatrix& W, double alpha) const;
+  /* Contains dsyrk wrapper needed by the above */
+  virtual void symTimesMatTrans_local(double beta, hiopMatrix& W, double alpha) const;
+
+  /**
+   * @brief copies the upper triangle of 'this' row by row in 'buffer', which should have m*(m+1)/2 
+   * elements; used to communicate only the upper triangle of symmetric matrices
+   * @pre 'this' is local/non-distributed and square
+   */
+  virtual void packUpperTriangle(double* buffer) const;
+  /// @brief the inverse of the above; the lower triangle of 'this' is not touched
+  virtual void unpackUpperTriangle(const double* buffer);
+
   virtual void addDiagonal(const double& alpha, const hiopVector& d_);
   virtual void addDiagonal(const double& value);
   virtual void addSubDiagonal(const double& alpha, long long start_on_dest_diag, const hiopVector& d_);
@@ -171,6 +190,11 @@ public:
 
   virtual double max_abs_value();
 
+  /* the maximum is taken over all the columns, including the ones owned by other ranks */
+  virtual void row_max_abs_value(hiopVector& ret);
+
+  virtual void scale_row(hiopVector& vec_scal, const bool inv_scale);
+
   virtual bool isfinite() const;
   
   //virtual void print(int maxRows=-1, int maxCols=-1, int rank=-1) const;
@@ -179,6 +203,19 @@ public:
   virtual hiopMatrixDense* alloc_clone() const;
   virtual hiopMatrixDense* new_copy() const;
 
+  /// @brief 'params' should outlive 'this' and is passed on to the clones and the row views
+  virtual void set_omp_params(const hiopOmpParams* params) { omp_ = params; }
+
+  /**
+   * @brief Returns a matrix that does not own its storage and whose rows are the rows 
+   * [row_start, row_start+num_rows) of the storage of 'this'. The rows can extend past m() up
+   * to the number of rows allocated for 'this' (see 'm_max_alloc' in the constructor). Returns
+   * NULL when the rows are not within the allocated storage.
+   *
+   * 'this' must outlive the returned matrix.
+   */
+  virtual hiopMatrixDense* new_rows_view(int row_start, int num_rows) const;
+
   void appendRow(const hiopVector& row);
 
   /// @brief copies the first 'num_rows' rows from 'src' to 'this' starting at 'row_dest'
@@ -207,10 +244,8 @@ public:
   void replaceRow(long long row, const hiopVector& vec);
   /// @brief copies row 'irow' in the vector 'row_vec' (sizes should match)
   void getRow(long long irow, hiopVector& row_vec);
-#ifdef HIOP_DEEPCHECKS
   void overwriteUpperTriangleWithLower();
   void overwriteLowerTriangleWithUpper();
-#endif
   virtual long long get_local_size_n() const { return n_local_; }
   virtual long long get_local_size_m() const { return m_local_; }
   virtual MPI_Comm get_mpi_comm() const { return comm_; }
@@ -235,6 +270,12 @@ private:
 
   //this is very private do not touch :)
   long long max_rows_;
+
+  //false for the matrices returned by 'new_rows_view'
+  bool owns_data_;
+
+  //threading parameters, not owned
+  const hiopOmpParams* omp_;
 private:
   hiopMatrixDenseRowMajor() {};
   /** copy constructor, for internal/private use only (it doesn't copy the values) */
@@ -19,9 +19,11 @@ namespace hiop
 class hiopMatrixMDS : public hiopMatrix
 {
 public:
-  hiopMatrixMDS(int rows, int cols_sparse, int cols_dense, int nnz_sparse)
+  /* 'sparse_format' is the storage of the sparse block, see LinearAlgebraFactory::createMatrixSparse */
+  hiopMatrixMDS(int rows, int cols_sparse, int cols_dense, int nnz_sparse, 
+		const std::string& sparse_format="triplet")
   {
-    mSp = LinearAlgebraFactory::createMatrixSparse(rows, cols_sparse, nnz_sparse);
+    mSp = LinearAlgebraFactory::createMatrixSparse(rows, cols_sparse, nnz_sparse, sparse_format);
     mDe = LinearAlgebraFactory::createMatrixDense(rows, cols_dense);
   }
   virtual ~hiopMatrixMDS()
@@ -167,6 +169,24 @@ public:
     return std::max(mSp->max_abs_value(), mDe->max_abs_value());
   }
 
+  virtual void row_max_abs_value(hiopVector& ret)
+  {
+    mSp->row_max_abs_value(ret);
+    hiopVector* ret_de = ret.alloc_clone();
+    mDe->row_max_abs_value(*ret_de);
+    double* reta = ret.local_data();
+    const double* ret_dea = ret_de->local_data_const();
+    for(int i=0; i<ret.get_local_size(); i++)
+      reta[i] = std::max(reta[i], ret_dea[i]);
+    delete ret_de;
+  }
+
+  virtual void scale_row(hiopVector& vec_scal, const bool inv_scale)
+  {
+    mSp->scale_row(vec_scal, inv_scale);
+    mDe->scale_row(vec_scal, inv_scale);
+  }
+
   virtual bool isfinite() const
   {
     return mSp->isfinite() && mDe->isfinite();
@@ -179,6 +199,12 @@ public:
     mDe->print(f,msg,maxRows,maxCols,rank);
   }
 
+  virtual void set_omp_params(const hiopOmpParams* params)
+  {
+    mSp->set_omp_params(params);
+    mDe->set_omp_params(params);
+  }
+
   virtual hiopMatrix* alloc_clone() const
   {
     hiopMatrixMDS* m = new hiopMatrixMDS();
@@ -380,6 +406,16 @@ public:
     return std::max(mSp->max_abs_value(), mDe->max_abs_value());
   }
 
+  virtual void row_max_abs_value(hiopVector& ret)
+  {
+    assert(false && "not needed for symmetric matrices");
+  }
+
+  virtual void scale_row(hiopVector& vec_scal, const bool inv_scale)
+  {
+    assert(false && "not supported for symmetric matrices");
+  }
+
   virtual bool isfinite() const
   {
     return mSp->isfinite() && mDe->isfinite();
@@ -392,6 +428,12 @@ public:
     mDe->print(f,msg,maxRows,maxCols,rank);
   }
 
+  virtual void set_omp_params(const hiopOmpParams* params)
+  {
+    mSp->set_omp_params(params);
+    mDe->set_omp_params(params);
+  }
+
   virtual hiopMatrix* alloc_clone() const
   {
     hiopMatrixSymBlockDiagMDS* m = new hiopMatrixSymBlockDiagMDS();
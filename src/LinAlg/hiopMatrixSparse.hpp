@@ -95,6 +95,10 @@ public:
 
   virtual double max_abs_value() = 0;
 
+  virtual void row_max_abs_value(hiopVector& ret) = 0;
+
+  virtual void scale_row(hiopVector& vec_scal, const bool inv_scale) = 0;
+
   virtual bool isfinite() const = 0;
 
   // virtual void print(int maxRows=-1, int maxCols=-1, int rank=-1) const;
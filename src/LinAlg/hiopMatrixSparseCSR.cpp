@@ -0,0 +1,162 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#include "hiopMatrixSparseCSR.hpp"
+#include "hiopVectorPar.hpp"
+
+#include <cstring>
+
+#include <cassert>
+
+#include "hiopOmp.hpp"
+
+namespace hiop
+{
+
+hiopMatrixSparseCSR::hiopMatrixSparseCSR(int rows, int cols, int nnz)
+  : hiopMatrixSparseTriplet(rows, cols, nnz), col_starts_(NULL), omp_(hiopOmpParams::defaults())
+{
+}
+
+hiopMatrixSparseCSR::~hiopMatrixSparseCSR()
+{
+  delete col_starts_;
+}
+
+/** y = beta * y + alpha * this * x */
+void hiopMatrixSparseCSR::timesVec(double beta,  double* y,
+				   double alpha, const double* x) const
+{
+  const int* row_start = row_starts();
+  const int* jcol = jCol_;
+  const double* vals = values_;
+
+  HIOP_OMP_FOR(nnz_, omp_)
+  for(int i=0; i<nrows_; i++) {
+    double dot=0.;
+    for(int k=row_start[i]; k<row_start[i+1]; k++) {
+      assert(jcol[k] < ncols_);
+      dot += vals[k] * x[jcol[k]];
+    }
+    y[i] = beta*y[i] + alpha*dot;
+  }
+}
+
+/** y = beta * y + alpha * this^T * x */
+void hiopMatrixSparseCSR::transTimesVec(double beta,   double* y,
+					double alpha, const double* x) const
+{
+  if(NULL==col_starts_) col_starts_ = allocAndBuildColStarts();
+  const int* col_start = col_starts_->idx_start_;
+  const int* perm = col_starts_->perm_;
+  const int* row = col_starts_->row_;
+  const double* vals = values_;
+
+  HIOP_OMP_FOR(nnz_, omp_)
+  for(int j=0; j<ncols_; j++) {
+    double dot=0.;
+    for(int k=col_start[j]; k<col_start[j+1]; k++) {
+      assert(row[k] < nrows_);
+      dot += vals[perm[k]] * x[row[k]];
+    }
+    y[j] = beta*y[j] + alpha*dot;
+  }
+}
+
+/* Counting sort of the nonzeros on columns; within a column, the nonzeros remain ordered 
+ * on rows since the triplets are ordered on rows */
+hiopMatrixSparseCSR::ColStartsInfo* hiopMatrixSparseCSR::allocAndBuildColStarts() const
+{
+  assert(ncols_>=0);
+  ColStartsInfo* csi = new ColStartsInfo(ncols_, nnz_); assert(csi);
+
+  int* col_start = csi->idx_start_;
+  for(int j=0; j<=ncols_; j++) col_start[j]=0;
+  for(int k=0; k<nnz_; k++) {
+    assert(jCol_[k]>=0 && jCol_[k]<ncols_);
+    col_start[jCol_[k]+1]++;
+  }
+  for(int j=0; j<ncols_; j++) col_start[j+1] += col_start[j];
+  assert(col_start[ncols_]==nnz_);
+
+  //'next' holds the next free position in each column
+  int* next = new int[ncols_==0?1:ncols_];
+  memcpy(next, col_start, ncols_*sizeof(int));
+  for(int k=0; k<nnz_; k++) {
+#ifdef HIOP_DEEPCHECKS
+    if(k>=1) assert(iRow_[k-1]<=iRow_[k] && "row indexes are not sorted");
+#endif
+    const int pos = next[jCol_[k]]++;
+    csi->perm_[pos] = k;
+    csi->row_[pos] = iRow_[k];
+  }
+  delete[] next;
+  return csi;
+}
+
+hiopMatrix* hiopMatrixSparseCSR::alloc_clone() const
+{
+  hiopMatrixSparseCSR* c = new hiopMatrixSparseCSR(nrows_, ncols_, nnz_);
+  c->omp_ = omp_;
+  return c;
+}
+
+hiopMatrix* hiopMatrixSparseCSR::new_copy() const
+{
+#ifdef HIOP_DEEPCHECKS
+  assert(this->checkIndexesAreOrdered());
+#endif
+  hiopMatrixSparseCSR* copy = new hiopMatrixSparseCSR(nrows_, ncols_, nnz_);
+  memcpy(copy->iRow_, iRow_, nnz_*sizeof(int));
+  memcpy(copy->jCol_, jCol_, nnz_*sizeof(int));
+  memcpy(copy->values_, values_, nnz_*sizeof(double));
+  copy->omp_ = omp_;
+  return copy;
+}
+
+} //end of namespace
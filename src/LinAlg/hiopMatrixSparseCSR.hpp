@@ -0,0 +1,134 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#ifndef HIOP_SPARSE_MATRIX_CSR
+#define HIOP_SPARSE_MATRIX_CSR
+
+#include "hiopMatrixSparseTriplet.hpp"
+
+#include <cassert>
+
+namespace hiop
+{
+
+/** 
+ * @brief Sparse matrix of doubles in compressed sparse row (CSR) format - it is not distributed
+ *
+ * The column indexes and the values of the nonzeros are the arrays of the triplet format, 
+ * which is why the nonzeros need to be ordered on rows and then on columns, and the matrix 
+ * is populated through the triplet interface ('i_row', 'j_col', 'M'). The row starts, and a
+ * column-wise (CSC) index of the nonzeros used by the transposed products, are built the 
+ * first time they are needed; the sparsity pattern is assumed to not change afterwards.
+ *
+ * The products with vectors loop over rows (columns for the transposed products) and do not 
+ * scatter, hence they are threaded when HiOp is built with HIOP_USE_OPENMP.
+ */
+class hiopMatrixSparseCSR : public hiopMatrixSparseTriplet
+{
+public:
+  hiopMatrixSparseCSR(int rows, int cols, int nnz);
+  virtual ~hiopMatrixSparseCSR(); 
+
+  using hiopMatrixSparseTriplet::timesVec;
+  using hiopMatrixSparseTriplet::transTimesVec;
+
+  /** y = beta * y + alpha * this * x */
+  virtual void timesVec(double beta,  double* y,
+			double alpha, const double* x) const;
+  /** y = beta * y + alpha * this^T * x */
+  virtual void transTimesVec(double beta,   double* y,
+			     double alpha, const double* x) const;
+
+  virtual hiopMatrix* alloc_clone() const;
+  virtual hiopMatrix* new_copy() const;
+
+  /// @brief 'params' should outlive 'this' and is passed on to the clones
+  virtual void set_omp_params(const hiopOmpParams* params) { omp_ = params; }
+
+  /// @brief row starts (of size m()+1) in the arrays 'j_col' and 'M'
+  inline const int* row_starts() const
+  {
+    if(NULL==row_starts_) row_starts_ = allocAndBuildRowStarts();
+    return row_starts_->idx_start_;
+  }
+protected:
+  /**
+   * Column-wise index of the nonzeros: the nonzeros of column j are 
+   * M()[perm_[k]], with row indexes row_[k], for k in [idx_start_[j], idx_start_[j+1]).
+   */
+  struct ColStartsInfo
+  {
+    int *idx_start_; //size num_cols+1
+    int *perm_; //size nnz
+    int *row_; //size nnz
+    ColStartsInfo(int n_cols, int nnz)
+      : idx_start_(new int[n_cols+1]), perm_(new int[nnz]), row_(new int[nnz])
+    {}
+    virtual ~ColStartsInfo()
+    {
+      delete[] idx_start_;
+      delete[] perm_;
+      delete[] row_;
+    }
+  };
+  mutable ColStartsInfo* col_starts_;
+  //threading parameters, not owned
+  const hiopOmpParams* omp_;
+private:
+  ColStartsInfo* allocAndBuildColStarts() const;
+private:
+  hiopMatrixSparseCSR(const hiopMatrixSparseCSR&) 
+    : hiopMatrixSparseTriplet(0, 0, 0), col_starts_(NULL), omp_(NULL)
+  {
+    assert(false);
+  }
+};
+
+} //end of namespace
+
+#endif
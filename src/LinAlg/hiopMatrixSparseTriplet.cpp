@@ -6,6 +6,7 @@
 #include <algorithm> //for std::min
 #include <cmath> //for std::isfinite
 #include <cstring>
+#include <vector>
 
 #include <cassert>
 
@@ -14,7 +15,7 @@ namespace hiop
 
 hiopMatrixSparseTriplet::hiopMatrixSparseTriplet(int rows, int cols, int nnz)
   : hiopMatrixSparse(rows, cols, nnz)
-  , row_starts_(NULL)
+  , row_starts_(NULL), row_pairs_MMt_(NULL), row_pairs_MNt_(NULL)
 {
   if(rows==0 || cols==0) {
     assert(nnz_==0 && "number of nonzeros must be zero when any of the dimensions are 0");
@@ -32,6 +33,8 @@ hiopMatrixSparseTriplet::~hiopMatrixSparseTriplet()
   delete [] jCol_;
   delete [] values_;
   delete row_starts_;
+  delete row_pairs_MMt_;
+  delete row_pairs_MNt_;
 }
 
 void hiopMatrixSparseTriplet::setToZero()
@@ -190,6 +193,27 @@ double hiopMatrixSparseTriplet::max_abs_value()
   return maxv;
 }
 
+void hiopMatrixSparseTriplet::row_max_abs_value(hiopVector& ret_vec)
+{
+  assert(ret_vec.get_local_size() == nrows_);
+  double* ret = ret_vec.local_data();
+  for(int i=0; i<nrows_; i++) ret[i] = 0.;
+  for(int k=0; k<nnz_; k++) {
+    ret[iRow_[k]] = fmax(ret[iRow_[k]], fabs(values_[k]));
+  }
+}
+
+void hiopMatrixSparseTriplet::scale_row(hiopVector& vec_scal, const bool inv_scale)
+{
+  assert(vec_scal.get_local_size() == nrows_);
+  const double* s = vec_scal.local_data_const();
+  if(inv_scale) {
+    for(int k=0; k<nnz_; k++) values_[k] /= s[iRow_[k]];
+  } else {
+    for(int k=0; k<nnz_; k++) values_[k] *= s[iRow_[k]];
+  }
+}
+
 bool hiopMatrixSparseTriplet::isfinite() const
 {
 
@@ -249,42 +273,24 @@ addMDinvMtransToDiagBlockOfSymDeMatUTri(int rowAndCol_dest_start,
   double** WM = W.get_M();
   const double* DM = D.local_data_const();
 
-  if(row_starts_==NULL) row_starts_ = allocAndBuildRowStarts();
-  assert(row_starts_);
+  if(row_pairs_MMt_==NULL) row_pairs_MMt_ = allocAndBuildRowPairs(*this, true);
+  assert(row_pairs_MMt_);
+  assert(row_pairs_MMt_->nnz_N_ == nnz_ && "sparsity pattern changed");
 
+  const RowPairsInfo& rp = *row_pairs_MMt_;
   double acc;
 
-  for(int i=0; i<this->nrows_; i++) {
-    //j==i
+  for(int p=0; p<rp.num_pairs_; p++) {
+    //dest[i,j] = weigthed_dotprod(this_row_i,this_row_j)
     acc = 0.;
-    for(int k=row_starts_->idx_start_[i]; k<row_starts_->idx_start_[i+1]; k++)
-      acc += this->values_[k] / DM[this->jCol_[k]] * this->values_[k];
-    WM[i+row_dest_start][i+col_dest_start] += alpha*acc;
-
-    //j>i
-    for(int j=i+1; j<this->nrows_; j++) {
-      //dest[i,j] = weigthed_dotprod(this_row_i,this_row_j)
-      acc = 0.;
-
-      int ki=row_starts_->idx_start_[i], kj=row_starts_->idx_start_[j];
-      while(ki<row_starts_->idx_start_[i+1] && kj<row_starts_->idx_start_[j+1]) {
-	assert(ki<this->nnz_); 
-	assert(kj<this->nnz_);
-	if(this->jCol_[ki] == this->jCol_[kj]) { 
-	  acc += this->values_[ki] / DM[this->jCol_[ki]] * this->values_[kj];
-	  ki++;
-	  kj++;
-	} else {
-	  if(this->jCol_[ki]<this->jCol_[kj]) ki++;
-	  else                              kj++;
-	}
-      } //end of loop over ki and kj
-
-      WM[i+row_dest_start][j+col_dest_start] += alpha*acc;
-
-    } //end j
-  } // end i
-
+    for(int q=rp.pair_start_[p]; q<rp.pair_start_[p+1]; q++) {
+      const int ki = rp.k_M_[q], kj = rp.k_N_[q];
+      assert(this->jCol_[ki] == this->jCol_[kj]);
+      acc += this->values_[ki] / DM[this->jCol_[ki]] * this->values_[kj];
+    }
+    assert(rp.pair_row_M_[p] <= rp.pair_row_N_[p]);
+    WM[rp.pair_row_M_[p]+row_dest_start][rp.pair_row_N_[p]+col_dest_start] += alpha*acc;
+  }
 }
 
 /*
@@ -312,52 +318,113 @@ addMDinvNtransToSymDeMatUTri(int row_dest_start, int col_dest_start,
   double** WM = W.get_M();
   const double* DM = D.local_data_const();
 
-  // TODO: allocAndBuildRowStarts -> should create row_starts internally (name='prepareRowStarts' ?)
-  if(M1.row_starts_==NULL) M1.row_starts_ = M1.allocAndBuildRowStarts();
-  assert(M1.row_starts_);
-
-  if(M2.row_starts_==NULL) M2.row_starts_ = M2.allocAndBuildRowStarts();
-  assert(M2.row_starts_);
+  //the symbolic info is rebuilt only when the product involves a different M2
+  if(row_pairs_MNt_!=NULL && row_pairs_MNt_->N_!=&M2) {
+    delete row_pairs_MNt_;
+    row_pairs_MNt_ = NULL;
+  }
+  if(row_pairs_MNt_==NULL) row_pairs_MNt_ = allocAndBuildRowPairs(M2, false);
+  assert(row_pairs_MNt_);
+  assert(row_pairs_MNt_->nnz_N_ == M2.nnz_ && "sparsity pattern changed");
 
+  const RowPairsInfo& rp = *row_pairs_MNt_;
   double acc;
 
-  for(int i=0; i<m1; i++) {
-    // j>=i
-    for(int j=0; j<m2; j++) {
-
-      // dest[i,j] = weigthed_dotprod(M1_row_i,M2_row_j)
-      acc = 0.;
-      int ki=M1.row_starts_->idx_start_[i];
-      int kj=M2.row_starts_->idx_start_[j];
-      
-      while(ki<M1.row_starts_->idx_start_[i+1] && kj<M2.row_starts_->idx_start_[j+1]) {
-	assert(ki<M1.nnz_);
-   	assert(kj<M2.nnz_);
-
-        if(M1.jCol_[ki] == M2.jCol_[kj]) {
+  for(int p=0; p<rp.num_pairs_; p++) {
+    const int i = rp.pair_row_M_[p], j = rp.pair_row_N_[p];
 
-	  acc += M1.values_[ki] / DM[this->jCol_[ki]] * M2.values_[kj];
-   	  ki++;
-   	  kj++;
-   	} else {
-   	  if(M1.jCol_[ki]<M2.jCol_[kj]) ki++;
-   	  else                      kj++;
-   	}
-      } //end of loop over ki and kj
+    // dest[i,j] = weigthed_dotprod(M1_row_i,M2_row_j)
+    acc = 0.;
+    for(int q=rp.pair_start_[p]; q<rp.pair_start_[p+1]; q++) {
+      const int ki = rp.k_M_[q], kj = rp.k_N_[q];
+      assert(M1.jCol_[ki] == M2.jCol_[kj]);
+      acc += M1.values_[ki] / DM[this->jCol_[ki]] * M2.values_[kj];
+    }
 
 #ifdef HIOP_DEEPCHECKS
-      if(i+row_dest_start > j+col_dest_start)
-	printf("[warning] lower triangular element updated in addMDinvNtransToSymDeMatUTri\n");
+    if(i+row_dest_start > j+col_dest_start)
+      printf("[warning] lower triangular element updated in addMDinvNtransToSymDeMatUTri\n");
 #endif
-      assert(i+row_dest_start <= j+col_dest_start);
-      WM[i+row_dest_start][j+col_dest_start] += alpha*acc;
+    assert(i+row_dest_start <= j+col_dest_start);
+    WM[i+row_dest_start][j+col_dest_start] += alpha*acc;
+  }
+}
 
-    } //end j
-  } // end i
+// Symbolic pass for M*D^{-1}*N^T, M=this. Assumes triplets are ordered.
+//
+// The nonzeros of N are first bucketed by columns; then for each row i of M, the (row of N,
+// nonzero of M, nonzero of N) triplets sharing a column are gathered and sorted on the row of 
+// N. Since the nonzeros of row i are traversed in increasing order of the columns, the aligned
+// nonzeros of each pair end up ordered as in a merge of the two rows.
+hiopMatrixSparseTriplet::RowPairsInfo* 
+hiopMatrixSparseTriplet::allocAndBuildRowPairs(const hiopMatrixSparseTriplet& N, bool upper_only) const
+{
+  assert(ncols_ == N.ncols_);
+#ifdef HIOP_DEEPCHECKS
+  assert(this->checkIndexesAreOrdered());
+  assert(N.checkIndexesAreOrdered());
+#endif
+  RowPairsInfo* rpi = new RowPairsInfo(); assert(rpi);
+  rpi->N_ = &N;
+  rpi->nnz_N_ = N.nnz_;
+
+  //column-wise bucketing of the nonzeros of N
+  std::vector<int> col_start(ncols_+1, 0);
+  for(int k=0; k<N.nnz_; k++) col_start[N.jCol_[k]+1]++;
+  for(int c=0; c<ncols_; c++) col_start[c+1] += col_start[c];
+  std::vector<int> col_nz(N.nnz_);
+  {
+    std::vector<int> next(col_start.begin(), col_start.end()-1);
+    for(int k=0; k<N.nnz_; k++) col_nz[next[N.jCol_[k]]++] = k;
+  }
 
+  std::vector<int> pair_row_M, pair_row_N, pair_start(1, 0), k_M, k_N;
+  //(row of N, nonzero of M, nonzero of N) for the current row of M
+  std::vector<std::pair<int, std::pair<int,int> > > row_buff;
+
+  int it_triplet = 0;
+  for(int i=0; i<nrows_; i++) {
+    row_buff.clear();
+    for(; it_triplet<nnz_ && iRow_[it_triplet]==i; it_triplet++) {
+      const int c = jCol_[it_triplet];
+      for(int itc=col_start[c]; itc<col_start[c+1]; itc++) {
+	const int kn = col_nz[itc];
+	if(upper_only && N.iRow_[kn]<i) continue;
+	row_buff.push_back(std::make_pair(N.iRow_[kn], std::make_pair(it_triplet, kn)));
+      }
+    }
+    std::stable_sort(row_buff.begin(), row_buff.end(), 
+		     [](const std::pair<int, std::pair<int,int> >& a,
+			const std::pair<int, std::pair<int,int> >& b) { return a.first<b.first; });
+
+    for(size_t it=0; it<row_buff.size(); it++) {
+      if(it==0 || row_buff[it].first != row_buff[it-1].first) {
+	if(it>0) pair_start.push_back(k_M.size());
+	pair_row_M.push_back(i);
+	pair_row_N.push_back(row_buff[it].first);
+      }
+      k_M.push_back(row_buff[it].second.first);
+      k_N.push_back(row_buff[it].second.second);
+    }
+    if(row_buff.size()>0) pair_start.push_back(k_M.size());
+  }
+  assert(it_triplet==nnz_);
+  assert(pair_start.size() == pair_row_M.size()+1);
+
+  rpi->num_pairs_ = pair_row_M.size();
+  rpi->pair_row_M_ = new int[rpi->num_pairs_];
+  rpi->pair_row_N_ = new int[rpi->num_pairs_];
+  rpi->pair_start_ = new int[rpi->num_pairs_+1];
+  rpi->k_M_ = new int[k_M.size()];
+  rpi->k_N_ = new int[k_N.size()];
+  std::copy(pair_row_M.begin(), pair_row_M.end(), rpi->pair_row_M_);
+  std::copy(pair_row_N.begin(), pair_row_N.end(), rpi->pair_row_N_);
+  std::copy(pair_start.begin(), pair_start.end(), rpi->pair_start_);
+  std::copy(k_M.begin(), k_M.end(), rpi->k_M_);
+  std::copy(k_N.begin(), k_N.end(), rpi->k_N_);
+  return rpi;
 }
 
-
 // //assumes triplets are ordered
 hiopMatrixSparseTriplet::RowStartsInfo* 
 hiopMatrixSparseTriplet::allocAndBuildRowStarts() const
@@ -524,6 +591,18 @@ void hiopMatrixSymSparseTriplet::timesVec(double beta,  double* y,
   }
 }
 
+void hiopMatrixSymSparseTriplet::row_max_abs_value(hiopVector& ret_vec)
+{
+  assert(ret_vec.get_local_size() == nrows_);
+  double* ret = ret_vec.local_data();
+  for(int i=0; i<nrows_; i++) ret[i] = 0.;
+  for(int k=0; k<nnz_; k++) {
+    const double abs_val = fabs(values_[k]);
+    ret[iRow_[k]] = fmax(ret[iRow_[k]], abs_val);
+    ret[jCol_[k]] = fmax(ret[jCol_[k]], abs_val);
+  }
+}
+
 hiopMatrix* hiopMatrixSymSparseTriplet::alloc_clone() const
 {
   assert(nrows_ == ncols_);
@@ -94,6 +94,10 @@ public:
 
   virtual double max_abs_value();
 
+  virtual void row_max_abs_value(hiopVector& ret);
+
+  virtual void scale_row(hiopVector& vec_scal, const bool inv_scale);
+
   virtual bool isfinite() const;
   
   //virtual void print(int maxRows=-1, int maxCols=-1, int rank=-1) const;
@@ -135,8 +139,49 @@ protected:
     }
   };
   mutable RowStartsInfo* row_starts_;
-private:
+
+  /** 
+   * Symbolic information for the products M*D^{-1}*N^T, where M=this, performed by 
+   * 'addMDinvMtransToDiagBlockOfSymDeMatUTri' and 'addMDinvNtransToSymDeMatUTri'. Only the 
+   * pairs of rows (i of M, j of N) that have at least one common column are kept, together
+   * with the indexes of the nonzeros that line up, in a CSR-like layout: the nonzeros of
+   * pair 'p' are k_M_[q] and k_N_[q] for q in [pair_start_[p], pair_start_[p+1]).
+   *
+   * The sparsity pattern is assumed to not change once this info is built.
+   */
+  struct RowPairsInfo
+  {
+    const hiopMatrixSparseTriplet* N_; //the right matrix of the product (=this for M*D^{-1}*M^T)
+    int nnz_N_; //nnz of N_ when the info was built (used only for consistency checks)
+    int num_pairs_;
+    int *pair_row_M_; //size num_pairs_
+    int *pair_row_N_; //size num_pairs_
+    int *pair_start_; //size num_pairs_+1
+    int *k_M_; //size pair_start_[num_pairs_]
+    int *k_N_; //size pair_start_[num_pairs_]
+    RowPairsInfo()
+      : N_(NULL), nnz_N_(0), num_pairs_(0), pair_row_M_(NULL), pair_row_N_(NULL), 
+	pair_start_(NULL), k_M_(NULL), k_N_(NULL)
+    {}
+    virtual ~RowPairsInfo()
+    {
+      delete[] pair_row_M_;
+      delete[] pair_row_N_;
+      delete[] pair_start_;
+      delete[] k_M_;
+      delete[] k_N_;
+    }
+  };
+  // for M*D^{-1}*M^T (only the pairs with i<=j are kept)
+  mutable RowPairsInfo* row_pairs_MMt_;
+  // for M*D^{-1}*N^T 
+  mutable RowPairsInfo* row_pairs_MNt_;
+protected:
   RowStartsInfo* allocAndBuildRowStarts() const; 
+private:
+  /* Symbolic pass building the RowPairsInfo for M*D^{-1}*N^T. When 'upper_only' is true only 
+   * the pairs (i,j) with i<=j are kept */
+  RowPairsInfo* allocAndBuildRowPairs(const hiopMatrixSparseTriplet& N, bool upper_only) const;
 private:
   hiopMatrixSparseTriplet() 
     : hiopMatrixSparse(0, 0, 0), iRow_(NULL), jCol_(NULL), values_(NULL)
@@ -196,6 +241,14 @@ public:
   virtual void startingAtAddSubDiagonalToStartingAt(int diag_src_start, const double& alpha, 
 					    hiopVector& vec_dest, int vec_start, int num_elems=-1) const;
 					    
+  /* accounts for the (not stored) lower triangle */
+  virtual void row_max_abs_value(hiopVector& ret);
+
+  /* scaling only the rows would not preserve the symmetry */
+  virtual void scale_row(hiopVector& vec_scal, const bool inv_scale)
+  {
+    assert(false && "not supported for symmetric matrices");
+  }
 
   virtual hiopMatrix* alloc_clone() const;
   virtual hiopMatrix* new_copy() const;
@@ -53,6 +53,8 @@
 namespace hiop
 {
 
+class hiopOmpParams;
+
 class hiopVector
 {
 public:
@@ -199,6 +201,9 @@ public:
   virtual double* local_data() = 0;
   virtual const double* local_data_const() const = 0;
 
+  /// @brief sets the threading parameters of the kernels; ignored by the non-threaded vectors
+  virtual void set_omp_params(const hiopOmpParams* params) {}
+
 protected:
   long long n_; //we assume sequential data
 
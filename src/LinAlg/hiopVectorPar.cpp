@@ -58,12 +58,26 @@
 #include <limits>
 #include <cstddef>
 
+#include "hiopOmp.hpp"
+
 namespace hiop
 {
 
+#ifdef HIOP_USE_OPENMP
+/* Contiguous range [beg,beg+len) of [0,n) owned by the calling thread of a parallel region;
+ * used to call BLAS on per-thread chunks */
+static inline void omp_thread_range(long long n, int& beg, int& len)
+{
+  const int nt = omp_get_num_threads(), t = omp_get_thread_num();
+  const long long chunk = n/nt, rem = n%nt;
+  beg = t*chunk + (t<rem ? t : rem);
+  len = chunk + (t<rem ? 1 : 0);
+}
+#endif
+
 
 hiopVectorPar::hiopVectorPar(const long long& glob_n, long long* col_part/*=NULL*/, MPI_Comm comm/*=MPI_COMM_NULL*/)
-  : comm_(comm)
+  : comm_(comm), omp_(hiopOmpParams::defaults())
 {
   n_ = glob_n;
   assert(n_>=0);
@@ -84,6 +98,7 @@ hiopVectorPar::hiopVectorPar(const long long& glob_n, long long* col_part/*=NULL
   n_local_=glob_iu_-glob_il_;
 
   data_ = new double[n_local_];
+  owns_data_ = true;
 }
 hiopVectorPar::hiopVectorPar(const hiopVectorPar& v)
 {
@@ -91,10 +106,13 @@ hiopVectorPar::hiopVectorPar(const hiopVectorPar& v)
   glob_il_=v.glob_il_; glob_iu_=v.glob_iu_;
   comm_=v.comm_;
   data_=new double[n_local_];  
+  owns_data_ = true;
+  omp_ = v.omp_;
 }
 hiopVectorPar::~hiopVectorPar()
 {
-  delete[] data_; data_=NULL;
+  if(owns_data_) delete[] data_;
+  data_=NULL;
 }
 
 hiopVector* hiopVectorPar::alloc_clone() const
@@ -108,19 +126,30 @@ hiopVector* hiopVectorPar::new_copy () const
   v->copyFrom(*this);
   return v;
 }
+hiopVectorPar* hiopVectorPar::new_view(double* data) const
+{
+  hiopVectorPar* v = new hiopVectorPar(*this); assert(v);
+  delete[] v->data_;
+  v->data_ = data;
+  v->owns_data_ = false;
+  return v;
+}
 
 void hiopVectorPar::setToZero()
 {
+  HIOP_OMP_FOR(n_local_, omp_)
   for(int i=0; i<n_local_; i++) data_[i]=0.0;
 }
 void hiopVectorPar::setToConstant(double c)
 {
+  HIOP_OMP_FOR(n_local_, omp_)
   for(int i=0; i<n_local_; i++) data_[i]=c;
 }
 void hiopVectorPar::setToConstant_w_patternSelect(double c, const hiopVector& select)
 {
   const hiopVectorPar& s = dynamic_cast<const hiopVectorPar&>(select);
   const double* svec = s.data_;
+  HIOP_OMP_FOR(n_local_, omp_)
   for(int i=0; i<n_local_; i++) if(svec[i]==1.) data_[i]=c; else data_[i]=0.;
 }
 void hiopVectorPar::copyFrom(const hiopVector& v_ )
@@ -234,7 +263,21 @@ void hiopVectorPar::copyTo(double* dest) const
 double hiopVectorPar::twonorm() const 
 {
   int one=1; int n=n_local_;
-  double nrm = DNRM2(&n,data_,&one); 
+  double nrm;
+#ifdef HIOP_USE_OPENMP
+  if(n_local_>=omp_->serial_threshold() && omp_->num_threads()>1) {
+    nrm = 0.;
+#pragma omp parallel num_threads(omp_->num_threads()) reduction(+:nrm)
+    {
+      int beg, len;
+      omp_thread_range(n_local_, beg, len);
+      const double nrm_chunk = len>0 ? DNRM2(&len, data_+beg, &one) : 0.;
+      nrm += nrm_chunk*nrm_chunk;
+    }
+    nrm = sqrt(nrm);
+  } else
+#endif
+  nrm = DNRM2(&n,data_,&one); 
 
 #ifdef HIOP_USE_MPI
   nrm *= nrm;
@@ -251,7 +294,19 @@ double hiopVectorPar::dotProductWith( const hiopVector& v_ ) const
   int one=1; int n=n_local_;
   assert(this->n_local_==v.n_local_);
 
-  double dotprod=DDOT(&n, this->data_, &one, v.data_, &one);
+  double dotprod;
+#ifdef HIOP_USE_OPENMP
+  if(n_local_>=omp_->serial_threshold() && omp_->num_threads()>1) {
+    dotprod = 0.;
+#pragma omp parallel num_threads(omp_->num_threads()) reduction(+:dotprod)
+    {
+      int beg, len;
+      omp_thread_range(n_local_, beg, len);
+      if(len>0) dotprod += DDOT(&len, this->data_+beg, &one, v.data_+beg, &one);
+    }
+  } else
+#endif
+  dotprod=DDOT(&n, this->data_, &one, v.data_, &one);
 
 #ifdef HIOP_USE_MPI
   double dotprodG;
@@ -264,17 +319,7 @@ double hiopVectorPar::dotProductWith( const hiopVector& v_ ) const
 
 double hiopVectorPar::infnorm() const
 {
-  assert(n_local_>=0);
-  double nrm=0.;
-  if(n_local_!=0) {
-    nrm=fabs(data_[0]);
-    double aux;
-  
-    for(int i=1; i<n_local_; i++) {
-      aux=fabs(data_[i]);
-      if(aux>nrm) nrm=aux;
-    }
-  }
+  double nrm = infnorm_local();
 #ifdef HIOP_USE_MPI
   double nrm_glob;
   int ierr = MPI_Allreduce(&nrm, &nrm_glob, 1, MPI_DOUBLE, MPI_MAX, comm_); assert(MPI_SUCCESS==ierr);
@@ -290,10 +335,10 @@ double hiopVectorPar::infnorm_local() const
   double nrm=0.;
   if(n_local_>0) {
     nrm = fabs(data_[0]); 
-    double aux;
     
+    HIOP_OMP_FOR_REDUCTION(n_local_, omp_, max, nrm)
     for(int i=1; i<n_local_; i++) {
-      aux=fabs(data_[i]);
+      const double aux=fabs(data_[i]);
       if(aux>nrm) nrm=aux;
     }
   }
@@ -303,7 +348,7 @@ double hiopVectorPar::infnorm_local() const
 
 double hiopVectorPar::onenorm() const
 {
-  double nrm1=0.; for(int i=0; i<n_local_; i++) nrm1 += fabs(data_[i]);
+  double nrm1 = onenorm_local();
 #ifdef HIOP_USE_MPI
   double nrm1_global;
   int ierr = MPI_Allreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, comm_); assert(MPI_SUCCESS==ierr);
@@ -314,7 +359,9 @@ double hiopVectorPar::onenorm() const
 
 double hiopVectorPar::onenorm_local() const
 {
-  double nrm1=0.; for(int i=0; i<n_local_; i++) nrm1 += fabs(data_[i]);
+  double nrm1=0.;
+  HIOP_OMP_FOR_REDUCTION(n_local_, omp_, +, nrm1)
+  for(int i=0; i<n_local_; i++) nrm1 += fabs(data_[i]);
   return nrm1;
 }
 
@@ -322,6 +369,7 @@ void hiopVectorPar::componentMult( const hiopVector& v_ )
 {
   const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
   assert(n_local_==v.n_local_);
+  HIOP_OMP_FOR(n_local_, omp_)
   for(int i=0; i<n_local_; ++i)
     data_[i] *= v.data_[i];
 }
@@ -330,6 +378,7 @@ void hiopVectorPar::componentDiv ( const hiopVector& v_ )
 {
   const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
   assert(n_local_==v.n_local_);
+  HIOP_OMP_FOR(n_local_, omp_)
   for(int i=0; i<n_local_; i++) data_[i] /= v.data_[i];
 }
 
@@ -342,6 +391,7 @@ void hiopVectorPar::componentDiv_w_selectPattern( const hiopVector& v_, const hi
   assert(n_local_==ix.n_local_);
 #endif
   double *s=this->data_, *x=v.data_, *pattern=ix.data_; 
+  HIOP_OMP_FOR(n_local_, omp_)
   for(int i=0; i<n_local_; i++)
     if(pattern[i]==0.0) s[i]=0.0;
     else                s[i]/=x[i];
@@ -358,6 +408,17 @@ void hiopVectorPar::axpy(double alpha, const hiopVector& x_)
 {
   const hiopVectorPar& x = dynamic_cast<const hiopVectorPar&>(x_);
   int one = 1; int n=n_local_;
+#ifdef HIOP_USE_OPENMP
+  if(n_local_>=omp_->serial_threshold() && omp_->num_threads()>1) {
+#pragma omp parallel num_threads(omp_->num_threads())
+    {
+      int beg, len;
+      omp_thread_range(n_local_, beg, len);
+      if(len>0) DAXPY( &len, &alpha, x.data_+beg, &one, data_+beg, &one );
+    }
+    return;
+  }
+#endif
   DAXPY( &n, &alpha, x.data_, &one, data_, &one );
 }
 
@@ -373,14 +434,17 @@ void hiopVectorPar::axzpy(double alpha, const hiopVector& x_, const hiopVector&
   const double *x = vx.local_data_const(), *z=vz.local_data_const();
 
   if(alpha==1.0) { 
+    HIOP_OMP_FOR(n_local_, omp_)
     for(int i=0; i<n_local_; ++i) {
       data_[i] += x[i]*z[i];
     }
   } else if(alpha==-1.0) { 
+    HIOP_OMP_FOR(n_local_, omp_)
     for(int i=0; i<n_local_; ++i) {
       data_[i] -= x[i]*z[i];
     }   
   } else if(alpha!=0.) { // alpha is not 1.0 nor -1.0 nor 0.0
+    HIOP_OMP_FOR(n_local_, omp_)
     for(int i=0; i<n_local_; ++i) {
       data_[i] += alpha*x[i]*z[i];
     } 
@@ -401,17 +465,20 @@ void hiopVectorPar::axdzpy( double alpha, const hiopVector& x_, const hiopVector
 
   if(alpha == 1.0) {
 
+    HIOP_OMP_FOR(n_local_, omp_)
     for(int i=0; i<n_local_; ++i) {
       data_[i] += x[i] / z[i];
     }
 
   } else if(alpha==-1.0) { 
 
+    HIOP_OMP_FOR(n_local_, omp_)
     for(int i=0; i<n_local_; ++i) {
       data_[i] -= x[i] / z[i];
     }
 
   } else { // alpha is neither 1.0 nor -1.0
+    HIOP_OMP_FOR(n_local_, omp_)
     for(int i=0; i<n_local_; ++i) {
       data_[i] += x[i] / z[i] * alpha;
     }
@@ -430,22 +497,26 @@ void hiopVectorPar::axdzpy_w_pattern( double alpha, const hiopVector& x_, const
   // this += alpha * x / z   (y+=alpha*x/z)
   double*y = data_;
   const double *x = vx.local_data_const(), *z=vz.local_data_const(), *s=sel.local_data_const();
-  int it;
   if(alpha==1.0) {
-    for(it=0;it<n_local_;it++)
+    HIOP_OMP_FOR(n_local_, omp_)
+    for(int it=0;it<n_local_;it++)
       if(s[it]==1.0) y[it] += x[it]/z[it];
   } else 
     if(alpha==-1.0) {
-      for(it=0; it<n_local_;it++)
+      HIOP_OMP_FOR(n_local_, omp_)
+      for(int it=0; it<n_local_;it++)
 	if(s[it]==1.0) y[it] -= x[it]/z[it];
-    } else
-      for(it=0; it<n_local_; it++)
+    } else {
+      HIOP_OMP_FOR(n_local_, omp_)
+      for(int it=0; it<n_local_; it++)
 	if(s[it]==1.0) y[it] += alpha*x[it]/z[it];
+    }
 }
 
 
 void hiopVectorPar::addConstant( double c )
 {
+  HIOP_OMP_FOR(n_local_, omp_)
   for(long long i=0; i<n_local_; i++) data_[i]+=c;
 }
 
@@ -454,6 +525,7 @@ void  hiopVectorPar::addConstant_w_patternSelect(double c, const hiopVector& ix_
   const hiopVectorPar& ix = dynamic_cast<const hiopVectorPar&>(ix_);
   assert(this->n_local_ == ix.n_local_);
   const double* ix_vec = ix.data_;
+  HIOP_OMP_FOR(n_local_, omp_)
   for(int i=0; i<n_local_; i++) if(ix_vec[i]==1.) data_[i]+=c;
 }
 
@@ -470,6 +542,7 @@ void hiopVectorPar::negate()
 
 void hiopVectorPar::invert()
 {
+  HIOP_OMP_FOR(n_local_, omp_)
   for(int i=0; i<n_local_; i++) {
 #ifdef HIOP_DEEPCHECKS
     if(fabs(data_[i])<1e-35) assert(false);
@@ -478,23 +551,34 @@ void hiopVectorPar::invert()
   }
 }
 
-// uses Kahan's summation algorithm to reduce numerical error
+// uses Kahan's summation algorithm to reduce numerical error; when threaded, each thread 
+// uses Kahan's summation on its chunk and the partial sums are added
 double hiopVectorPar::logBarrier_local(const hiopVector& select) const 
 {
   double sum = 0.0;
-  double comp = 0.0;
   const hiopVectorPar& ix = dynamic_cast<const hiopVectorPar&>(select);
   assert(this->n_local_ == ix.n_local_);
   const double* ix_vec = ix.data_;
-  for(int i=0; i<n_local_; i++)
+#ifdef HIOP_USE_OPENMP
+#pragma omp parallel num_threads(omp_->num_threads()) if(n_local_>=omp_->serial_threshold()) reduction(+:sum)
+#endif
   {
-    if(ix_vec[i]==1.)
+    double sum_thread = 0.0;
+    double comp = 0.0;
+#ifdef HIOP_USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for(int i=0; i<n_local_; i++)
     {
-      double y = log(data_[i]) - comp;
-      double t = sum + y;
-      comp = (t - sum) - y;
-      sum = t;
+      if(ix_vec[i]==1.)
+      {
+	double y = log(data_[i]) - comp;
+	double t = sum_thread + y;
+	comp = (t - sum_thread) - y;
+	sum_thread = t;
+      }
     }
+    sum += sum_thread;
   }
   return sum;
 }
@@ -509,6 +593,7 @@ void hiopVectorPar::addLogBarrierGrad(double alpha, const hiopVector& x, const h
   const double* ix_vec = dynamic_cast<const hiopVectorPar&>(ix).data_;
   const double*  x_vec = dynamic_cast<const hiopVectorPar&>( x).data_;
 
+  HIOP_OMP_FOR(n_local_, omp_)
   for(int i=0; i<n_local_; i++) 
     if(ix_vec[i]==1.) 
       data_[i] += alpha/x_vec[i];
@@ -526,6 +611,7 @@ linearDampingTerm_local(const hiopVector& ixleft, const hiopVector& ixright,
   assert(n_local_==(dynamic_cast<const hiopVectorPar&>(ixright) ).n_local_);
 #endif
   double term=0.0;
+  HIOP_OMP_FOR_REDUCTION(n_local_, omp_, +, term)
   for(long long i=0; i<n_local_; i++) {
     if(ixl[i]==1. && ixr[i]==0.) term += data_[i];
   }
@@ -607,15 +693,16 @@ double hiopVectorPar::fractionToTheBdry_local(const hiopVector& dx, const double
   assert(tau>0);
   assert(tau<1);
 #endif
-  double alpha=1.0, aux;
+  double alpha=1.0;
   const double* d = (dynamic_cast<const hiopVectorPar&>(dx) ).local_data_const();
   const double* x = data_;
+  HIOP_OMP_FOR_REDUCTION(n_local_, omp_, min, alpha)
   for(int i=0; i<n_local_; i++) {
 #ifdef HIOP_DEEPCHECKS
     assert(x[i]>0);
 #endif
     if(d[i]>=0) continue;
-    aux = -tau*x[i]/d[i];
+    const double aux = -tau*x[i]/d[i];
     if(aux<alpha) alpha=aux;
   }
   return alpha;
@@ -630,17 +717,18 @@ fractionToTheBdry_w_pattern_local(const hiopVector& dx, const double& tau, const
   assert(tau>0);
   assert(tau<1);
 #endif
-  double alpha=1.0, aux;
+  double alpha=1.0;
   const double* d = (dynamic_cast<const hiopVectorPar&>(dx) ).local_data_const();
   const double* x = data_;
   const double* pat = (dynamic_cast<const hiopVectorPar&>(ix) ).local_data_const();
+  HIOP_OMP_FOR_REDUCTION(n_local_, omp_, min, alpha)
   for(int i=0; i<n_local_; i++) {
     if(d[i]>=0) continue;
     if(pat[i]==0) continue;
 #ifdef HIOP_DEEPCHECKS
     assert(x[i]>0);
 #endif
-    aux = -tau*x[i]/d[i];
+    const double aux = -tau*x[i]/d[i];
     if(aux<alpha) alpha=aux;
   }
   return alpha;
@@ -653,6 +741,7 @@ void hiopVectorPar::selectPattern(const hiopVector& ix_)
 #endif
   const double* ix = (dynamic_cast<const hiopVectorPar&>(ix_) ).local_data_const();
   double* x=data_;
+  HIOP_OMP_FOR(n_local_, omp_)
   for(int i=0; i<n_local_; i++) if(ix[i]==0.0) x[i]=0.0;
 }
 
@@ -703,20 +792,19 @@ void hiopVectorPar::adjustDuals_plh(const hiopVector& x_, const hiopVector& ix_,
   const double* x  = (dynamic_cast<const hiopVectorPar&>(x_ )).local_data_const();
   const double* ix = (dynamic_cast<const hiopVectorPar&>(ix_)).local_data_const();
   double* z=data_; //the dual
-  double a,b;
+  HIOP_OMP_FOR(n_local_, omp_)
   for(long long i=0; i<n_local_; i++) {
     if(ix[i]==1.) {
-      a=mu/x[i]; b=a/kappa; a=a*kappa;
-      if(*z<b) 
-	*z=b;
+      double a=mu/x[i], b=a/kappa; a=a*kappa;
+      if(z[i]<b) 
+	z[i]=b;
       else //z[i]>=b
 	if(a<=b) 
-	  *z=b;
+	  z[i]=b;
 	else //a>b
-	  if(a<*z) *z=a;
-          //else a>=z[i] then *z=*z (z[i] does not need adjustment)
+	  if(a<z[i]) z[i]=a;
+          //else a>=z[i] then z[i]=z[i] (z[i] does not need adjustment)
     }
-    z++;
   }
 }
 
@@ -50,6 +50,7 @@
 
 #include <hiopMPI.hpp>
 #include "hiopVector.hpp"
+#include "hiopOmp.hpp"
 
 #include <cstdio>
 
@@ -141,6 +142,9 @@ public:
 
   virtual hiopVector* alloc_clone() const;
   virtual hiopVector* new_copy () const;
+  /// @brief non-owning vector with the same sizes and distribution as 'this' over 'data', which
+  /// should hold at least get_local_size() entries and outlive the returned vector
+  virtual hiopVectorPar* new_view(double* data) const;
 
   virtual void adjustDuals_plh(const hiopVector& x,
 			       const hiopVector& ix,
@@ -159,11 +163,23 @@ public:
   virtual const double* local_data_const() const { return data_; }
   virtual MPI_Comm get_mpi_comm() const { return comm_; }
 
+  /**
+   * @brief Sets the threading parameters of the kernels (the number of OpenMP threads and the local 
+   * length below which the kernels are executed serially); 'params' should outlive 'this' and is 
+   * passed on to the clones. Has no effect unless HiOp is built with HIOP_USE_OPENMP.
+   */
+  virtual void set_omp_params(const hiopOmpParams* params) { omp_ = params; }
+  const hiopOmpParams* get_omp_params() const { return omp_; }
 protected:
   MPI_Comm comm_;
   double* data_;
   long long glob_il_, glob_iu_;
   long long n_local_;
+  //false for the vectors returned by 'new_view'
+  bool owns_data_;
+
+  //not owned, by default hiopOmpParams::defaults()
+  const hiopOmpParams* omp_;
 private:
   /// @brief copy constructor, for internal/private use only (it doesn't copy the elements.)
   hiopVectorPar(const hiopVectorPar&);
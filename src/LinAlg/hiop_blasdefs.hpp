@@ -14,6 +14,7 @@
 #define ZGEMV   FC_GLOBAL(zgemv, ZGEMV)
 #define DGEMM   FC_GLOBAL(dgemm, DGEMM)
 #define DTRSM   FC_GLOBAL(dtrsm, DTRSM)
+#define DSYRK   FC_GLOBAL(dsyrk, DSYRK)
 #define DPOTRF  FC_GLOBAL(dpotrf, DPOTRF)
 #define DPOTRS  FC_GLOBAL(dpotrs, DPOTRS)
 #define DSYTRF  FC_GLOBAL(dsytrf, DSYTRF)
@@ -71,6 +72,14 @@ extern "C" void   DTRSM(char* side, char* uplo, char* transA, char* diag,
 			 const double* a, int* lda,
 			 double* b, int* ldb);
 
+/* C := alpha*A*A**T + beta*C  (trans='N')  or  C := alpha*A**T*A + beta*C  (trans='T'),
+ * where C is an n by n symmetric matrix of which only the 'uplo' triangle is referenced and
+ * A is an n by k matrix (trans='N') or a k by n matrix (trans='T').
+ */
+extern "C" void   DSYRK(char* uplo, char* trans, int* n, int* k,
+			 double* alpha, double* a, int* lda,
+			 double* beta, double* c, int* ldc);
+
 /* Cholesky factorization of a real symmetric positive definite matrix A.
  * The factorization has the form
  *   A = U**T * U,  if UPLO = 'U', or  A = L  * L**T,  if UPLO = 'L',
@@ -50,12 +50,15 @@
 #include "hiopKKTLinSys.hpp"
 #include "hiopKKTLinSysDense.hpp"
 #include "hiopKKTLinSysMDS.hpp"
+#include "hiopVectorPar.hpp"
+#include "hiopLinAlgFactory.hpp"
 
 #include "hiopCppStdUtils.hpp"
 
 #include <cmath>
 #include <cstring>
 #include <cassert>
+#include <memory>
 
 namespace hiop
 {
@@ -70,6 +73,7 @@ hiopAlgFilterIPMBase::hiopAlgFilterIPMBase(hiopNlpFormulation* nlp_)
   it_curr = new hiopIterate(nlp);
   it_trial= it_curr->alloc_clone();
   dir     = it_curr->alloc_clone();
+  dir_soc = it_curr->alloc_clone();
   
   logbar = new hiopLogBarProblem(nlp);
   
@@ -78,21 +82,20 @@ hiopAlgFilterIPMBase::hiopAlgFilterIPMBase(hiopNlpFormulation* nlp_)
   _d = nlp->alloc_dual_ineq_vec();
   
   _grad_f  = nlp->alloc_primal_vec();
-  _Jac_c   = nlp->alloc_Jac_c();
-  _Jac_d   = nlp->alloc_Jac_d();
+  nlp->alloc_Jac_c_d(_Jac_c, _Jac_d);
   
   _f_nlp_trial = _f_log_trial = 0;
   _c_trial = nlp->alloc_dual_eq_vec(); 
   _d_trial = nlp->alloc_dual_ineq_vec();
   
   _grad_f_trial  = nlp->alloc_primal_vec();
-  _Jac_c_trial   = nlp->alloc_Jac_c();
-  _Jac_d_trial   = nlp->alloc_Jac_d();
+  nlp->alloc_Jac_c_d(_Jac_c_trial, _Jac_d_trial);
   
   _Hess_Lagr = nlp->alloc_Hess_Lagr();
   
   resid = new hiopResidual(nlp);
   resid_trial = new hiopResidual(nlp);
+  resid_soc = new hiopResidual(nlp);
 
   //parameter based initialization
   if(dualsUpdateType==0) {
@@ -110,12 +113,13 @@ void hiopAlgFilterIPMBase::destructorPart()
   if(it_curr)  delete it_curr;
   if(it_trial) delete it_trial;
   if(dir)      delete dir;
+  if(dir_soc)  delete dir_soc;
 
   if(_c)       delete _c;
   if(_d)       delete _d;
   if(_grad_f)  delete _grad_f;
-  if(_Jac_c)   delete _Jac_c;
   if(_Jac_d)   delete _Jac_d;
+  if(_Jac_c)   delete _Jac_c;
 
   if(_Hess_Lagr) delete _Hess_Lagr;
 
@@ -124,10 +128,11 @@ void hiopAlgFilterIPMBase::destructorPart()
   if(_c_trial)       delete _c_trial;
   if(_d_trial)       delete _d_trial;
   if(_grad_f_trial)  delete _grad_f_trial;
-  if(_Jac_c_trial)   delete _Jac_c_trial;
   if(_Jac_d_trial)   delete _Jac_d_trial;
+  if(_Jac_c_trial)   delete _Jac_c_trial;
 
   if(resid_trial)    delete resid_trial;
+  if(resid_soc)      delete resid_soc;
 
   if(logbar) delete logbar;
 
@@ -138,12 +143,13 @@ hiopAlgFilterIPMBase::~hiopAlgFilterIPMBase()
   if(it_curr)  delete it_curr;
   if(it_trial) delete it_trial;
   if(dir)      delete dir;
+  if(dir_soc)  delete dir_soc;
 
   if(_c)       delete _c;
   if(_d)       delete _d;
   if(_grad_f)  delete _grad_f;
-  if(_Jac_c)   delete _Jac_c;
   if(_Jac_d)   delete _Jac_d;
+  if(_Jac_c)   delete _Jac_c;
 
   if(_Hess_Lagr) delete _Hess_Lagr;
 
@@ -152,10 +158,11 @@ hiopAlgFilterIPMBase::~hiopAlgFilterIPMBase()
   if(_c_trial)       delete _c_trial;
   if(_d_trial)       delete _d_trial;
   if(_grad_f_trial)  delete _grad_f_trial;
-  if(_Jac_c_trial)   delete _Jac_c_trial;
   if(_Jac_d_trial)   delete _Jac_d_trial;
+  if(_Jac_c_trial)   delete _Jac_c_trial;
 
   if(resid_trial)    delete resid_trial;
+  if(resid_soc)      delete resid_soc;
 
   if(logbar) delete logbar;
 
@@ -169,6 +176,7 @@ void hiopAlgFilterIPMBase::reInitializeNlpObjects()
   it_curr = new hiopIterate(nlp);
   it_trial= it_curr->alloc_clone();
   dir     = it_curr->alloc_clone();
+  dir_soc = it_curr->alloc_clone();
   
   logbar = new hiopLogBarProblem(nlp);
   
@@ -177,21 +185,20 @@ void hiopAlgFilterIPMBase::reInitializeNlpObjects()
   _d = nlp->alloc_dual_ineq_vec();
   
   _grad_f  = nlp->alloc_primal_vec();
-  _Jac_c   = nlp->alloc_Jac_c();
-  _Jac_d   = nlp->alloc_Jac_d();
+  nlp->alloc_Jac_c_d(_Jac_c, _Jac_d);
   
   _f_nlp_trial = _f_log_trial = 0;
   _c_trial = nlp->alloc_dual_eq_vec(); 
   _d_trial = nlp->alloc_dual_ineq_vec();
   
   _grad_f_trial  = nlp->alloc_primal_vec();
-  _Jac_c_trial   = nlp->alloc_Jac_c();
-  _Jac_d_trial   = nlp->alloc_Jac_d();
+  nlp->alloc_Jac_c_d(_Jac_c_trial, _Jac_d_trial);
   
   _Hess_Lagr = nlp->alloc_Hess_Lagr();
   
   resid = new hiopResidual(nlp);
   resid_trial = new hiopResidual(nlp);
+  resid_soc = new hiopResidual(nlp);
 
   //0 LSQ (default), 1 linear update (more stable)
   dualsUpdateType = nlp->options->GetString("dualsUpdateType")=="lsq"?0:1;
@@ -230,6 +237,9 @@ void hiopAlgFilterIPMBase::reloadOptions()
 
   kappa1   = nlp->options->GetNumeric("kappa1");          //projection params for starting point (default 1e-2)
   kappa2   = nlp->options->GetNumeric("kappa2");
+  warm_start_ = "yes"==nlp->options->GetString("warm_start");
+  warm_start_bound_push_ = nlp->options->GetNumeric("warm_start_bound_push");
+  warm_start_mult_bound_push_ = nlp->options->GetNumeric("warm_start_mult_bound_push");
   p_smax   = nlp->options->GetNumeric("smax");            //threshold for the magnitude of the multipliers
 
   max_n_it  = nlp->options->GetInteger("max_iter"); 
@@ -261,12 +271,19 @@ void hiopAlgFilterIPMBase::reloadOptions()
   delta=1.;           // the WachterBiegler paper
   // parameter in the Armijo rule
   eta_phi=nlp->options->GetNumeric("eta_phi");     
+  //second-order corrections in the line search (Newton only)
+  max_soc_iter = nlp->options->GetInteger("max_soc_iter");
+  kappa_soc = nlp->options->GetNumeric("kappa_soc");
   kappa_Sigma = 1e10; //parameter in resetting the duals to guarantee closedness of the primal-dual logbar Hessian to the primal logbar Hessian
   _tau=fmax(tau_min,1.0-_mu);
   theta_max = 1e7; //temporary - will be updated after ini pt is computed
   theta_min = 1e7; //temporary - will be updated after ini pt is computed
 
   perf_report_kkt_ = "on"==hiop::tolower(nlp->options->GetString("time_kkt"));
+
+  //threading of the kernels of the NLP's vectors and matrices (only when built with HIOP_USE_OPENMP)
+  nlp->set_omp_params(nlp->options->GetInteger("num_threads"),
+		      nlp->options->GetInteger("omp_serial_threshold"));
 }
 
 void hiopAlgFilterIPMBase::resetSolverStatus() 
@@ -292,11 +309,22 @@ startingProcedure(hiopIterate& it_ini,
     //in case user wrongly set this to true when he/she returned false
     duals_avail = false;
   }
+
+  if(warm_start_ && !duals_avail) {
+    nlp->log->printf(hovWarning, "warm_start is on, but the user did not provide the duals; only "
+		     "the primal starting point will be used\n");
+  }
+  //with a warm start, the starting point is only pushed slightly inside the bounds since it is
+  //expected to be a (close to) optimal solution of a previous, nearby problem; without the duals,
+  //the duals are initialized as in a cold start, which needs the usual push
+  const bool warm_start_ini = warm_start_ && duals_avail;
+  const double kappa1_ini = warm_start_ini ? warm_start_bound_push_ : kappa1;
+  const double kappa2_ini = warm_start_ini ? warm_start_bound_push_ : kappa2;
   
   nlp->runStats.tmSolverInternal.start();
   nlp->runStats.tmStartingPoint.start();
 
-  it_ini.projectPrimalsXIntoBounds(kappa1, kappa2);
+  it_ini.projectPrimalsXIntoBounds(kappa1_ini, kappa2_ini);
 
   nlp->runStats.tmStartingPoint.stop();
   nlp->runStats.tmSolverInternal.stop();
@@ -325,7 +353,7 @@ startingProcedure(hiopIterate& it_ini,
 
   it_ini.get_d()->copyFrom(d);
 
-  it_ini.projectPrimalsDIntoBounds(kappa1, kappa2);
+  it_ini.projectPrimalsDIntoBounds(kappa1_ini, kappa2_ini);
 
   it_ini.determineSlacks();
 
@@ -334,6 +362,9 @@ startingProcedure(hiopIterate& it_ini,
     it_ini.setBoundsDualsToConstant(1.);
   } else {
     // zl and zu were provided by the user
+    if(warm_start_) {
+      it_ini.pushBoundsDualsAwayFromZero(warm_start_mult_bound_push_);
+    }
 
     // compute vl and vu from vl = mu e ./ sdl and vu = mu e ./ sdu
     // sdl and sdu were initialized above in 'determineSlacks'
@@ -500,7 +531,11 @@ bool hiopAlgFilterIPMBase::
 updateLogBarrierParameters(const hiopIterate& it, const double& mu_curr, const double& tau_curr,
 			   double& mu_new, double& tau_new)
 {
-  double new_mu = fmax(eps_tol/10, fmin(kappa_mu*mu_curr, pow(mu_curr,theta_mu)));
+  //the complementarity of the user's problem is the one of the scaled problem divided by the 
+  //scaling factor of the objective, and so is the smallest barrier parameter
+  const hiopNLPObjGradScaling* scaling = nlp->get_nlp_scaling();
+  const double mu_min = scaling ? eps_tol/10*scaling->get_obj_scale() : eps_tol/10;
+  double new_mu = fmax(mu_min, fmin(kappa_mu*mu_curr, pow(mu_curr,theta_mu)));
   if(fabs(new_mu-mu_curr)<1e-16) return false;
   mu_new  = new_mu;
   tau_new = fmax(tau_min,1.0-mu_new);
@@ -524,11 +559,20 @@ evalNlpAndLogErrors(const hiopIterate& it, const hiopResidual& resid, const doub
   nlp->runStats.tmSolverInternal.start();
 
   long long n=nlp->n_complem(), m=nlp->m();
-  //the one norms
+  //the one norms of the duals of 'it' (computed by 'resid.update' to save on communication
+  //when 'resid' was updated with 'it')
   //double nrmDualBou=it.normOneOfBoundDuals();
   //double nrmDualEqu=it.normOneOfEqualityDuals();
   double nrmDualBou, nrmDualEqu;
-  it.normOneOfDuals(nrmDualEqu, nrmDualBou);
+  resid.getDualsNormOne(it, nrmDualEqu, nrmDualBou);
+#ifdef HIOP_DEEPCHECKS
+  {
+    double nrmDualBou2, nrmDualEqu2;
+    it.normOneOfDuals(nrmDualEqu2, nrmDualBou2);
+    assert(fabs(nrmDualBou-nrmDualBou2)<=1e-12*fmax(1., nrmDualBou2) && 
+	   fabs(nrmDualEqu-nrmDualEqu2)<=1e-12*fmax(1., nrmDualEqu2) && "duals of 'it' changed after 'resid.update'");
+  }
+#endif
 
   nlp->log->printf(hovScalars, "nrmOneDualEqu %g   nrmOneDualBo %g\n", nrmDualEqu, nrmDualBou);
   if(nrmDualBou>1e+10) {
@@ -564,6 +608,15 @@ evalNlpAndLogErrors(const hiopIterate& it, const hiopResidual& resid, const doub
   //finally, the scaled nlp error
   nlpoverall = fmax(nlpoptim/sd, fmax(nlpfeas, nlpcomplem/sc));
 
+  //the nlp errors of the user's problem, different from the above when the problem is scaled
+  resid.getUnscaledNlpErrors(_err_nlp_optim_user, _err_nlp_feas_user, _err_nlp_complem_user);
+  _err_nlp_user = fmax(_err_nlp_optim_user/sd, fmax(_err_nlp_feas_user, _err_nlp_complem_user/sc));
+  if(nlp->get_nlp_scaling()) {
+    nlp->log->printf(hovScalars, 
+		     "user's problem: nlpoverall %g  nloptim %g  nlpfeas %g  nlpcomplem %g\n", 
+		     _err_nlp_user, _err_nlp_optim_user, _err_nlp_feas_user, _err_nlp_complem_user);
+  }
+
   nlp->log->printf(hovScalars, 
 		   "nlpoverall %g  nloptim %g  sd %g  nlpfeas %g  nlpcomplem %g  sc %g\n", 
 		   nlpoverall, nlpoptim, sd, nlpfeas, nlpcomplem, sc);
@@ -607,23 +660,15 @@ bool hiopAlgFilterIPMBase::evalNlp_derivOnly(hiopIterate& iter,
   hiopVectorPar& it_x = dynamic_cast<hiopVectorPar&>(*iter.get_x());
   hiopVectorPar & gradf=dynamic_cast<hiopVectorPar&>(gradf_);
   double* x = it_x.local_data();
-  if(!nlp->eval_grad_f(x, new_x, gradf.local_data())) {
-    nlp->log->printf(hovError, "Error occured in user gradient evaluation\n");
-    return false;
-  }
-  if(!nlp->eval_Jac_c_d(x, new_x, Jac_c, Jac_d)) {
-    nlp->log->printf(hovError, "Error occured in user Jacobian function evaluation\n");
-    return false; 
-  }
-
 
   const hiopVectorPar* yc = dynamic_cast<const hiopVectorPar*>(iter.get_yc()); assert(yc);
   const hiopVectorPar* yd = dynamic_cast<const hiopVectorPar*>(iter.get_yd()); assert(yd);
   const int new_lambda = true;
-  if(!nlp->eval_Hess_Lagr(x, new_x, 
-			  1., yc->local_data_const(), yd->local_data_const(), new_lambda,
-			  Hess_L)) {
-    nlp->log->printf(hovError, "Error occured in user Hessian function evaluation\n");
+  //gradient, Jacobian, and Hessian are evaluated in one user call when the user supports it
+  if(!nlp->eval_derivs(x, new_x, gradf.local_data(), Jac_c, Jac_d,
+		       1., yc->local_data_const(), yd->local_data_const(), new_lambda,
+		       Hess_L)) {
+    nlp->log->printf(hovError, "Error occured in user derivatives (gradient, Jacobian, or Hessian) evaluation\n");
     return false;
   }
   return true;
@@ -691,7 +736,9 @@ int hiopAlgFilterIPMBase::getNumIterations() const
 bool hiopAlgFilterIPMBase::
 checkTermination(const double& err_nlp, const int& iter_num, hiopSolveStatus& status)
 {
-  if(err_nlp<=eps_tol)   { solver_status_ = Solve_Success;     return true; }
+  //when the problem is scaled, the error of the user's problem, which can be larger by up to a 
+  //factor of 1/obj_scale, needs to be within the tolerance as well
+  if(err_nlp<=eps_tol && _err_nlp_user<=eps_tol) { solver_status_ = Solve_Success; return true; }
   if(iter_num>=max_n_it) { solver_status_ = Max_Iter_Exceeded; return true; }
 
   if(eps_rtol>0) {
@@ -703,7 +750,7 @@ checkTermination(const double& err_nlp, const int& iter_num, hiopSolveStatus& st
     }
   }
 
-  if(err_nlp<=eps_tol_accep) n_accep_iters_++;
+  if(err_nlp<=eps_tol_accep && _err_nlp_user<=eps_tol_accep) n_accep_iters_++;
   else n_accep_iters_ = 0;
 
   if(n_accep_iters_>=accep_n_it) { solver_status_ = Solve_Acceptable_Level; return true; }
@@ -820,9 +867,13 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
 #endif  
   nlp->log->write("---------------\nProblem Summary\n---------------", *nlp, hovSummary);
 
+  //the profile of the regions of the run is written when 'prof_session' is destroyed
+  hiopProfSession prof_session(nlp->prof, nlp->options->GetString("profile"), nlp->get_comm(), nlp->log);
   nlp->runStats.tmOptimizTotal.start();
 
+  hiopProfRegion prof_start(nlp->prof, "startingPoint");
   startingProcedure(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d); //this also evaluates the nlp
+  prof_start.stop();
   _mu=mu0;
 
   //update log bar
@@ -838,11 +889,13 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   theta_max=1e+4*fmax(1.0,resid->getInfeasInfNorm());
   theta_min=1e-4*fmax(1.0,resid->getInfeasInfNorm());
   
-  hiopKKTLinSysLowRank* kkt=new hiopKKTLinSysLowRank(nlp);
+  //released on all the returns, so that the linear solver gives its workspace back to the nlp
+  std::unique_ptr<hiopKKTLinSysLowRank> kkt(new hiopKKTLinSysLowRank(nlp));
 
   _alpha_primal = _alpha_dual = 0;
 
   _err_nlp_optim0=-1.; _err_nlp_feas0=-1.; _err_nlp_complem0=-1;
+  _err_nlp_optim_user=_err_nlp_feas_user=_err_nlp_complem_user=_err_nlp_user=-1.;
 
   // --- Algorithm status 'algStatus ----
   //-1 couldn't solve the problem (most likely because small search step. Restauration phase likely needed)
@@ -935,15 +988,18 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
      * Search direction calculation
      ***************************************************/
     //first update the Hessian and kkt system
+    hiopProfRegion prof_dir(nlp->prof, "searchDir");
     Hess->update(*it_curr,*_grad_f,*_Jac_c,*_Jac_d);
     kkt->update(it_curr, _grad_f, Jac_c, Jac_d, Hess);
     bret = kkt->computeDirections(resid,dir); assert(bret==true);
+    prof_dir.stop();
 
     nlp->log->printf(hovIteration, "Iter[%d] full search direction -------------\n", iter_num);
     nlp->log->write("", *dir, hovIteration);
     /***************************************************************
      * backtracking line search
      ****************************************************************/
+    hiopProfRegion prof_ls(nlp->prof, "lineSearch");
     nlp->runStats.tmSolverInternal.start();
 
     //maximum  step
@@ -1076,6 +1132,7 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
       } //end of else: theta_trial<theta_min
     } //end of while for the linesearch loop
     nlp->runStats.tmSolverInternal.stop();
+    prof_ls.stop();
 
     //post line-search stuff  
     //filter is augmented whenever the switching condition or Armijo rule do not hold for the trial point that was just accepted
@@ -1126,9 +1183,11 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
     //it_trial->takeStep_duals(*it_curr, *dir, _alpha_primal, _alpha_dual); assert(bret);
     //bret = it_trial->adjustDuals_primalLogHessian(_mu,kappa_Sigma); assert(bret);
     assert(infeas_nrm_trial>=0 && "this should not happen");
+    hiopProfRegion prof_duals(nlp->prof, "dualsUpdate");
     bret = dualsUpdate->go(*it_curr, *it_trial, 
 			   _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *dir,  
 			   _alpha_primal, _alpha_dual, _mu, kappa_Sigma, infeas_nrm_trial); assert(bret);
+    prof_duals.stop();
 
     //update current iterate (do a fast swap of the pointers)
     hiopIterate* pit=it_curr; it_curr=it_trial; it_trial=pit;
@@ -1157,8 +1216,6 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
 			      *_c,*_d, 
 			      *it_curr->get_yc(),  *it_curr->get_yd(),
 			      _f_nlp);
-  delete kkt;
-
   return solver_status_;
 }
 
@@ -1169,7 +1226,7 @@ void hiopAlgFilterIPMQuasiNewton::outputIteration(int lsStatus, int lsNum)
 
   if(lsStatus==-1) 
     nlp->log->printf(hovSummary, "%4d %14.7e %7.3e  %7.3e %6.2f  %7.3e  %7.3e  -(-)\n",
-		     iter_num, _f_nlp, _err_nlp_feas, _err_nlp_optim, log10(_mu), _alpha_dual, _alpha_primal); 
+		     iter_num, nlp->user_obj(_f_nlp), _err_nlp_feas_user, _err_nlp_optim_user, log10(_mu), _alpha_dual, _alpha_primal); 
   else {
     char stepType[2];
     if(lsStatus==1) strcpy(stepType, "s");
@@ -1177,7 +1234,7 @@ void hiopAlgFilterIPMQuasiNewton::outputIteration(int lsStatus, int lsNum)
     else if(lsStatus==3) strcpy(stepType, "f");
     else strcpy(stepType, "?");
     nlp->log->printf(hovSummary, "%4d %14.7e %7.3e  %7.3e %6.2f  %7.3e  %7.3e  %d(%s)\n",
-		     iter_num, _f_nlp, _err_nlp_feas, _err_nlp_optim, log10(_mu), _alpha_dual, _alpha_primal, lsNum, stepType); 
+		     iter_num, nlp->user_obj(_f_nlp), _err_nlp_feas_user, _err_nlp_optim_user, log10(_mu), _alpha_dual, _alpha_primal, lsNum, stepType); 
   }
 }
 
@@ -1248,9 +1305,13 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 #endif  
   nlp->log->write("---------------\nProblem Summary\n---------------", *nlp, hovSummary);
 
+  //the profile of the regions of the run is written when 'prof_session' is destroyed
+  hiopProfSession prof_session(nlp->prof, nlp->options->GetString("profile"), nlp->get_comm(), nlp->log);
   nlp->runStats.tmOptimizTotal.start();
 
+  hiopProfRegion prof_start(nlp->prof, "startingPoint");
   startingProcedure(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d); //this also evaluates the nlp
+  prof_start.stop();
   _mu=mu0;
 
   //update log bar
@@ -1269,13 +1330,15 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   theta_max=1e+4*fmax(1.0,resid->getInfeasInfNorm());
   theta_min=1e-4*fmax(1.0,resid->getInfeasInfNorm());
   
-  hiopKKTLinSysCompressed* kkt = decideAndCreateLinearSystem(nlp);
-  assert(kkt != NULL);
+  //released on all the returns, so that the linear solver gives its workspace back to the nlp
+  std::unique_ptr<hiopKKTLinSysCompressed> kkt(decideAndCreateLinearSystem(nlp));
+  assert(kkt);
   kkt->set_PD_perturb_calc(&pd_perturb_);
   
   _alpha_primal = _alpha_dual = 0;
 
   _err_nlp_optim0=-1.; _err_nlp_feas0=-1.; _err_nlp_complem0=-1;
+  _err_nlp_optim_user=_err_nlp_feas_user=_err_nlp_complem_user=_err_nlp_user=-1.;
 
   // --- Algorithm status 'algStatus ----
   //-1 couldn't solve the problem (most likely because small search step. Restauration phase likely needed)
@@ -1382,6 +1445,11 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     //this will cache the primal infeasibility norm for (re)use in the dual updating
     double infeas_nrm_trial;
 
+    //whether the line search accepted a second-order correction step of primal and dual lengths
+    //'alpha_soc' and 'alpha_soc_dual' along 'dir_soc'
+    bool soc_accepted=false;
+    double alpha_soc=0., alpha_soc_dual=0.;
+
     //
     // this is the linear solve (computeDirections) loop that iterates at most two times
     //
@@ -1411,6 +1479,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     for(int linsolve=1; linsolve<=2; ++linsolve) {
 
       nlp->runStats.kkt.start_optimiz_iteration();    
+      hiopProfRegion prof_dir(nlp->prof, "searchDir");
 
       kkt->set_safe_mode(linsol_safe_mode_on);
       //
@@ -1452,7 +1521,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       //
       if(!kkt->computeDirections(resid, dir)) {
 	
-	nlp->runStats.kkt.start_optimiz_iteration();
+	nlp->runStats.kkt.end_optimiz_iteration();
 	
 	if(linsol_safe_mode_on) {
 	  nlp->log->write("Unrecoverable error in step computation (solve)[1]. Will exit here.", hovError);
@@ -1481,6 +1550,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       //support inertia calculation; this case will be handled later on in this loop
       //( //! todo nopiv inertia calculation ))
       nlp->runStats.kkt.end_optimiz_iteration();
+      prof_dir.stop();
 
       if(perf_report_kkt_) {
 	nlp->log->printf(hovSummary, "%s", nlp->runStats.kkt.get_summary_last_iter().c_str());
@@ -1491,6 +1561,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       /***************************************************************
        * backtracking line search
        ****************************************************************/
+      hiopProfRegion prof_ls(nlp->prof, "lineSearch");
       nlp->runStats.tmSolverInternal.start();
       
       //maximum  step
@@ -1506,6 +1577,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       //2 close to solution but switching condition does not hold; trial accepted based on "sufficient decrease"
       //3 close to solution and switching condition is true; trial accepted based on Armijo
       lsStatus=0; lsNum=0;
+      soc_accepted=false;
       
       bool grad_phi_dx_computed=false, iniStep=true; double grad_phi_dx;
       
@@ -1545,7 +1617,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 	
 	nlp->runStats.tmSolverInternal.start(); //---
 	//compute infeasibility theta at trial point.
-	infeas_nrm_trial = theta_trial = resid->computeNlpInfeasInfNorm(*it_trial, *_c_trial, *_d_trial);
+	infeas_nrm_trial = theta_trial = resid_trial->computeNlpInfeasInfNorm(*it_trial, *_c_trial, *_d_trial);
 	
 	lsNum++;
 	
@@ -1557,96 +1629,63 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 	
 	nlp->log->write("Filter IPM: ", filter, hovLinesearch);
 	
-	// Do the cheap, "sufficient progress" test first, before more involved/expensive tests. 
-	// This simple test is good enough when iterate is far away from solution
-	if(theta>=theta_min) {
-	  //check the filter and the sufficient decrease condition (18)
-	  if(!filter.contains(theta_trial,logbar->f_logbar_trial)) {
-	    if(theta_trial<=(1-gamma_theta)*theta || 
-	       logbar->f_logbar_trial<=logbar->f_logbar - gamma_phi*theta) {
-	      //trial good to go
-	      nlp->log->printf(hovLinesearchVerb, "Linesearch: accepting based on suff. decrease "
-			       "(far from solution)\n");
-	      lsStatus=1;
+	lsStatus = checkTrialPoint(theta, theta_trial, _alpha_primal, grad_phi_dx_computed, grad_phi_dx);
+	if(lsStatus>0) break;
+	
+	// second-order correction (SOC): attempted only when the first trial point is rejected and
+	// did not decrease the infeasibility. The constraint residuals are corrected with the ones at
+	// the trial point and the KKT system is solved again with the current factorization.
+	if(lsNum==1 && max_soc_iter>0 && theta_trial>=theta) {
+	  hiopProfRegion prof_soc(nlp->prof, "soc");
+	  resid_soc->copyFrom(*resid);
+	  alpha_soc = _alpha_primal;
+	  double theta_soc_old = theta_trial;
+	  for(int soc_iter=1; soc_iter<=max_soc_iter; ++soc_iter) {
+	    if(soc_iter>1 && theta_trial>kappa_soc*theta_soc_old) break;
+	    theta_soc_old = theta_trial;
+
+	    resid_soc->updateSecondOrderCorrection(alpha_soc, *resid_trial);
+	    nlp->runStats.tmSolverInternal.stop(); //---
+	    if(!kkt->computeDirections(resid_soc, dir_soc)) {
+	      nlp->log->printf(hovLinesearchVerb, "Linesearch: second-order correction %d failed in the "
+			       "linear solve\n", soc_iter);
+	      nlp->runStats.tmSolverInternal.start(); //---
 	      break;
-	    } else {
-	      //there is no sufficient progress 
-	      _alpha_primal *= 0.5;
-	      continue;
 	    }
-	  } else {
-	    //it is in the filter 
-	    _alpha_primal *= 0.5;
-	    continue;
-	  }  
-	  nlp->log->write("Warning (close to panic): got to a point I wasn't supposed reach. (1)",
-			  hovWarning);
-	} else {
-	  // if(theta<theta_min,  then check the switching condition and, if true, rely on Armijo rule.
-	  // first compute grad_phi^T d_x if it hasn't already been computed
-	  if(!grad_phi_dx_computed) { 
+	    nlp->runStats.tmSolverInternal.start(); //---
+	    bret = it_curr->fractionToTheBdry(*dir_soc, _tau, alpha_soc, alpha_soc_dual); assert(bret);
+	    bret = it_trial->takeStep_primals(*it_curr, *dir_soc, alpha_soc, alpha_soc_dual); assert(bret);
 	    nlp->runStats.tmSolverInternal.stop(); //---
-	    grad_phi_dx = logbar->directionalDerivative(*dir); 
-	    grad_phi_dx_computed=true; 
+
+	    if(!this->evalNlp_funcOnly(*it_trial, _f_nlp_trial, *_c_trial, *_d_trial)) {
+	      solver_status_ = Error_In_User_Function;
+	      return Error_In_User_Function;
+	    }
+	    logbar->updateWithNlpInfo_trial_funcOnly(*it_trial, _f_nlp_trial, *_c_trial, *_d_trial);
+
 	    nlp->runStats.tmSolverInternal.start(); //---
-	  }
-	  nlp->log->printf(hovLinesearch, "Linesearch: grad_phi_dx = %22.15e\n", grad_phi_dx);
-	  
-	  // nlp->log->printf(hovSummary,
-	  // 		 "Linesearch: grad_phi_dx = %22.15e      %22.15e >   %22.15e  \n",
-	  // 		 grad_phi_dx, _alpha_primal*pow(-grad_phi_dx,s_phi), delta*pow(theta,s_theta));
-	  // nlp->log->printf(hovSummary,
-	  // 		 "Linesearch: s_phi=%22.15e;   s_theta=%22.15e; theta=%22.15e; delta=%22.15e\n",
-	  // 		 s_phi, s_theta, theta, delta);
-	  
-	  // this is the actual switching condition
-	  if(grad_phi_dx<0 && _alpha_primal*pow(-grad_phi_dx,s_phi)>delta*pow(theta,s_theta)) {
-	    
-	    if(logbar->f_logbar_trial <= logbar->f_logbar + eta_phi*_alpha_primal*grad_phi_dx) {
-	      lsStatus=3;
-	      nlp->log->printf(hovLinesearchVerb,
-			       "Linesearch: accepting based on Armijo (switch cond also passed)\n");
-	      
-	      //iterate good to go since it satisfies Armijo
-	      break; 
-	    } else {
-	      //Armijo is not satisfied
-	      _alpha_primal *= 0.5; //reduce step and try again
-	      continue;
+	    infeas_nrm_trial = theta_trial = resid_trial->computeNlpInfeasInfNorm(*it_trial, *_c_trial, *_d_trial);
+
+	    nlp->log->printf(hovLinesearch, "  soc point %d: alphaPrimal=%14.8e barier:(%22.16e)>%15.9e "
+			     "theta:(%22.16e)>%22.16e\n",
+			     soc_iter, alpha_soc, logbar->f_logbar, logbar->f_logbar_trial, theta, theta_trial);
+
+	    //the switching condition and the Armijo rule use the step along the original direction
+	    lsStatus = checkTrialPoint(theta, theta_trial, _alpha_primal, grad_phi_dx_computed, grad_phi_dx);
+	    if(lsStatus>0) {
+	      nlp->log->printf(hovLinesearchVerb, "Linesearch: accepting second-order correction %d\n",
+			       soc_iter);
+	      soc_accepted = true;
+	      nlp->runStats.nSOCAccepted++;
+	      break;
 	    }
-	  } else {//switching condition does not hold  
-	    
-	    //ok to go with  "sufficient progress" condition even when close to solution, provided the
-	    //switching condition is not satisfied
-	    
-	    //check the filter and the sufficient decrease condition (18)
-	    if(!filter.contains(theta_trial,logbar->f_logbar_trial)) {
-	      if(theta_trial<=(1-gamma_theta)*theta ||
-		 logbar->f_logbar_trial <= logbar->f_logbar - gamma_phi*theta) {
-		
-		//trial good to go
-		nlp->log->printf(hovLinesearchVerb,
-				 "Linesearch: accepting based on suff. decrease (switch cond also passed)\n");
-		lsStatus=2;
-		break;
-	      } else {
-		//there is no sufficient progress 
-		_alpha_primal *= 0.5;
-		continue;
-	      }
-	    } else {
-	      //it is in the filter 
-	      _alpha_primal *= 0.5;
-	      continue;
-	    } 
-	  } // end of else: switching condition does not hold
-	  
-	  nlp->log->write("Warning (close to panic): got to a point I wasn't supposed to reach. (2)",
-			  hovWarning);
-	  
-	} //end of else: theta_trial<theta_min
+	  }
+	  if(soc_accepted) break;
+	}
+	_alpha_primal *= 0.5;
       } //end of while for the linesearch loop
       nlp->runStats.tmSolverInternal.stop();
+      prof_ls.stop();
       
       // post line-search: filter is augmented whenever the switching condition or Armijo rule do not
       // hold for the trial point that was just accepted
@@ -1728,6 +1767,13 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       }
     } // end of the linear solve (computeDirections) loop
 
+    if(soc_accepted) {
+      //the duals are updated along the second-order correction direction
+      hiopIterate* pdir=dir; dir=dir_soc; dir_soc=pdir;
+      _alpha_primal = alpha_soc;
+      _alpha_dual = alpha_soc_dual;
+    }
+
     nlp->log->printf(hovScalars,
 		     "Iter[%d] -> accepted step primal=[%17.11e] dual=[%17.11e]\n",
 		     iter_num, _alpha_primal, _alpha_dual);
@@ -1738,9 +1784,11 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     // this needs to be done before evalNlp_derivOnly so that the user's NLP functions
     // get the updated duals
     assert(infeas_nrm_trial>=0 && "this should not happen");
+    hiopProfRegion prof_duals(nlp->prof, "dualsUpdate");
     bret = dualsUpdate->go(*it_curr, *it_trial, 
 			   _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *dir,  
 			   _alpha_primal, _alpha_dual, _mu, kappa_Sigma, infeas_nrm_trial); assert(bret);
+    prof_duals.stop();
 
     //evaluate derivatives at the trial (and to be accepted) trial point
     if(!this->evalNlp_derivOnly(*it_trial, *_grad_f, *_Jac_c, *_Jac_d, *_Hess_Lagr)) {
@@ -1785,11 +1833,96 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 			      *_c,*_d, 
 			      *it_curr->get_yc(), *it_curr->get_yd(),
 			      _f_nlp);
-  delete kkt;
-
   return solver_status_;
 }
 
+int hiopAlgFilterIPMNewton::checkTrialPoint(const double& theta, const double& theta_trial,
+					    const double& alpha_primal,
+					    bool& grad_phi_dx_computed, double& grad_phi_dx)
+{
+  // Do the cheap, "sufficient progress" test first, before more involved/expensive tests. 
+  // This simple test is good enough when iterate is far away from solution
+  if(theta>=theta_min) {
+    //check the filter and the sufficient decrease condition (18)
+    if(!filter.contains(theta_trial,logbar->f_logbar_trial)) {
+      if(theta_trial<=(1-gamma_theta)*theta || 
+	 logbar->f_logbar_trial<=logbar->f_logbar - gamma_phi*theta) {
+	//trial good to go
+	nlp->log->printf(hovLinesearchVerb, "Linesearch: accepting based on suff. decrease "
+			 "(far from solution)\n");
+	return 1;
+      } else {
+	//there is no sufficient progress 
+	return 0;
+      }
+    } else {
+      //it is in the filter 
+      return 0;
+    }  
+    nlp->log->write("Warning (close to panic): got to a point I wasn't supposed reach. (1)",
+		    hovWarning);
+  } else {
+    // if(theta<theta_min,  then check the switching condition and, if true, rely on Armijo rule.
+    // first compute grad_phi^T d_x if it hasn't already been computed
+    if(!grad_phi_dx_computed) { 
+      nlp->runStats.tmSolverInternal.stop(); //---
+      grad_phi_dx = logbar->directionalDerivative(*dir); 
+      grad_phi_dx_computed=true; 
+      nlp->runStats.tmSolverInternal.start(); //---
+    }
+    nlp->log->printf(hovLinesearch, "Linesearch: grad_phi_dx = %22.15e\n", grad_phi_dx);
+
+    // nlp->log->printf(hovSummary,
+    //             "Linesearch: grad_phi_dx = %22.15e      %22.15e >   %22.15e  \n",
+    //             grad_phi_dx, alpha_primal*pow(-grad_phi_dx,s_phi), delta*pow(theta,s_theta));
+    // nlp->log->printf(hovSummary,
+    //             "Linesearch: s_phi=%22.15e;   s_theta=%22.15e; theta=%22.15e; delta=%22.15e\n",
+    //             s_phi, s_theta, theta, delta);
+
+    // this is the actual switching condition
+    if(grad_phi_dx<0 && alpha_primal*pow(-grad_phi_dx,s_phi)>delta*pow(theta,s_theta)) {
+
+      if(logbar->f_logbar_trial <= logbar->f_logbar + eta_phi*alpha_primal*grad_phi_dx) {
+	nlp->log->printf(hovLinesearchVerb,
+			 "Linesearch: accepting based on Armijo (switch cond also passed)\n");
+
+	//iterate good to go since it satisfies Armijo
+	return 3;
+      } else {
+	//Armijo is not satisfied
+	return 0; //the step will be reduced
+      }
+    } else {//switching condition does not hold  
+
+      //ok to go with  "sufficient progress" condition even when close to solution, provided the
+      //switching condition is not satisfied
+
+      //check the filter and the sufficient decrease condition (18)
+      if(!filter.contains(theta_trial,logbar->f_logbar_trial)) {
+	if(theta_trial<=(1-gamma_theta)*theta ||
+	   logbar->f_logbar_trial <= logbar->f_logbar - gamma_phi*theta) {
+
+	  //trial good to go
+	  nlp->log->printf(hovLinesearchVerb,
+			   "Linesearch: accepting based on suff. decrease (switch cond also passed)\n");
+	  return 2;
+	} else {
+	  //there is no sufficient progress 
+	  return 0;
+	}
+      } else {
+	//it is in the filter 
+	return 0;
+      } 
+    } // end of else: switching condition does not hold
+
+    nlp->log->write("Warning (close to panic): got to a point I wasn't supposed to reach. (2)",
+		    hovWarning);
+
+  } //end of else: theta_trial<theta_min
+  return 0;
+}
+
 void hiopAlgFilterIPMNewton::outputIteration(int lsStatus, int lsNum)
 {
   if(iter_num/10*10==iter_num) 
@@ -1798,7 +1931,7 @@ void hiopAlgFilterIPMNewton::outputIteration(int lsStatus, int lsNum)
 
   if(lsStatus==-1) 
     nlp->log->printf(hovSummary, "%4d %14.7e %7.3e  %7.3e %6.2f  %7.3e  %7.3e  -(-)\n",
-		     iter_num, _f_nlp, _err_nlp_feas, _err_nlp_optim, log10(_mu), _alpha_dual, _alpha_primal); 
+		     iter_num, nlp->user_obj(_f_nlp), _err_nlp_feas_user, _err_nlp_optim_user, log10(_mu), _alpha_dual, _alpha_primal); 
   else {
     char stepType[2];
     
@@ -1808,8 +1941,8 @@ void hiopAlgFilterIPMNewton::outputIteration(int lsStatus, int lsNum)
     else strcpy(stepType, "?");
     
     nlp->log->printf(hovSummary, "%4d %14.7e %7.3e  %7.3e %6.2f  %7.3e  %7.3e  %d(%s)\n",
-		     iter_num, _f_nlp, _err_nlp_feas,
-		     _err_nlp_optim, log10(_mu),
+		     iter_num, nlp->user_obj(_f_nlp), _err_nlp_feas_user,
+		     _err_nlp_optim_user, log10(_mu),
 		     _alpha_dual, _alpha_primal,
 		     lsNum, stepType); 
   }
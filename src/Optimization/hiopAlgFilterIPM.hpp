@@ -86,6 +86,9 @@ public:
   inline hiopSolveStatus getSolveStatus() const { return solver_status_; }
   /* returns the number of iterations */
   int getNumIterations() const;
+  /* returns the value of the log-barrier parameter at the last iteration; can be used as 'mu0' 
+   * when warm starting (see option 'warm_start') a new solve from the solution of this solve */
+  inline double getBarrierParameter() const { return _mu; }
 protected:
   bool evalNlp(hiopIterate& iter,
 	       double &f, hiopVector& c_, hiopVector& d_, 
@@ -149,14 +152,19 @@ protected:
   hiopIterate*it_curr;
   hiopIterate*it_trial;
   hiopIterate* dir;
+  hiopIterate* dir_soc; //second-order correction direction (Newton only)
 
   hiopResidual* resid, *resid_trial;
+  hiopResidual* resid_soc; //right-hand side of the second-order correction (Newton only)
 
   int iter_num;
   double _err_nlp_optim, _err_nlp_feas, _err_nlp_complem;//not scaled by sd, sc, and sc
   double _err_nlp_optim0,_err_nlp_feas0,_err_nlp_complem0;//initial errors, not scaled by sd, sc, and sc
   double _err_log_optim, _err_log_feas, _err_log_complem;//not scaled by sd, sc, and sc
   double _err_nlp, _err_log; //max of the above (scaled)
+  //the nlp errors in the scale of the user's problem, which differ from the above only when the 
+  //problem is scaled (option 'scaling_type'); the overall error is scaled by the same sd and sc
+  double _err_nlp_optim_user, _err_nlp_feas_user, _err_nlp_complem_user, _err_nlp_user;
 
   //class for updating the duals multipliers
   hiopDualsUpdater* dualsUpdate;
@@ -191,12 +199,17 @@ protected:
   double tau_min;       //min value for the fraction-to-the-boundary parameter: tau_k=max{tau_min,1-\mu_k}
   double kappa_eps;     //tolerance for the barrier problem, relative to mu: error<=kappa_eps*mu
   double kappa1,kappa2; //params for default starting point
+  bool warm_start_;     //whether the user's starting primal-dual point is used as a warm start
+  double warm_start_bound_push_; //replaces kappa1 and kappa2 when warm starting
+  double warm_start_mult_bound_push_; //lower threshold for the user's bound duals when warm starting
   double p_smax;        //threshold for the magnitude of the multipliers used in the error estimation
   double gamma_theta,   //sufficient progress parameters for the feasibility violation
     gamma_phi;          //and log barrier objective 
   double s_theta,       //parameters in the switch condition of the linearsearch (eq 19)
     s_phi, delta;
   double eta_phi;       //parameter in the Armijo rule
+  int max_soc_iter;     //max number of second-order corrections in a line search
+  double kappa_soc;     //required decrease of the infeasibility by a second-order correction
   double kappa_Sigma;   //parameter in resetting the duals to guarantee closedness of the
                         //primal-dual logbar Hessian to the primal logbar Hessian
   int dualsUpdateType;  //type of the update for dual multipliers: 0 LSQ (default, recommended
@@ -247,6 +260,13 @@ private:
   virtual void outputIteration(int lsStatus, int lsNum);
   virtual hiopKKTLinSysCompressed* decideAndCreateLinearSystem(hiopNlpFormulation* nlp);
 
+  /* Checks the acceptability of the trial point by the filter line search, given the infeasibility
+   * 'theta' at the current iterate and 'theta_trial' at the trial point; the switching condition
+   * and the Armijo rule use the step 'alpha_primal' along 'dir'. Returns the line search status
+   * (1, 2, or 3, see 'run') of an accepted trial point or 0 if the trial point is rejected. */
+  int checkTrialPoint(const double& theta, const double& theta_trial, const double& alpha_primal,
+		      bool& grad_phi_dx_computed, double& grad_phi_dx);
+
   hiopPDPerturbation pd_perturb_;
 private:
   hiopAlgFilterIPMNewton() : hiopAlgFilterIPMBase(NULL) {};
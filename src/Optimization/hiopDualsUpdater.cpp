@@ -51,6 +51,8 @@
 
 #include "hiop_blasdefs.hpp"
 
+#include <cmath>
+
 namespace hiop
 {
 
@@ -59,10 +61,8 @@ hiopDualsLsqUpdate::hiopDualsLsqUpdate(hiopNlpFormulation* nlp)
 {
   hiopNlpDenseConstraints* nlpd = dynamic_cast<hiopNlpDenseConstraints*>(_nlp);
   assert(NULL!=nlpd);
-  _mexme = LinearAlgebraFactory::createMatrixDense(nlpd->m_eq(),   nlpd->m_eq());
-  _mexmi = LinearAlgebraFactory::createMatrixDense(nlpd->m_eq(),   nlpd->m_ineq());
-  _mixmi = LinearAlgebraFactory::createMatrixDense(nlpd->m_ineq(), nlpd->m_ineq());
-  _mxm   = LinearAlgebraFactory::createMatrixDense(nlpd->m(), nlpd->m());
+  _J = NULL; //allocated or set as a view in 'LSQUpdate'
+  _J_is_view = false;
 
   M      = LinearAlgebraFactory::createMatrixDense(nlpd->m(), nlpd->m());
   rhs    = LinearAlgebraFactory::createVector(nlpd->m());
@@ -83,10 +83,7 @@ hiopDualsLsqUpdate::hiopDualsLsqUpdate(hiopNlpFormulation* nlp)
 
 hiopDualsLsqUpdate::~hiopDualsLsqUpdate()
 {
-  delete _mexme;
-  delete _mexmi;
-  delete _mixmi;
-  delete _mxm;
+  delete _J;
   delete M;
   delete rhs;
   delete rhsc; 
@@ -157,22 +154,26 @@ LSQUpdate(hiopIterate& iter, const hiopVector& grad_f, const hiopMatrix& jac_c,
   hiopNlpDenseConstraints* nlpd = dynamic_cast<hiopNlpDenseConstraints*>(_nlp);
   assert(nlpd!=NULL);
 
-  //compute terms in M: Jc * Jc^T, J_c * J_d^T, and J_d * J_d^T
-  //! streamline the communication (use _mxm as a global buffer for the MPI_Allreduce)
-  jac_c.timesMatTrans(0.0, *_mexme, 1.0, jac_c);
-  jac_c.timesMatTrans(0.0, *_mexmi, 1.0, jac_d);
-  jac_d.timesMatTrans(0.0, *_mixmi, 1.0, jac_d);
-  _mixmi->addDiagonal(1.0);
-
-  M->copyBlockFromMatrix(0,0,*_mexme);
-  M->copyBlockFromMatrix(0, nlpd->m_eq(), *_mexmi);
-  M->copyBlockFromMatrix(nlpd->m_eq(),nlpd->m_eq(), *_mixmi);
+  //compute the upper triangle of M = [Jc;Jd]*[Jc;Jd]^T + [0 0; 0 I] with one DSYRK over the local 
+  //columns and one reduction of the packed upper triangle across ranks
+  const hiopMatrixDense& J = stackedJacobian(jac_c, jac_d);
+  int m=nlpd->m(), n_local=J.get_local_size_n();
+  if(m>0) {
+    hiopProfRegion prof_syrk(_nlp->prof, "lsq.matrix");
+    prof_syrk.add_work(8.*m*(n_local+m), m*(m+1.)*n_local);
+    J.symTimesMatTrans(0.0, *M, 1.0);
+    M->addSubDiagonal((int)nlpd->m_eq(), (int)nlpd->m_ineq(), 1.0);
+  }
 
 #ifdef HIOP_DEEPCHECKS
   M_copy->copyFrom(*M);
+  M_copy->overwriteLowerTriangleWithUpper();
+  //check the Jd*Jc^T block against an independent product
   jac_d.timesMatTrans(0.0, *_mixme, 1.0, jac_c);
-  M_copy->copyBlockFromMatrix(nlpd->m_eq(), 0, *_mixme);
-  M_copy->assertSymmetry(1e-12);
+  for(int i=0; i<nlpd->m_ineq(); i++)
+    for(int j=0; j<nlpd->m_eq(); j++)
+      assert(fabs(_mixme->local_data()[i][j]-M_copy->local_data()[nlpd->m_eq()+i][j]) <= 
+	     1e-12*(1+fabs(_mixme->local_data()[i][j])));
 #endif
 
   //bailout in case there is an error in the Cholesky factorization
@@ -238,6 +239,16 @@ LSQUpdate(hiopIterate& iter, const hiopVector& grad_f, const hiopMatrix& jac_c,
   return true;
 };
 
+/* Returns [Jc;Jd], see hiopNlpDenseConstraints::stack_Jac_c_d */
+const hiopMatrixDense& hiopDualsLsqUpdate::stackedJacobian(const hiopMatrix& jac_c, const hiopMatrix& jac_d)
+{
+  hiopNlpDenseConstraints* nlpd = dynamic_cast<hiopNlpDenseConstraints*>(_nlp); assert(nlpd);
+  const hiopMatrixDense* Jc = dynamic_cast<const hiopMatrixDense*>(&jac_c); assert(Jc);
+  const hiopMatrixDense* Jd = dynamic_cast<const hiopMatrixDense*>(&jac_d); assert(Jd);
+  nlpd->stack_Jac_c_d(*Jc, *Jd, _J, _J_is_view);
+  return *_J;
+}
+
 int hiopDualsLsqUpdate::factorizeMat(hiopMatrixDense& M)
 {
 #ifdef HIOP_DEEPCHECKS
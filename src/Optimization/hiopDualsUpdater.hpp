@@ -123,7 +123,9 @@ private: //common code
 			 const hiopMatrix& jac_c,
 			 const hiopMatrix& jac_d);
 private:
-  hiopMatrixDense *_mexme, *_mexmi, *_mixmi, *_mxm;
+  //the stacked Jacobian [Jc;Jd]; a view of the Jacobians' storage when possible
+  hiopMatrixDense *_J;
+  bool _J_is_view;
   hiopMatrixDense *M;
   
   hiopVector *rhs, *rhsc, *rhsd;
@@ -143,6 +145,7 @@ private:
   double recalc_lsq_duals_tol;  
                                 
   //helpers
+  const hiopMatrixDense& stackedJacobian(const hiopMatrix& jac_c, const hiopMatrix& jac_d);
   int factorizeMat(hiopMatrixDense& M);
   int solveWithFactors(hiopMatrixDense& M, hiopVector& r);
 private: 
@@ -48,6 +48,9 @@
 
 #include "hiopFilter.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace std;
 
 namespace hiop
@@ -55,16 +58,41 @@ namespace hiop
 
 bool hiopFilter::contains(const double& theta, const double& phi) const
 {
-  list<FilterEntry>::const_iterator it = entries.begin();
-  bool bFound=false;
-  while(it!=entries.end()) {
-    if(theta>=it->theta && phi>=it->phi) { 
-      bFound=true;
-      break;
-    }
-    ++it;
+  //NaNs are never dominated
+  if(std::isnan(theta) || std::isnan(phi)) return false;
+
+  //the last entry with theta smaller or equal to 'theta' has the smallest phi among all such entries
+  auto it = upper_bound(entries.begin(), entries.end(), theta,
+			[](const double& t, const FilterEntry& fe) { return t < fe.theta; });
+  if(it==entries.begin()) return false;
+  --it;
+  assert(theta>=it->theta);
+  return phi>=it->phi;
+}
+
+void hiopFilter::add(const double& theta, const double& phi)
+{
+  //pairs with NaNs or dominated by pairs already in the filter would not reject any trial point
+  if(contains(theta, phi) || std::isnan(theta) || std::isnan(phi)) return;
+
+  //first entry with theta larger or equal to 'theta'; the entries dominated by the new pair are
+  //the contiguous range starting here that have phi larger or equal to 'phi'
+  auto first = lower_bound(entries.begin(), entries.end(), theta,
+			   [](const FilterEntry& fe, const double& t) { return fe.theta < t; });
+  auto last = first;
+  while(last!=entries.end() && last->phi>=phi) ++last;
+
+  if(first!=last) {
+    *first = FilterEntry(theta, phi);
+    entries.erase(first+1, last);
+  } else {
+    entries.insert(first, FilterEntry(theta, phi));
+  }
+#ifdef HIOP_DEEPCHECKS
+  for(size_t i=1; i<entries.size(); i++) {
+    assert(entries[i-1].theta<entries[i].theta && entries[i-1].phi>entries[i].phi);
   }
-  return bFound;
+#endif
 }
 
 void hiopFilter::print(FILE* file, const char* msg) const
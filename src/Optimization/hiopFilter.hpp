@@ -50,28 +50,34 @@
 #define HIOP_FILTER
 
 #include <cstdio>
-#include <list>
+#include <vector>
 #include <cassert>
 
 namespace hiop
 {
 
+/**
+ * The filter of the line-search filter IPM. 
+ *
+ * Only the Pareto front of the (theta, phi) pairs added to the filter is stored, since a pair 
+ * dominated by another pair (larger or equal theta and phi) does not change the acceptability
+ * of trial points. The front is kept in a vector sorted increasingly on theta, hence with phi
+ * strictly decreasing, so that the acceptance test is a binary search.
+ */
 class hiopFilter
 {
 public:
   hiopFilter()  { };
   ~hiopFilter() { };
-  inline void initialize  (const double& theta_max) { entries.clear(); entries.push_front(FilterEntry(theta_max,-1e20)); }
+  inline void initialize  (const double& theta_max) { entries.clear(); entries.push_back(FilterEntry(theta_max,-1e20)); }
   inline void reinitialize(const double& theta_max) { initialize(theta_max); }
 
   inline void clear() { entries.clear(); }
   
-  //entries are pushed at the front since these are most likely to reject new iterates
-  inline void add(const double& theta, const double& phi)
-  {
-    entries.push_front(FilterEntry(theta,phi));
-  }
+  /* adds the pair to the filter and removes the pairs dominated by it */
+  void add(const double& theta, const double& phi);
   
+  /* returns true if there is a pair in the filter with both theta and phi smaller or equal */
   bool contains(const double& theta, const double& phi) const;
 
   void print(FILE* file, const char* msg) const;
@@ -83,7 +89,8 @@ private:
     FilterEntry() : theta(0.), phi(0.) { assert(true); }
 #endif
   };
-  std::list<FilterEntry> entries;
+  //Pareto front sorted increasingly on theta (and decreasingly on phi)
+  std::vector<FilterEntry> entries;
 };
 
 }
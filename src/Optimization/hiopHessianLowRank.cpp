@@ -373,8 +373,11 @@ void hiopHessianLowRank::updateInternalBFGSRepresentation()
   hiopMatrixDense& DpYtDhInvY = new_lxl_mat1(l);
   symmMatTimesDiagTimesMatTrans_local(0.0, DpYtDhInvY, 1.0,*Yt,*DhInv);
 #ifdef HIOP_USE_MPI
+  //the symmetric blocks (2,2) and (1,1) are reduced as packed upper triangles and the (1,2) block
+  //in full; the reduce buffer is [ (2,2) | (1,1) | (1,2) ]
   const size_t buffsize=l*l*sizeof(double);
-  memcpy(_buff1_lxlx3, DpYtDhInvY.local_buffer(), buffsize);
+  const int lpacked=l*(l+1)/2;
+  DpYtDhInvY.packUpperTriangle(_buff1_lxlx3);
 #else
   DpYtDhInvY.addDiagonal(1., *D);
   V->copyBlockFromMatrix(l,l,DpYtDhInvY);
@@ -386,7 +389,7 @@ void hiopHessianLowRank::updateInternalBFGSRepresentation()
   B0DhInv.copyFrom(*DhInv); B0DhInv.scale(sigma);
   matTimesDiagTimesMatTrans_local(StB0DhInvYmL, *St, B0DhInv, *Yt);
 #ifdef HIOP_USE_MPI
-  memcpy(_buff1_lxlx3+l*l, StB0DhInvYmL.local_buffer(), buffsize);
+  memcpy(_buff1_lxlx3+2*lpacked, StB0DhInvYmL.local_buffer(), buffsize);
 #else
   //substract L
   StB0DhInvYmL.addMatrix(-1.0, *L);
@@ -401,7 +404,7 @@ void hiopHessianLowRank::updateInternalBFGSRepresentation()
   hiopMatrixDense& StDS = DpYtDhInvY; //a rename
   symmMatTimesDiagTimesMatTrans_local(0.0, StDS, 1.0, *St, theDiag);
 #ifdef HIOP_USE_MPI
-  memcpy(_buff1_lxlx3+2*l*l, DpYtDhInvY.local_buffer(), buffsize);
+  StDS.packUpperTriangle(_buff1_lxlx3+lpacked);
 #else
   V->copyBlockFromMatrix(0,0,StDS);
 #endif
@@ -409,20 +412,21 @@ void hiopHessianLowRank::updateInternalBFGSRepresentation()
 
 #ifdef HIOP_USE_MPI
   int ierr;
-  ierr = MPI_Allreduce(_buff1_lxlx3, _buff2_lxlx3, 3*l*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  ierr = MPI_Allreduce(_buff1_lxlx3, _buff2_lxlx3, 2*lpacked+l*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); 
+  assert(ierr==MPI_SUCCESS);
 
   // - block (2,2)
-  DpYtDhInvY.copyFrom(_buff2_lxlx3);
+  DpYtDhInvY.unpackUpperTriangle(_buff2_lxlx3);
   DpYtDhInvY.addDiagonal(1., *D);
   V->copyBlockFromMatrix(l,l,DpYtDhInvY);
 
   // - block (1,2)
-  StB0DhInvYmL.copyFrom(_buff2_lxlx3+l*l);
+  StB0DhInvYmL.copyFrom(_buff2_lxlx3+2*lpacked);
   StB0DhInvYmL.addMatrix(-1.0, *L);
   V->copyBlockFromMatrix(0,l,StB0DhInvYmL);
 
   // - block (1,1)
-  StDS.copyFrom(_buff2_lxlx3+2*l*l);
+  StDS.unpackUpperTriangle(_buff2_lxlx3+lpacked);
   V->copyBlockFromMatrix(0,0,StDS);
 #endif
 #ifdef HIOP_DEEPCHECKS
@@ -517,21 +521,16 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
 #endif 
 
   //1. compute W=beta*W + alpha*X*DhInv*X'
+  //2. compute S1=X*DhInv*B0*S and Y1=X*DhInv*Y
+  //both are done in one sweep over X
+  hiopMatrixDense &S1=new_S1(X,*St), &Y1=new_Y1(X,*Yt); //both are kxl
 #ifdef HIOP_USE_MPI
-  if(0==nlp->get_rank())
-    symmMatTimesDiagTimesMatTrans_local(beta,W,alpha,X,*DhInv);
-  else
-    symmMatTimesDiagTimesMatTrans_local(0.0, W,alpha,X,*DhInv);
   //W will be MPI_All_reduced later
+  const double beta_local = 0==nlp->get_rank() ? beta : 0.0;
 #else
-  symmMatTimesDiagTimesMatTrans_local(beta,W,alpha,X,*DhInv);
+  const double beta_local = beta;
 #endif
-  //2. compute S1=X*DhInv*B0*S and Y1=X*DhInv*Y
-  hiopMatrixDense &S1=new_S1(X,*St), &Y1=new_Y1(X,*Yt); //both are kxl
-  hiopVector& B0DhInv = new_n_vec1(n);
-  B0DhInv.copyFrom(*DhInv); B0DhInv.scale(sigma);
-  matTimesDiagTimesMatTrans_local(S1, X, B0DhInv, *St);
-  matTimesDiagTimesMatTrans_local(Y1, X, *DhInv,  *Yt);
+  symmMatTimesDiagTimesMatTrans_SY_local(beta_local, W, alpha, X, *DhInv, sigma, *St, S1, *Yt, Y1);
 
   //3. reduce W, S1, and Y1 (dimensions: kxk, kxl, kxl)
   hiopMatrixDense& S2Y2 = new_kx2l_mat1(k,l);  //Initialy S2Y2 = [Y1 S1]
@@ -540,13 +539,16 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
 #ifdef HIOP_USE_MPI
   int ierr;
   ierr = MPI_Allreduce(S2Y2.local_buffer(), _buff_2lxk, 2*l*k, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
-  ierr = MPI_Allreduce(W.local_buffer(),    _buff_kxk,  k*k,   MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  //W is symmetric and only its upper triangle is computed, so only that one is reduced
+  W.packUpperTriangle(_buff_kxk);
+  ierr = MPI_Allreduce(MPI_IN_PLACE, _buff_kxk, k*(k+1)/2, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
   S2Y2.copyFrom(_buff_2lxk);
-  W.copyFrom(_buff_kxk);
+  W.unpackUpperTriangle(_buff_kxk);
   //also copy S1 and Y1
   S1.copyFromMatrixBlock(S2Y2, 0,0);
   Y1.copyFromMatrixBlock(S2Y2, 0,l);
 #endif
+  W.overwriteLowerTriangleWithUpper();
 #ifdef HIOP_DEEPCHECKS
   nlp->log->write("symMatTimesInverseTimesMatTrans: W first term is: ", W, hovMatrices);
 #endif 
@@ -1024,6 +1026,62 @@ symmMatTimesDiagTimesMatTrans_local(double beta, hiopMatrixDense& W,
   }
 }
 
+/* W = beta*W + alpha*X*D*X^T, S1 = sigma*X*D*S^T, and Y1 = X*D*Y^T, where X is kxn, S and Y are
+ * lxn, and D is diag nxn. Only the upper triangle of W is updated. 
+ * The local columns are processed in chunks small enough for the chunk of X to stay in cache 
+ * while it is used by all three products, so X is read from memory only once.
+ * The ops are perform locally; the reduce is done externally.
+ */
+void hiopHessianLowRank::
+symmMatTimesDiagTimesMatTrans_SY_local(double beta, hiopMatrixDense& W,
+				       double alpha, const hiopMatrixDense& X,
+				       const hiopVector& d,
+				       double sigma, const hiopMatrixDense& S, hiopMatrixDense& S1,
+				       const hiopMatrixDense& Y, hiopMatrixDense& Y1)
+{
+  const int k=X.m(), l=S.m();
+  const long long n_local=X.get_local_size_n();
+#ifdef HIOP_DEEPCHECKS
+  assert(W.m()==k && W.n()==k);
+  assert(S1.m()==k && S1.n()==l);
+  assert(Y1.m()==k && Y1.n()==l);
+  assert(Y.m()==l);
+  assert(d.get_local_size()==n_local);
+  assert(S.get_local_size_n()==n_local && Y.get_local_size_n()==n_local);
+#endif
+  double **Wd=W.local_data(), **S1d=S1.local_data(), **Y1d=Y1.local_data();
+  double **Xd=X.local_data(), **Sd=S.local_data(), **Yd=Y.local_data();
+  const double* dd=d.local_data_const();
+
+  for(int i=0; i<k; i++) {
+    for(int j=i; j<k; j++) Wd[i][j] *= beta;
+    for(int j=0; j<l; j++) S1d[i][j] = Y1d[i][j] = 0.;
+  }
+
+  //about 256KB of X per chunk
+  long long chunk = 32768/(k>0?k:1);
+  if(chunk<64) chunk=64;
+  if((long long)buff_chunk_.size()<chunk) buff_chunk_.resize(chunk);
+  double* xd = buff_chunk_.data();
+  int one=1;
+  for(long long p0=0; p0<n_local; p0+=chunk) {
+    int len = (int) (n_local-p0<chunk ? n_local-p0 : chunk);
+    const double* dp = dd+p0;
+    for(int i=0; i<k; i++) {
+      const double* xi = Xd[i]+p0;
+      for(int p=0; p<len; p++) xd[p] = xi[p]*dp[p];
+
+      for(int j=i; j<k; j++)
+	Wd[i][j] += alpha*DDOT(&len, xd, &one, Xd[j]+p0, &one);
+
+      for(int j=0; j<l; j++) {
+	S1d[i][j] += sigma*DDOT(&len, xd, &one, Sd[j]+p0, &one);
+	Y1d[i][j] += DDOT(&len, xd, &one, Yd[j]+p0, &one);
+      }
+    }
+  }
+}
+
 /* W=S*D*X^T, where S is lxn, D is diag nxn, and X is kxn */
 void hiopHessianLowRank::
 matTimesDiagTimesMatTrans_local(hiopMatrixDense& W, const hiopMatrixDense& S, const hiopVector& d, const hiopMatrixDense& X)
@@ -53,6 +53,7 @@
 #include "hiopIterate.hpp"
 
 #include <cassert>
+#include <vector>
 
 namespace hiop
 {
@@ -211,6 +212,15 @@ private:
   /* W=S*Diag*X^T */
   static void matTimesDiagTimesMatTrans_local(hiopMatrixDense& W, const hiopMatrixDense& S, 
 					      const hiopVector& d, const hiopMatrixDense& X);
+  /* W = beta*W + alpha*X*Diag*X^T, S1 = sigma*X*Diag*S^T, and Y1 = X*Diag*Y^T computed in one 
+   * sweep over X (by chunks of columns); the scaled chunk of X is kept in 'buff_chunk_' */
+  void symmMatTimesDiagTimesMatTrans_SY_local(double beta, hiopMatrixDense& W,
+						     double alpha, const hiopMatrixDense& X,
+						     const hiopVector& d,
+						     double sigma, const hiopMatrixDense& S, hiopMatrixDense& S1,
+						     const hiopMatrixDense& Y, hiopMatrixDense& Y1);
+  //buffer for the chunks of X*Diag, reused across the calls of 'symmMatTimesDiagTimesMatTrans_SY_local'
+  std::vector<double> buff_chunk_;
   /* members and utilities related to V matrix: factorization and solve */
   hiopVector *_V_work_vec;
   int _V_ipiv_size; int* _V_ipiv_vec;
@@ -320,6 +330,14 @@ public:
     assert(false && "not provided because it is not needed");
     return 0.;
   }
+  virtual void row_max_abs_value(hiopVector& ret)
+  {
+    assert(false && "not provided because it is not needed");
+  }
+  virtual void scale_row(hiopVector& vec_scal, const bool inv_scale)
+  {
+    assert(false && "not provided because it is not needed");
+  }
 
   void copyRowsFrom(const hiopMatrix& src_in, const long long* rows_idxs, long long n_rows)
   {
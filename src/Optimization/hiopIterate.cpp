@@ -47,29 +47,61 @@
 // product endorsement purposes.
 
 #include "hiopIterate.hpp"
+#include "hiopVectorPar.hpp"
 
 #include <cmath>
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
+
+#include "hiopOmp.hpp"
+
 namespace hiop
 {
 
+/* w = u + alpha*v for 'n' contiguous entries */
+static void stepKernel(double* w, const double* u, const double* v, double alpha, long long n,
+		       const hiopOmpParams* omp)
+{
+  HIOP_OMP_FOR(n, omp)
+  for(long long i=0; i<n; i++) {
+    w[i] = u[i] + alpha*v[i];
+  }
+}
+
 hiopIterate::hiopIterate(const hiopNlpFormulation* nlp_)
 {
   nlp = nlp_;
-  x = dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-  d = dynamic_cast<hiopVectorPar*>(nlp->alloc_dual_ineq_vec());
-  sxl = x->alloc_clone();
-  sxu = x->alloc_clone();
-  sdl = d->alloc_clone();
-  sdu = d->alloc_clone();
+  //the vectors returned by the nlp only provide the sizes and the distribution of the views
+  hiopVectorPar* xt  = dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
+  hiopVectorPar* dt  = dynamic_cast<hiopVectorPar*>(nlp->alloc_dual_ineq_vec());
+  hiopVectorPar* yct = dynamic_cast<hiopVectorPar*>(nlp->alloc_dual_eq_vec());
+  assert(xt && dt && yct);
+  nx_ = xt->get_local_size();
+  nd_ = dt->get_local_size();
+  nyc_ = yct->get_local_size();
+
+  buffer_ = new double[primals_size()+duals_size()];
+  double* p = buffer_;
+  x   = xt->new_view(p); p += nx_;
+  d   = dt->new_view(p); p += nd_;
+  sxl = xt->new_view(p); p += nx_;
+  sxu = xt->new_view(p); p += nx_;
+  sdl = dt->new_view(p); p += nd_;
+  sdu = dt->new_view(p); p += nd_;
   //duals
-  yc = dynamic_cast<hiopVectorPar*>(nlp->alloc_dual_eq_vec());
-  yd = d->alloc_clone();
-  zl = x->alloc_clone();
-  zu = x->alloc_clone();
-  vl = d->alloc_clone();
-  vu = d->alloc_clone();
+  yc  = yct->new_view(p); p += nyc_;
+  yd  = dt->new_view(p); p += nd_;
+  zl  = xt->new_view(p); p += nx_;
+  zu  = xt->new_view(p); p += nx_;
+  vl  = dt->new_view(p); p += nd_;
+  vu  = dt->new_view(p); p += nd_;
+  assert(p == buffer_+primals_size()+duals_size());
+  assert(slacks() == sxl->local_data() && bound_duals() == zl->local_data());
+
+  delete xt;
+  delete dt;
+  delete yct;
 }
 
 hiopIterate::~hiopIterate()
@@ -86,6 +118,7 @@ hiopIterate::~hiopIterate()
   if(zu) delete zu;
   if(vl) delete vl;
   if(vu) delete vu;
+  delete[] buffer_;
 }
 
 /* cloning and copying */
@@ -104,20 +137,8 @@ hiopIterate* hiopIterate::new_copy() const
 
 void  hiopIterate::copyFrom(const hiopIterate& src)
 {
-  x->copyFrom(*src.x);
-  d->copyFrom(*src.d);
-
-  yc->copyFrom(*src.yc); 
-  yd->copyFrom(*src.yd);
-
-  sxl->copyFrom(*src.sxl); 
-  sxu->copyFrom(*src.sxu);
-  sdl->copyFrom(*src.sdl);
-  sdu->copyFrom(*src.sdu);
-  zl->copyFrom(*src.zl); 
-  zu->copyFrom(*src.zu);
-  vl->copyFrom(*src.vl);
-  vu->copyFrom(*src.vu);
+  assert(nx_==src.nx_ && nd_==src.nd_ && nyc_==src.nyc_);
+  memcpy(buffer_, src.buffer_, (primals_size()+duals_size())*sizeof(double));
 }
 
 void hiopIterate::print(FILE* f, const char* msg/*=NULL*/) const
@@ -170,6 +191,20 @@ void hiopIterate::setBoundsDualsToConstant(const double& v)
   vu->setToConstant_w_patternSelect(v, nlp->get_idu());
 }
 
+void hiopIterate::pushBoundsDualsAwayFromZero(const double& push)
+{
+  const double* ixl=dynamic_cast<const hiopVectorPar&>(nlp->get_ixl()).local_data_const();
+  const double* ixu=dynamic_cast<const hiopVectorPar&>(nlp->get_ixu()).local_data_const();
+  double* zlv = zl->local_data();
+  double* zuv = zu->local_data();
+  long long n_local = zl->get_local_size();
+  assert(n_local == zu->get_local_size());
+  for(long long i=0; i<n_local; i++) {
+    if(ixl[i]==1. && zlv[i]<push) zlv[i]=push;
+    if(ixu[i]==1. && zuv[i]<push) zuv[i]=push;
+  }
+}
+
 void hiopIterate::setEqualityDualsToConstant(const double& v)
 {
   yc->setToConstant(v);
@@ -178,43 +213,33 @@ void hiopIterate::setEqualityDualsToConstant(const double& v)
 
 double hiopIterate::normOneOfBoundDuals() const
 {
-#ifdef HIOP_DEEPCHECKS
-  assert(zl->matchesPattern(nlp->get_ixl()));
-  assert(zu->matchesPattern(nlp->get_ixu()));
-  assert(vl->matchesPattern(nlp->get_idl()));
-  assert(vu->matchesPattern(nlp->get_idu()));
-#endif
-  //work locally with all the vectors. This will result in only one MPI_Allreduce call instead of two.
-  double nrm1=zl->onenorm_local() + zu->onenorm_local();
-#ifdef HIOP_USE_MPI
-  double nrm1_global;
-  int ierr=MPI_Allreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
-  nrm1=nrm1_global;
-#endif
-  nrm1 += vl->onenorm_local() + vu->onenorm_local();
-  return nrm1;
+  hiopReductionPlan plan(nlp->get_comm());
+  int idx_nrm1Eq, idx_nrm1Bnd;
+  normOneOfDuals(plan, idx_nrm1Eq, idx_nrm1Bnd);
+  plan.resolve();
+  return plan.get(idx_nrm1Bnd);
 }
 
 double hiopIterate::normOneOfEqualityDuals() const
 {
-#ifdef HIOP_DEEPCHECKS
-  assert(zl->matchesPattern(nlp->get_ixl()));
-  assert(zu->matchesPattern(nlp->get_ixu()));
-  assert(vl->matchesPattern(nlp->get_idl()));
-  assert(vu->matchesPattern(nlp->get_idu()));
-#endif
-  //work locally with all the vectors. This will result in only one MPI_Allreduce call instead of two.
-  double nrm1=zl->onenorm_local() + zu->onenorm_local();
-#ifdef HIOP_USE_MPI
-  double nrm1_global;
-  int ierr=MPI_Allreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
-  nrm1=nrm1_global;
-#endif
-  nrm1 += vl->onenorm_local() + vu->onenorm_local() + yc->onenorm_local() + yd->onenorm_local();
-  return nrm1;
+  hiopReductionPlan plan(nlp->get_comm());
+  int idx_nrm1Eq, idx_nrm1Bnd;
+  normOneOfDuals(plan, idx_nrm1Eq, idx_nrm1Bnd);
+  plan.resolve();
+  return plan.get(idx_nrm1Eq);
 }
 
 void hiopIterate::normOneOfDuals(double& nrm1Eq, double& nrm1Bnd) const
+{
+  hiopReductionPlan plan(nlp->get_comm());
+  int idx_nrm1Eq, idx_nrm1Bnd;
+  normOneOfDuals(plan, idx_nrm1Eq, idx_nrm1Bnd);
+  plan.resolve();
+  nrm1Eq = plan.get(idx_nrm1Eq);
+  nrm1Bnd = plan.get(idx_nrm1Bnd);
+}
+
+void hiopIterate::normOneOfDuals(hiopReductionPlan& plan, int& idx_nrm1Eq, int& idx_nrm1Bnd) const
 {
 #ifdef HIOP_DEEPCHECKS
   assert(zl->matchesPattern(nlp->get_ixl()));
@@ -222,16 +247,11 @@ void hiopIterate::normOneOfDuals(double& nrm1Eq, double& nrm1Bnd) const
   assert(vl->matchesPattern(nlp->get_idl()));
   assert(vu->matchesPattern(nlp->get_idu()));
 #endif
-  //work locally with all the vectors. This will result in only one MPI_Allreduce call
-  nrm1Bnd = zl->onenorm_local() + zu->onenorm_local();
-#ifdef HIOP_USE_MPI
-  double nrm1_global;
-  int ierr=MPI_Allreduce(&nrm1Bnd, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm());
-  assert(MPI_SUCCESS==ierr);
-  nrm1Bnd=nrm1_global;
-#endif
-  nrm1Bnd += vl->onenorm_local() + vu->onenorm_local();
-  nrm1Eq   = nrm1Bnd + yc->onenorm_local() + yd->onenorm_local();
+  //only the duals of the bounds on x are distributed; the others are replicated on all ranks
+  const double nrm1_distrib = zl->onenorm_local() + zu->onenorm_local();
+  const double nrm1Bnd_repl = vl->onenorm_local() + vu->onenorm_local();
+  idx_nrm1Bnd = plan.add_sum(nrm1_distrib, nrm1Bnd_repl);
+  idx_nrm1Eq  = plan.add_sum(nrm1_distrib, nrm1Bnd_repl + yc->onenorm_local() + yd->onenorm_local());
 }
 
 
@@ -277,37 +297,44 @@ void hiopIterate::determineDualsBounds_d(const double& mu)
 bool hiopIterate::
 fractionToTheBdry(const hiopIterate& dir, const double& tau, double& alphaprimal, double& alphadual) const
 {
-  alphaprimal=alphadual=10.0;
-  double alpha=0;
-  alpha=sxl->fractionToTheBdry_w_pattern_local(*dir.sxl, tau, nlp->get_ixl());
-  alphaprimal=fmin(alphaprimal,alpha);
-  
-  alpha=sxu->fractionToTheBdry_w_pattern_local(*dir.sxu, tau, nlp->get_ixu());
-  alphaprimal=fmin(alphaprimal,alpha);
-
-  alpha=sdl->fractionToTheBdry_w_pattern_local(*dir.sdl, tau, nlp->get_idl());
-  alphaprimal=fmin(alphaprimal,alpha);
-
-  alpha=sdu->fractionToTheBdry_w_pattern_local(*dir.sdu, tau, nlp->get_idu());
-  alphaprimal=fmin(alphaprimal,alpha);
-
-  //for dual variables
-  alpha=zl->fractionToTheBdry_w_pattern_local(*dir.zl, tau, nlp->get_ixl());
-  alphadual=fmin(alphadual,alpha);
-  
-  alpha=zu->fractionToTheBdry_w_pattern_local(*dir.zu, tau, nlp->get_ixu());
-  alphadual=fmin(alphadual,alpha);
-
-  alpha=vl->fractionToTheBdry_w_pattern_local(*dir.vl, tau, nlp->get_idl());
-  alphadual=fmin(alphadual,alpha);
-
-  alpha=vu->fractionToTheBdry_w_pattern_local(*dir.vu, tau, nlp->get_idu());
-  alphadual=fmin(alphadual,alpha); 
-#ifdef HIOP_USE_MPI
-  double aux[2]={alphaprimal,alphadual}, aux_g[2];
-  int ierr=MPI_Allreduce(aux, aux_g, 2, MPI_DOUBLE, MPI_MIN, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
-  alphaprimal=aux_g[0]; alphadual=aux_g[1];
+#ifdef HIOP_DEEPCHECKS
+  assert(tau>0 && tau<1);
 #endif
+  //the slacks and the bound duals are traversed together, segment by segment, since they share
+  //the patterns
+  const hiopVector* patterns[4] = {&nlp->get_ixl(), &nlp->get_ixu(), &nlp->get_idl(), &nlp->get_idu()};
+  const long long sizes[4] = {nx_, nx_, nd_, nd_};
+  const double *s = slacks(), *ds = dir.slacks(), *z = bound_duals(), *dz = dir.bound_duals();
+  double ap=1.0, ad=1.0;
+  for(int k=0; k<4; k++) {
+    const double* pat = dynamic_cast<const hiopVectorPar*>(patterns[k])->local_data_const();
+    const long long n = sizes[k];
+    HIOP_OMP_FOR_REDUCTION(n, nlp->get_omp_params(), min, ap, ad)
+    for(long long i=0; i<n; i++) {
+      if(pat[i]==0) continue;
+      if(ds[i]<0) {
+#ifdef HIOP_DEEPCHECKS
+	assert(s[i]>0);
+#endif
+	const double aux = -tau*s[i]/ds[i];
+	if(aux<ap) ap=aux;
+      }
+      if(dz[i]<0) {
+	const double aux = -tau*z[i]/dz[i];
+	if(aux<ad) ad=aux;
+      }
+    }
+    s += n; ds += n; z += n; dz += n;
+  }
+  alphaprimal = ap;
+  alphadual = ad;
+
+  hiopReductionPlan plan(nlp->get_comm());
+  const int idx_primal = plan.add_min(alphaprimal);
+  const int idx_dual = plan.add_min(alphadual);
+  plan.resolve();
+  alphaprimal = plan.get(idx_primal); 
+  alphadual = plan.get(idx_dual);
 
   return true;
 }
@@ -315,12 +342,8 @@ fractionToTheBdry(const hiopIterate& dir, const double& tau, double& alphaprimal
 
 bool hiopIterate::takeStep_primals(const hiopIterate& iter, const hiopIterate& dir, const double& alphaprimal, const double& alphadual)
 {
-  x->copyFrom(*iter.x); x->axpy(alphaprimal, *dir.x);
-  d->copyFrom(*iter.d); d->axpy(alphaprimal, *dir.d);
-  sxl->copyFrom(*iter.sxl); sxl->axpy(alphaprimal,*dir.sxl);
-  sxu->copyFrom(*iter.sxu); sxu->axpy(alphaprimal,*dir.sxu);
-  sdl->copyFrom(*iter.sdl); sdl->axpy(alphaprimal,*dir.sdl);
-  sdu->copyFrom(*iter.sdu); sdu->axpy(alphaprimal,*dir.sdu);
+  //x, d, and the slacks in one sweep
+  stepKernel(buffer_, iter.buffer_, dir.buffer_, alphaprimal, primals_size(), nlp->get_omp_params());
 #ifdef HIOP_DEEPCHECKS
   assert(sxl->matchesPattern(nlp->get_ixl()));
   assert(sxu->matchesPattern(nlp->get_ixu()));
@@ -331,12 +354,11 @@ bool hiopIterate::takeStep_primals(const hiopIterate& iter, const hiopIterate& d
 }
 bool hiopIterate::takeStep_duals(const hiopIterate& iter, const hiopIterate& dir, const double& alphaprimal, const double& alphadual)
 {
-  yd->copyFrom(*iter.yd); yd->axpy(alphaprimal, *dir.yd);
-  yc->copyFrom(*iter.yc); yc->axpy(alphaprimal, *dir.yc);
-  zl->copyFrom(*iter.zl); zl->axpy(alphadual, *dir.zl);
-  zu->copyFrom(*iter.zu); zu->axpy(alphadual, *dir.zu);
-  vl->copyFrom(*iter.vl); vl->axpy(alphadual, *dir.vl);
-  vu->copyFrom(*iter.vu); vu->axpy(alphadual, *dir.vu);
+  //yc and yd take the primal step, the duals of the bounds take the dual step
+  const long long n_eq = nyc_+nd_, off = primals_size();
+  stepKernel(buffer_+off, iter.buffer_+off, dir.buffer_+off, alphaprimal, n_eq, nlp->get_omp_params());
+  stepKernel(bound_duals(), iter.bound_duals(), dir.bound_duals(), alphadual, duals_size()-n_eq,
+	     nlp->get_omp_params());
 #ifdef HIOP_DEEPCHECKS
   assert(zl->matchesPattern(nlp->get_ixl()));
   assert(zu->matchesPattern(nlp->get_ixu()));
@@ -385,18 +407,22 @@ bool hiopIterate::adjustDuals_primalLogHessian(const double& mu, const double& k
 
 double hiopIterate::evalLogBarrier() const
 {
-  double barrier;
-  barrier = sxl->logBarrier_local(nlp->get_ixl());
-  barrier+= sxu->logBarrier_local(nlp->get_ixu());
-#ifdef HIOP_USE_MPI
-  double res;
-  int ierr = MPI_Allreduce(&barrier, &res, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
-  barrier=res;
-#endif
-  barrier+= sdl->logBarrier_local(nlp->get_idl());
-  barrier+= sdu->logBarrier_local(nlp->get_idu());
+  hiopReductionPlan plan(nlp->get_comm());
+  const int idx = evalLogBarrier(plan);
+  plan.resolve();
+  return plan.get(idx);
+}
 
-  return barrier;
+int hiopIterate::evalLogBarrier(hiopReductionPlan& plan) const
+{
+  double barrier_x, barrier_d;
+  barrier_x = sxl->logBarrier_local(nlp->get_ixl());
+  barrier_x+= sxu->logBarrier_local(nlp->get_ixu());
+  //the slacks of d are replicated on all ranks
+  barrier_d = sdl->logBarrier_local(nlp->get_idl());
+  barrier_d+= sdu->logBarrier_local(nlp->get_idu());
+
+  return plan.add_sum(barrier_x, barrier_d);
 }
 
 
@@ -415,18 +441,22 @@ void  hiopIterate::addLogBarGrad_d(const double& mu, hiopVector& gradd) const
 
 double hiopIterate::linearDampingTerm(const double& mu, const double& kappa_d) const
 {
-  double term;
-  term  = sxl->linearDampingTerm_local(nlp->get_ixl(), nlp->get_ixu(), mu, kappa_d);
-  term += sxu->linearDampingTerm_local(nlp->get_ixu(), nlp->get_ixl(), mu, kappa_d);
-#ifdef HIOP_USE_MPI
-  double res;
-  int ierr = MPI_Allreduce(&term, &res, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
-  term = res;
-#endif  
-  term += sdl->linearDampingTerm_local(nlp->get_idl(), nlp->get_idu(), mu, kappa_d);
-  term += sdu->linearDampingTerm_local(nlp->get_idu(), nlp->get_idl(), mu, kappa_d);
-
-  return term;
+  hiopReductionPlan plan(nlp->get_comm());
+  const int idx = linearDampingTerm(plan, mu, kappa_d);
+  plan.resolve();
+  return plan.get(idx);
+}
+
+int hiopIterate::linearDampingTerm(hiopReductionPlan& plan, const double& mu, const double& kappa_d) const
+{
+  double term_x, term_d;
+  term_x  = sxl->linearDampingTerm_local(nlp->get_ixl(), nlp->get_ixu(), mu, kappa_d);
+  term_x += sxu->linearDampingTerm_local(nlp->get_ixu(), nlp->get_ixl(), mu, kappa_d);
+  //the slacks of d are replicated on all ranks
+  term_d  = sdl->linearDampingTerm_local(nlp->get_idl(), nlp->get_idu(), mu, kappa_d);
+  term_d += sdu->linearDampingTerm_local(nlp->get_idu(), nlp->get_idl(), mu, kappa_d);
+
+  return plan.add_sum(term_x, term_d);
 }
 
 void hiopIterate::addLinearDampingTermToGrad_x(const double& mu, const double& kappa_d, const double& beta, hiopVector& grad_x) const
@@ -51,10 +51,21 @@
 
 #include "hiopVector.hpp"
 #include "hiopNlpFormulation.hpp"
+#include "hiopReductionPlan.hpp"
 
 namespace hiop
 {
 
+/** The primal and dual variables of the filter IPM.
+ *
+ * The twelve components are views of a single contiguous buffer, laid out as
+ *   primals: [ x | d | sxl | sxu | sdl | sdu ]
+ *   duals:   [ yc | yd | zl | zu | vl | vu ]
+ * so that the steps, the copies, and the fraction-to-the-boundary rule are done in one sweep
+ * over contiguous memory, see 'takeStep_primals', 'takeStep_duals', 'copyFrom', and 
+ * 'fractionToTheBdry'. The slacks and the duals of the bounds are in the same order, hence 
+ * they share the patterns ixl, ixu, idl, idu segment by segment.
+ */
 class hiopIterate
 {
 public:
@@ -64,6 +75,8 @@ public:
   virtual void projectPrimalsXIntoBounds(double kappa1, double kappa2);
   virtual void projectPrimalsDIntoBounds(double kappa1, double kappa2);
   virtual void setBoundsDualsToConstant(const double& v);
+  /* sets to 'push' the entries of zl and zu that are smaller than 'push' (only for finite bounds) */
+  virtual void pushBoundsDualsAwayFromZero(const double& push);
   virtual void setEqualityDualsToConstant(const double& v);
   /** 
    * Computes the slacks given the primals: sxl=x-xl, sxu=xu-x, and similar 
@@ -94,6 +107,9 @@ public:
   virtual bool adjustDuals_primalLogHessian(const double& mu, const double& kappa_Sigma);
   /* compute the log-barrier term for the primal signed variables */
   virtual double evalLogBarrier() const;
+  /* same as above, but only adds the local contributions to 'plan' and returns the index of the
+   * slot holding the log-barrier term after 'plan.resolve()' is called */
+  virtual int evalLogBarrier(hiopReductionPlan& plan) const;
   /* add the derivative of the log-barier terms*/
   virtual void addLogBarGrad_x(const double& mu, hiopVector& gradx) const;
   virtual void addLogBarGrad_d(const double& mu, hiopVector& gradd) const;
@@ -102,6 +118,8 @@ public:
    * Computes the log barrier's linear damping term of the Filter-IPM method of WaectherBiegler (section 3.7) 
    */
   virtual double linearDampingTerm(const double& mu, const double& kappa_d) const;
+  /* same as above, but deferred to the resolution of 'plan'; returns the index of the slot */
+  virtual int linearDampingTerm(hiopReductionPlan& plan, const double& mu, const double& kappa_d) const;
   /* adds the damping term to the gradient */
   virtual void addLinearDampingTermToGrad_x(const double& mu, const double& kappa_d, const double& beta,
 					    hiopVector& grad_x) const;
@@ -113,6 +131,9 @@ public:
   virtual double normOneOfEqualityDuals() const;
   /* same as above but computed in one shot to save on communication and computation */
   virtual void   normOneOfDuals(double& nrm1Eq, double& nrm1Bnd) const;
+  /* same as above, but deferred to the resolution of 'plan'; the norms are in the slots with
+   * indexes 'idx_nrm1Eq' and 'idx_nrm1Bnd' */
+  virtual void   normOneOfDuals(hiopReductionPlan& plan, int& idx_nrm1Eq, int& idx_nrm1Bnd) const;
 
   /* cloning and copying */
   hiopIterate* alloc_clone() const;
@@ -134,6 +155,7 @@ public:
 
   friend class hiopResidual;
   friend class hiopKKTLinSys;
+  friend class hiopKKTLinSysCompressed;
   friend class hiopKKTLinSysCompressedXYcYd;
   friend class hiopKKTLinSysCompressedXDYcYd;
   friend class hiopKKTLinSysDenseXYcYd;
@@ -154,6 +176,16 @@ private:
   hiopVector*yd;       //for d(x)-d=0
   hiopVector*zl,*zu;   //for slacks eq. in x: x-sxl=xl, x+sxu=xu
   hiopVector*vl,*vu;   //for slack eq. in d, e.g., d-sdl=dl
+
+  /** storage of all the components above (see the class description) */
+  double* buffer_;
+  //local sizes of x, d, and yc
+  long long nx_, nd_, nyc_;
+  inline long long primals_size() const { return 3*(nx_+nd_); }
+  inline long long duals_size() const { return nyc_+nd_+2*(nx_+nd_); }
+  //the slacks sxl, sxu, sdl, sdu and the bound duals zl, zu, vl, vu start at
+  inline double* slacks() const { return buffer_ + nx_ + nd_; }
+  inline double* bound_duals() const { return buffer_ + primals_size() + nyc_ + nd_; }
 private:
   //associated info from problem formulation
   const hiopNlpFormulation * nlp;
@@ -184,6 +184,108 @@ double hiopKKTLinSys::errorKKT(const hiopResidual* resid, const hiopIterate* sol
 
 #endif
 
+bool hiopKKTLinSys::computeDirectionsBlock(const std::vector<const hiopResidual*>& resids, 
+					   const std::vector<hiopIterate*>& dirs)
+{
+  assert(resids.size() == dirs.size());
+  for(size_t k=0; k<resids.size(); k++) {
+    if(!computeDirections(resids[k], dirs[k])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+// hiopKKTLinSysCompressed
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+
+hiopKKTLinSysCompressed::~hiopKKTLinSysCompressed()
+{
+  delete Dx_;
+  delete rx_tilde_;
+  for(auto v : rx_tilde_blk_) {
+    delete v;
+  }
+}
+
+void hiopKKTLinSysCompressed::computeRemainingDirections(const hiopResidual& r, hiopIterate& dir)
+{
+  /***********************************************************************
+   * compute the rest of the directions
+   *
+   */
+  //dsxl = rxl + dx  and dzl= [Sxl]^{-1} ( - Zl*dsxl + rszl)
+  if(nlp_->n_low_local()) { 
+    dir.sxl->copyFrom(*r.rxl); dir.sxl->axpy( 1.0,*dir.x); dir.sxl->selectPattern(nlp_->get_ixl()); 
+
+    dir.zl->copyFrom(*r.rszl); dir.zl->axzpy(-1.0,*iter_->zl,*dir.sxl); 
+    dir.zl->componentDiv_w_selectPattern(*iter_->sxl, nlp_->get_ixl());
+  } else {
+    dir.sxl->setToZero(); dir.zl->setToZero();
+  }
+
+  //dir.sxl->print();
+  //dir.zl->print();
+  //dsxu = rxu - dx and dzu = [Sxu]^{-1} ( - Zu*dsxu + rszu)
+  if(nlp_->n_upp_local()) { 
+    dir.sxu->copyFrom(*r.rxu); dir.sxu->axpy(-1.0,*dir.x);
+    dir.sxu->selectPattern(nlp_->get_ixu()); 
+
+    dir.zu->copyFrom(*r.rszu); dir.zu->axzpy(-1.0,*iter_->zu,*dir.sxu);
+    dir.zu->selectPattern(nlp_->get_ixu());
+    dir.zu->componentDiv_w_selectPattern(*iter_->sxu, nlp_->get_ixu());
+  } else {
+    dir.sxu->setToZero(); dir.zu->setToZero();
+  }
+
+  //dir.sxu->print();
+  //dir.zu->print();
+  //dsdl = rdl + dd and dvl = [Sdl]^{-1} ( - Vl*dsdl + rsvl)
+  if(nlp_->m_ineq_low()) {
+    dir.sdl->copyFrom(*r.rdl); dir.sdl->axpy( 1.0,*dir.d);
+    dir.sdl->selectPattern(nlp_->get_idl());
+
+    dir.vl->copyFrom(*r.rsvl); dir.vl->axzpy(-1.0,*iter_->vl,*dir.sdl);
+    dir.vl->selectPattern(nlp_->get_idl());
+    dir.vl->componentDiv_w_selectPattern(*iter_->sdl, nlp_->get_idl());
+  } else {
+    dir.sdl->setToZero(); dir.vl->setToZero();
+  }
+
+  //dir.sdl->print();
+  // dir.vl->print();
+  //dsdu = rdu - dd and dvu = [Sdu]^{-1} ( - Vu*dsdu + rsvu )
+  if(nlp_->m_ineq_upp()>0) {
+    dir.sdu->copyFrom(*r.rdu); dir.sdu->axpy(-1.0,*dir.d);
+    dir.sdu->selectPattern(nlp_->get_idu());
+    
+    dir.vu->copyFrom(*r.rsvu); dir.vu->axzpy(-1.0,*iter_->vu,*dir.sdu);
+    dir.vu->selectPattern(nlp_->get_idu());
+    dir.vu->componentDiv_w_selectPattern(*iter_->sdu, nlp_->get_idu());
+  } else {
+    dir.sdu->setToZero(); dir.vu->setToZero();
+  }
+
+  //dir.sdu->print();
+  //dir.vu->print();
+#ifdef HIOP_DEEPCHECKS
+  assert(dir.sxl->matchesPattern(nlp_->get_ixl()));
+  assert(dir.sxu->matchesPattern(nlp_->get_ixu()));
+  assert(dir.sdl->matchesPattern(nlp_->get_idl()));
+  assert(dir.sdu->matchesPattern(nlp_->get_idu()));
+  assert(dir.zl->matchesPattern(nlp_->get_ixl()));
+  assert(dir.zu->matchesPattern(nlp_->get_ixu()));
+  assert(dir.vl->matchesPattern(nlp_->get_idl()));
+  assert(dir.vu->matchesPattern(nlp_->get_idu()));
+
+  //CHECK THE SOLUTION
+  errorKKT(&r, &dir);
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////
 // hiopKKTLinSysCompressedXYcYd
@@ -213,6 +315,9 @@ hiopKKTLinSysCompressedXYcYd::~hiopKKTLinSysCompressedXYcYd()
 {
   delete Dd_inv_;  
   delete ryd_tilde_;
+  for(auto v : ryd_tilde_blk_) {
+    delete v;
+  }
 }
 
 bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid, 
@@ -223,59 +328,7 @@ bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid,
 
   const hiopResidual &r=*resid; 
 
-  /***********************************************************************
-   * perform the reduction to the compressed linear system
-   * rx_tilde  = rx+Sxl^{-1}*[rszl-Zl*rxl] - Sxu^{-1}*(rszu-Zu*rxu)
-   * ryd_tilde = ryd + [(Sdl^{-1}Vl+Sdu^{-1}Vu)]^{-1}*
-   *                     [rd + Sdl^{-1}*(rsvl-Vl*rdl)-Sdu^{-1}(rsvu-Vu*rdu)]
-   */
-  rx_tilde_->copyFrom(*r.rx); 
-  if(nlp_->n_low_local()>0) {
-    // rl:=rszl-Zl*rxl (using dir->x as working buffer)
-    hiopVector&rl=*(dir->x);//temporary working buffer
-    rl.copyFrom(*r.rszl);
-    rl.axzpy(-1.0, *iter_->zl, *r.rxl);
-    //rx_tilde = rx+Sxl^{-1}*rl
-    rx_tilde_->axdzpy_w_pattern( 1.0, rl, *iter_->sxl, nlp_->get_ixl());
-  }
-  if(nlp_->n_upp_local()>0) {
-    //ru:=rszu-Zu*rxu (using dir->x as working buffer)
-    hiopVector&ru=*(dir->x);//temporary working buffer
-    ru.copyFrom(*r.rszu); ru.axzpy(-1.0,*iter_->zu, *r.rxu);
-    //rx_tilde = rx_tilde - Sxu^{-1}*ru
-    rx_tilde_->axdzpy_w_pattern(-1.0, ru, *iter_->sxu, nlp_->get_ixu());
-  }
-  
-  //for ryd_tilde: 
-  ryd_tilde_->copyFrom(*r.ryd);
-  // 1. the diag (Sdl^{-1}Vl+Sdu^{-1}Vu)^{-1} has already computed in Dd_inv in 'update'
-  // 2. compute the left multiplicand in ryd2 (using buffer dir->sdl), that is
-  //   ryd2 = [rd + Sdl^{-1}*(rsvl-Vl*rdl)-Sdu^{-1}(rsvu-Vu*rdu)] (this is \tilde{r}_d in the notes)
-  //    Inner ops are performed by accumulating in rd2  (buffer dir->sdu)
-  hiopVector&ryd2=*dir->sdl;
-  ryd2.copyFrom(*r.rd);
-  
-  if(nlp_->m_ineq_low()>0) {
-    hiopVector& rd2=*dir->sdu;
-    //rd2=rsvl-Vl*rdl
-    rd2.copyFrom(*r.rsvl); 
-    rd2.axzpy(-1.0, *iter_->vl, *r.rdl);
-    //ryd2 +=  Sdl^{-1}*(rsvl-Vl*rdl)
-    ryd2.axdzpy_w_pattern(1.0, rd2, *iter_->sdl, nlp_->get_idl());
-  }
-  if(nlp_->m_ineq_upp()>0) {
-    hiopVector& rd2=*dir->sdu;
-    //rd2=rsvu-Vu*rdu
-    rd2.copyFrom(*r.rsvu); 
-    rd2.axzpy(-1.0, *iter_->vu, *r.rdu);
-    //ryd2 += -Sdu^{-1}(rsvu-Vu*rdu)
-    ryd2.axdzpy_w_pattern(-1.0, rd2, *iter_->sdu, nlp_->get_idu());
-  }
-
-  nlp_->log->write("Dinv (in computeDirections)", *Dd_inv_, hovMatrices);
-
-  //now the final ryd_tilde += Dd^{-1}*ryd2
-  ryd_tilde_->axzpy(1.0, ryd2, *Dd_inv_);
+  formCompressedRhs(r, *dir, *rx_tilde_, *ryd_tilde_);
 
 #ifdef HIOP_DEEPCHECKS
   hiopVector* rx_tilde_save=rx_tilde_->new_copy();
@@ -292,6 +345,7 @@ bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid,
 
   nlp_->runStats.kkt.tmSolveRhsManip.start();
   //recover dir->d = (D)^{-1}*(dir->yd + ryd2)
+  hiopVector& ryd2=*dir->sdl;
   dir->d->copyFrom(ryd2);
   dir->d->axpy(1.0,*dir->yd);
   dir->d->componentMult(*Dd_inv_);
@@ -309,82 +363,149 @@ bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid,
     return false;
   }
 
-  /***********************************************************************
-   * compute the rest of the directions
-   *
-   */
-  //dsxl = rxl + dx  and dzl= [Sxl]^{-1} ( - Zl*dsxl + rszl)
-  if(nlp_->n_low_local()) { 
-    dir->sxl->copyFrom(*r.rxl); dir->sxl->axpy( 1.0,*dir->x); dir->sxl->selectPattern(nlp_->get_ixl()); 
-
-    dir->zl->copyFrom(*r.rszl); dir->zl->axzpy(-1.0,*iter_->zl,*dir->sxl); 
-    dir->zl->componentDiv_w_selectPattern(*iter_->sxl, nlp_->get_ixl());
-  } else {
-    dir->sxl->setToZero(); dir->zl->setToZero();
-  }
+  computeRemainingDirections(r, *dir);
 
-  //dir->sxl->print();
-  //dir->zl->print();
-  //dsxu = rxu - dx and dzu = [Sxu]^{-1} ( - Zu*dsxu + rszu)
-  if(nlp_->n_upp_local()) { 
-    dir->sxu->copyFrom(*r.rxu); dir->sxu->axpy(-1.0,*dir->x);
-    dir->sxu->selectPattern(nlp_->get_ixu()); 
+  nlp_->runStats.kkt.tmSolveRhsManip.stop();
+  nlp_->runStats.tmSolverInternal.stop();
+  return true;
+}
 
-    dir->zu->copyFrom(*r.rszu); dir->zu->axzpy(-1.0,*iter_->zu,*dir->sxu);
-    dir->zu->selectPattern(nlp_->get_ixu());
-    dir->zu->componentDiv_w_selectPattern(*iter_->sxu, nlp_->get_ixu());
-  } else {
-    dir->sxu->setToZero(); dir->zu->setToZero();
+bool hiopKKTLinSysCompressedXYcYd::
+computeDirectionsBlock(const std::vector<const hiopResidual*>& resids, 
+		       const std::vector<hiopIterate*>& dirs)
+{
+  assert(resids.size() == dirs.size());
+  const size_t nrhs = resids.size();
+  if(nrhs<=1) {
+    return nrhs==0 ? true : computeDirections(resids[0], dirs[0]);
   }
 
-  //dir->sxu->print();
-  //dir->zu->print();
-  //dsdl = rdl + dd and dvl = [Sdl]^{-1} ( - Vl*dsdl + rsvl)
-  if(nlp_->m_ineq_low()) {
-    dir->sdl->copyFrom(*r.rdl); dir->sdl->axpy( 1.0,*dir->d);
-    dir->sdl->selectPattern(nlp_->get_idl());
+  nlp_->runStats.tmSolverInternal.start();
+  nlp_->runStats.kkt.tmSolveRhsManip.start();
 
-    dir->vl->copyFrom(*r.rsvl); dir->vl->axzpy(-1.0,*iter_->vl,*dir->sdl);
-    dir->vl->selectPattern(nlp_->get_idl());
-    dir->vl->componentDiv_w_selectPattern(*iter_->sdl, nlp_->get_idl());
-  } else {
-    dir->sdl->setToZero(); dir->vl->setToZero();
+  //the first right-hand side uses the internal buffers of the single rhs solve
+  while(rx_tilde_blk_.size()<nrhs-1) {
+    rx_tilde_blk_.push_back(rx_tilde_->alloc_clone());
+    ryd_tilde_blk_.push_back(ryd_tilde_->alloc_clone());
   }
-
-  //dir->sdl->print();
-  // dir->vl->print();
-  //dsdu = rdu - dd and dvu = [Sdu]^{-1} ( - Vu*dsdu + rsvu )
-  if(nlp_->m_ineq_upp()>0) {
-    dir->sdu->copyFrom(*r.rdu); dir->sdu->axpy(-1.0,*dir->d);
-    dir->sdu->selectPattern(nlp_->get_idu());
-    
-    dir->vu->copyFrom(*r.rsvu); dir->vu->axzpy(-1.0,*iter_->vu,*dir->sdu);
-    dir->vu->selectPattern(nlp_->get_idu());
-    dir->vu->componentDiv_w_selectPattern(*iter_->sdu, nlp_->get_idu());
-  } else {
-    dir->sdu->setToZero(); dir->vu->setToZero();
+  std::vector<hiopVector*> rx(nrhs), ryc(nrhs), ryd(nrhs), dx(nrhs), dyc(nrhs), dyd(nrhs);
+  for(size_t k=0; k<nrhs; k++) {
+    rx[k]  = k==0 ? rx_tilde_  : rx_tilde_blk_[k-1];
+    ryd[k] = k==0 ? ryd_tilde_ : ryd_tilde_blk_[k-1];
+    ryc[k] = resids[k]->ryc;
+    dx[k]  = dirs[k]->x;
+    dyc[k] = dirs[k]->yc;
+    dyd[k] = dirs[k]->yd;
+
+    formCompressedRhs(*resids[k], *dirs[k], *rx[k], *ryd[k]);
   }
-
-  //dir->sdu->print();
-  //dir->vu->print();
 #ifdef HIOP_DEEPCHECKS
-  assert(dir->sxl->matchesPattern(nlp_->get_ixl()));
-  assert(dir->sxu->matchesPattern(nlp_->get_ixu()));
-  assert(dir->sdl->matchesPattern(nlp_->get_idl()));
-  assert(dir->sdu->matchesPattern(nlp_->get_idu()));
-  assert(dir->zl->matchesPattern(nlp_->get_ixl()));
-  assert(dir->zu->matchesPattern(nlp_->get_ixu()));
-  assert(dir->vl->matchesPattern(nlp_->get_idl()));
-  assert(dir->vu->matchesPattern(nlp_->get_idu()));
+  std::vector<hiopVector*> rx_save(nrhs), ryc_save(nrhs), ryd_save(nrhs);
+  for(size_t k=0; k<nrhs; k++) {
+    rx_save[k]  = rx[k]->new_copy();
+    ryc_save[k] = ryc[k]->new_copy();
+    ryd_save[k] = ryd[k]->new_copy();
+  }
+#endif
+  nlp_->runStats.kkt.tmSolveRhsManip.stop();
 
-  //CHECK THE SOLUTION
-  errorKKT(resid,dir);
+  bool sol_ok = solveCompressedBlock(rx, ryc, ryd, dx, dyc, dyd);
+
+  nlp_->runStats.kkt.tmSolveRhsManip.start();
+#ifdef HIOP_DEEPCHECKS
+  for(size_t k=0; k<nrhs; k++) {
+    if(sol_ok) {
+      errorCompressedLinsys(*rx_save[k], *ryc_save[k], *ryd_save[k], *dx[k], *dyc[k], *dyd[k]);
+    }
+    delete rx_save[k];
+    delete ryc_save[k];
+    delete ryd_save[k];
+  }
 #endif
+  for(size_t k=0; k<nrhs && sol_ok; k++) {
+    hiopIterate* dir = dirs[k];
+    //recover dir->d = (D)^{-1}*(dir->yd + ryd2)
+    dir->d->copyFrom(*dir->sdl);
+    dir->d->axpy(1.0,*dir->yd);
+    dir->d->componentMult(*Dd_inv_);
+
+    computeRemainingDirections(*resids[k], *dir);
+  }
   nlp_->runStats.kkt.tmSolveRhsManip.stop();
   nlp_->runStats.tmSolverInternal.stop();
+  return sol_ok;
+}
+
+bool hiopKKTLinSysCompressedXYcYd::
+solveCompressedBlock(std::vector<hiopVector*>& rx, std::vector<hiopVector*>& ryc, std::vector<hiopVector*>& ryd,
+		     std::vector<hiopVector*>& dx, std::vector<hiopVector*>& dyc, std::vector<hiopVector*>& dyd)
+{
+  for(size_t k=0; k<rx.size(); k++) {
+    if(!solveCompressed(*rx[k], *ryc[k], *ryd[k], *dx[k], *dyc[k], *dyd[k])) {
+      return false;
+    }
+  }
   return true;
 }
 
+void hiopKKTLinSysCompressedXYcYd::formCompressedRhs(const hiopResidual& r, hiopIterate& dir,
+						     hiopVector& rx_tilde, hiopVector& ryd_tilde)
+{
+  /***********************************************************************
+   * perform the reduction to the compressed linear system
+   * rx_tilde  = rx+Sxl^{-1}*[rszl-Zl*rxl] - Sxu^{-1}*(rszu-Zu*rxu)
+   * ryd_tilde = ryd + [(Sdl^{-1}Vl+Sdu^{-1}Vu)]^{-1}*
+   *                     [rd + Sdl^{-1}*(rsvl-Vl*rdl)-Sdu^{-1}(rsvu-Vu*rdu)]
+   */
+  rx_tilde.copyFrom(*r.rx); 
+  if(nlp_->n_low_local()>0) {
+    // rl:=rszl-Zl*rxl (using dir.x as working buffer)
+    hiopVector&rl=*(dir.x);//temporary working buffer
+    rl.copyFrom(*r.rszl);
+    rl.axzpy(-1.0, *iter_->zl, *r.rxl);
+    //rx_tilde = rx+Sxl^{-1}*rl
+    rx_tilde.axdzpy_w_pattern( 1.0, rl, *iter_->sxl, nlp_->get_ixl());
+  }
+  if(nlp_->n_upp_local()>0) {
+    //ru:=rszu-Zu*rxu (using dir.x as working buffer)
+    hiopVector&ru=*(dir.x);//temporary working buffer
+    ru.copyFrom(*r.rszu); ru.axzpy(-1.0,*iter_->zu, *r.rxu);
+    //rx_tilde = rx_tilde - Sxu^{-1}*ru
+    rx_tilde.axdzpy_w_pattern(-1.0, ru, *iter_->sxu, nlp_->get_ixu());
+  }
+  
+  //for ryd_tilde: 
+  ryd_tilde.copyFrom(*r.ryd);
+  // 1. the diag (Sdl^{-1}Vl+Sdu^{-1}Vu)^{-1} has already computed in Dd_inv in 'update'
+  // 2. compute the left multiplicand in ryd2 (using buffer dir.sdl), that is
+  //   ryd2 = [rd + Sdl^{-1}*(rsvl-Vl*rdl)-Sdu^{-1}(rsvu-Vu*rdu)] (this is \tilde{r}_d in the notes)
+  //    Inner ops are performed by accumulating in rd2  (buffer dir.sdu)
+  hiopVector&ryd2=*dir.sdl;
+  ryd2.copyFrom(*r.rd);
+  
+  if(nlp_->m_ineq_low()>0) {
+    hiopVector& rd2=*dir.sdu;
+    //rd2=rsvl-Vl*rdl
+    rd2.copyFrom(*r.rsvl); 
+    rd2.axzpy(-1.0, *iter_->vl, *r.rdl);
+    //ryd2 +=  Sdl^{-1}*(rsvl-Vl*rdl)
+    ryd2.axdzpy_w_pattern(1.0, rd2, *iter_->sdl, nlp_->get_idl());
+  }
+  if(nlp_->m_ineq_upp()>0) {
+    hiopVector& rd2=*dir.sdu;
+    //rd2=rsvu-Vu*rdu
+    rd2.copyFrom(*r.rsvu); 
+    rd2.axzpy(-1.0, *iter_->vu, *r.rdu);
+    //ryd2 += -Sdu^{-1}(rsvu-Vu*rdu)
+    ryd2.axdzpy_w_pattern(-1.0, rd2, *iter_->sdu, nlp_->get_idu());
+  }
+
+  nlp_->log->write("Dinv (in computeDirections)", *Dd_inv_, hovMatrices);
+
+  //now the final ryd_tilde += Dd^{-1}*ryd2
+  ryd_tilde.axzpy(1.0, ryd2, *Dd_inv_);
+}
+
 #ifdef HIOP_DEEPCHECKS
 //this method needs a bit of revisiting if becomes critical (mainly avoid dynamic allocations)
 double hiopKKTLinSysCompressedXYcYd::
@@ -466,6 +587,9 @@ hiopKKTLinSysCompressedXDYcYd::~hiopKKTLinSysCompressedXDYcYd()
 {
   delete Dd_;  
   delete rd_tilde_;
+  for(auto v : rd_tilde_blk_) {
+    delete v;
+  }
 }
 
 bool hiopKKTLinSysCompressedXDYcYd::computeDirections(const hiopResidual* resid, 
@@ -476,50 +600,7 @@ bool hiopKKTLinSysCompressedXDYcYd::computeDirections(const hiopResidual* resid,
 
   const hiopResidual &r=*resid; 
 
-  /***********************************************************************
-   * perform the reduction to the compressed linear system
-   * rx_tilde = rx+Sxl^{-1}*[rszl-Zl*rxl] - Sxu^{-1}*(rszu-Zu*rxu)
-   * rd_tilde = rd + Sdl^{-1}*(rsvl-Vl*rdl)-Sdu^{-1}(rsvu-Vu*rdu)
-   *
-   * rd_tilde = ryd + [(Sdl^{-1}Vl+Sdu^{-1}Vu)]^{-1}*
-   *                     [rd + Sdl^{-1}*(rsvl-Vl*rdl)-Sdu^{-1}(rsvu-Vu*rdu)]
-   */
-  rx_tilde_->copyFrom(*r.rx); 
-  if(nlp_->n_low_local()) {
-    // rl:=rszl-Zl*rxl (using dir->x as working buffer)
-    hiopVector &rl=*(dir->x);//temporary working buffer
-    rl.copyFrom(*r.rszl);
-    rl.axzpy(-1.0, *iter_->zl, *r.rxl);
-    //rx_tilde = rx+Sxl^{-1}*rl
-    rx_tilde_->axdzpy_w_pattern( 1.0, rl, *iter_->sxl, nlp_->get_ixl());
-  }
-  if(nlp_->n_upp_local()) {
-    //ru:=rszu-Zu*rxu (using dir->x as working buffer)
-    hiopVector &ru=*(dir->x);//temporary working buffer
-    ru.copyFrom(*r.rszu); ru.axzpy(-1.0,*iter_->zu, *r.rxu);
-    //rx_tilde = rx_tilde - Sxu^{-1}*ru
-    rx_tilde_->axdzpy_w_pattern(-1.0, ru, *iter_->sxu, nlp_->get_ixu());
-  }
-  
-  //for rd_tilde = rd + Sdl^{-1}*(rsvl-Vl*rdl)-Sdu^{-1}(rsvu-Vu*rdu)
-  rd_tilde_->copyFrom(*r.rd);
-  if(nlp_->m_ineq_low()) {
-    hiopVector& rd2=*dir->sdu;
-    //rd2=rsvl-Vl*rdl
-    rd2.copyFrom(*r.rsvl); 
-    rd2.axzpy(-1.0, *iter_->vl, *r.rdl);
-    //rd_tilde +=  Sdl^{-1}*(rsvl-Vl*rdl)
-    rd_tilde_->axdzpy_w_pattern(1.0, rd2, *iter_->sdl, nlp_->get_idl());
-  }
-  if(nlp_->m_ineq_upp()>0) {
-    hiopVector& rd2=*dir->sdu;
-    //rd2=rsvu-Vu*rdu
-    rd2.copyFrom(*r.rsvu); 
-    rd2.axzpy(-1.0, *iter_->vu, *r.rdu);
-    //rd_tilde += -Sdu^{-1}(rsvu-Vu*rdu)
-    rd_tilde_->axdzpy_w_pattern(-1.0, rd2, *iter_->sdu, nlp_->get_idu());
-  }
-  nlp_->log->write("Dd (in computeDirections)", *Dd_, hovMatrices);
+  formCompressedRhs(r, *dir, *rx_tilde_, *rd_tilde_);
 
 #ifdef HIOP_DEEPCHECKS
   hiopVector* rx_tilde_save = rx_tilde_->new_copy();
@@ -552,84 +633,143 @@ bool hiopKKTLinSysCompressedXDYcYd::computeDirections(const hiopResidual* resid,
 
   if(false==sol_ok) return sol_ok;
 
-  /***********************************************************************
-   * compute the rest of the directions
-   *
-   */
-  //dsxl = rxl + dx  and dzl= [Sxl]^{-1} ( - Zl*dsxl + rszl)
-  if(nlp_->n_low_local()) { 
-    dir->sxl->copyFrom(*r.rxl); dir->sxl->axpy( 1.0,*dir->x); dir->sxl->selectPattern(nlp_->get_ixl()); 
+  computeRemainingDirections(r, *dir);
 
-    dir->zl->copyFrom(*r.rszl); dir->zl->axzpy(-1.0,*iter_->zl,*dir->sxl); 
-    dir->zl->componentDiv_w_selectPattern(*iter_->sxl, nlp_->get_ixl());
-  } else {
-    dir->sxl->setToZero(); dir->zl->setToZero();
-  }
+  nlp_->runStats.kkt.tmSolveRhsManip.stop();
+  nlp_->runStats.tmSolverInternal.stop();
+  return true;
+}
 
-  //dir->sxl->print();
-  //dir->zl->print();
-  //dsxu = rxu - dx and dzu = [Sxu]^{-1} ( - Zu*dsxu + rszu)
-  if(nlp_->n_upp_local()) { 
-    dir->sxu->copyFrom(*r.rxu);
-    dir->sxu->axpy(-1.0,*dir->x);
-    dir->sxu->selectPattern(nlp_->get_ixu()); 
-
-    dir->zu->copyFrom(*r.rszu);
-    dir->zu->axzpy(-1.0,*iter_->zu,*dir->sxu);
-    dir->zu->selectPattern(nlp_->get_ixu());
-    dir->zu->componentDiv_w_selectPattern(*iter_->sxu, nlp_->get_ixu());
-  } else {
-    dir->sxu->setToZero(); dir->zu->setToZero();
+bool hiopKKTLinSysCompressedXDYcYd::
+computeDirectionsBlock(const std::vector<const hiopResidual*>& resids, 
+		       const std::vector<hiopIterate*>& dirs)
+{
+  assert(resids.size() == dirs.size());
+  const size_t nrhs = resids.size();
+  if(nrhs<=1) {
+    return nrhs==0 ? true : computeDirections(resids[0], dirs[0]);
   }
 
-  //dir->sxu->print();
-  //dir->zu->print();
-  //dsdl = rdl + dd and dvl = [Sdl]^{-1} ( - Vl*dsdl + rsvl)
-  if(nlp_->m_ineq_low()) {
-    dir->sdl->copyFrom(*r.rdl);
-    dir->sdl->axpy( 1.0,*dir->d);
-    dir->sdl->selectPattern(nlp_->get_idl());
-
-    dir->vl->copyFrom(*r.rsvl);
-    dir->vl->axzpy(-1.0,*iter_->vl,*dir->sdl);
-    dir->vl->selectPattern(nlp_->get_idl());
-    dir->vl->componentDiv_w_selectPattern(*iter_->sdl, nlp_->get_idl());
-  } else {
-    dir->sdl->setToZero(); dir->vl->setToZero();
-  }
+  nlp_->runStats.tmSolverInternal.start();
+  nlp_->runStats.kkt.tmSolveRhsManip.start();
 
-  //dsdu = rdu - dd and dvu = [Sdu]^{-1} ( - Vu*dsdu + rsvu )
-  if(nlp_->m_ineq_upp()>0) {
-    dir->sdu->copyFrom(*r.rdu);
-    dir->sdu->axpy(-1.0,*dir->d);
-    dir->sdu->selectPattern(nlp_->get_idu());
-    
-    dir->vu->copyFrom(*r.rsvu);
-    dir->vu->axzpy(-1.0,*iter_->vu,*dir->sdu);
-    dir->vu->selectPattern(nlp_->get_idu());
-    dir->vu->componentDiv_w_selectPattern(*iter_->sdu, nlp_->get_idu());
-  } else {
-    dir->sdu->setToZero(); dir->vu->setToZero();
+  //the first right-hand side uses the internal buffers of the single rhs solve
+  while(rx_tilde_blk_.size()<nrhs-1) {
+    rx_tilde_blk_.push_back(rx_tilde_->alloc_clone());
+    rd_tilde_blk_.push_back(rd_tilde_->alloc_clone());
+  }
+  std::vector<hiopVector*> rx(nrhs), rd(nrhs), ryc(nrhs), ryd(nrhs);
+  std::vector<hiopVector*> dx(nrhs), dd(nrhs), dyc(nrhs), dyd(nrhs);
+  for(size_t k=0; k<nrhs; k++) {
+    rx[k]  = k==0 ? rx_tilde_ : rx_tilde_blk_[k-1];
+    rd[k]  = k==0 ? rd_tilde_ : rd_tilde_blk_[k-1];
+    ryc[k] = resids[k]->ryc;
+    ryd[k] = resids[k]->ryd;
+    dx[k]  = dirs[k]->x;
+    dd[k]  = dirs[k]->d;
+    dyc[k] = dirs[k]->yc;
+    dyd[k] = dirs[k]->yd;
+
+    formCompressedRhs(*resids[k], *dirs[k], *rx[k], *rd[k]);
   }
-
 #ifdef HIOP_DEEPCHECKS
-  assert(dir->sxl->matchesPattern(nlp_->get_ixl()));
-  assert(dir->sxu->matchesPattern(nlp_->get_ixu()));
-  assert(dir->sdl->matchesPattern(nlp_->get_idl()));
-  assert(dir->sdu->matchesPattern(nlp_->get_idu()));
-  assert(dir->zl->matchesPattern(nlp_->get_ixl()));
-  assert(dir->zu->matchesPattern(nlp_->get_ixu()));
-  assert(dir->vl->matchesPattern(nlp_->get_idl()));
-  assert(dir->vu->matchesPattern(nlp_->get_idu()));
+  std::vector<hiopVector*> rx_save(nrhs), rd_save(nrhs), ryc_save(nrhs), ryd_save(nrhs);
+  for(size_t k=0; k<nrhs; k++) {
+    rx_save[k]  = rx[k]->new_copy();
+    rd_save[k]  = rd[k]->new_copy();
+    ryc_save[k] = ryc[k]->new_copy();
+    ryd_save[k] = ryd[k]->new_copy();
+  }
+#endif
+  nlp_->runStats.kkt.tmSolveRhsManip.stop();
 
-  //CHECK THE SOLUTION
-  errorKKT(resid,dir);
+  bool sol_ok = solveCompressedBlock(rx, rd, ryc, ryd, dx, dd, dyc, dyd);
+
+#ifdef HIOP_DEEPCHECKS
+  for(size_t k=0; k<nrhs; k++) {
+    if(sol_ok) {
+      double derr = errorCompressedLinsys(*rx_save[k], *rd_save[k], *ryc_save[k], *ryd_save[k],
+					  *dx[k], *dd[k], *dyc[k], *dyd[k]);
+      if(derr>1e-8)
+	nlp_->log->printf(hovWarning, "solve compressed high absolute resid norm (=%12.5e) for "
+			  "rhs %d\n", derr, (int)k);
+    }
+    delete rx_save[k];
+    delete rd_save[k];
+    delete ryc_save[k];
+    delete ryd_save[k];
+  }
 #endif
+
+  nlp_->runStats.kkt.tmSolveRhsManip.start();
+  for(size_t k=0; k<nrhs && sol_ok; k++) {
+    computeRemainingDirections(*resids[k], *dirs[k]);
+  }
   nlp_->runStats.kkt.tmSolveRhsManip.stop();
   nlp_->runStats.tmSolverInternal.stop();
+  return sol_ok;
+}
+
+bool hiopKKTLinSysCompressedXDYcYd::
+solveCompressedBlock(std::vector<hiopVector*>& rx, std::vector<hiopVector*>& rd, 
+		     std::vector<hiopVector*>& ryc, std::vector<hiopVector*>& ryd,
+		     std::vector<hiopVector*>& dx, std::vector<hiopVector*>& dd, 
+		     std::vector<hiopVector*>& dyc, std::vector<hiopVector*>& dyd)
+{
+  for(size_t k=0; k<rx.size(); k++) {
+    if(!solveCompressed(*rx[k], *rd[k], *ryc[k], *ryd[k], *dx[k], *dd[k], *dyc[k], *dyd[k])) {
+      return false;
+    }
+  }
   return true;
 }
 
+void hiopKKTLinSysCompressedXDYcYd::formCompressedRhs(const hiopResidual& r, hiopIterate& dir,
+						      hiopVector& rx_tilde, hiopVector& rd_tilde)
+{
+  /***********************************************************************
+   * perform the reduction to the compressed linear system
+   * rx_tilde = rx+Sxl^{-1}*[rszl-Zl*rxl] - Sxu^{-1}*(rszu-Zu*rxu)
+   * rd_tilde = rd + Sdl^{-1}*(rsvl-Vl*rdl)-Sdu^{-1}(rsvu-Vu*rdu)
+   */
+  rx_tilde.copyFrom(*r.rx); 
+  if(nlp_->n_low_local()) {
+    // rl:=rszl-Zl*rxl (using dir.x as working buffer)
+    hiopVector &rl=*(dir.x);//temporary working buffer
+    rl.copyFrom(*r.rszl);
+    rl.axzpy(-1.0, *iter_->zl, *r.rxl);
+    //rx_tilde = rx+Sxl^{-1}*rl
+    rx_tilde.axdzpy_w_pattern( 1.0, rl, *iter_->sxl, nlp_->get_ixl());
+  }
+  if(nlp_->n_upp_local()) {
+    //ru:=rszu-Zu*rxu (using dir.x as working buffer)
+    hiopVector &ru=*(dir.x);//temporary working buffer
+    ru.copyFrom(*r.rszu); ru.axzpy(-1.0,*iter_->zu, *r.rxu);
+    //rx_tilde = rx_tilde - Sxu^{-1}*ru
+    rx_tilde.axdzpy_w_pattern(-1.0, ru, *iter_->sxu, nlp_->get_ixu());
+  }
+  
+  //for rd_tilde = rd + Sdl^{-1}*(rsvl-Vl*rdl)-Sdu^{-1}(rsvu-Vu*rdu)
+  rd_tilde.copyFrom(*r.rd);
+  if(nlp_->m_ineq_low()) {
+    hiopVector& rd2=*dir.sdu;
+    //rd2=rsvl-Vl*rdl
+    rd2.copyFrom(*r.rsvl); 
+    rd2.axzpy(-1.0, *iter_->vl, *r.rdl);
+    //rd_tilde +=  Sdl^{-1}*(rsvl-Vl*rdl)
+    rd_tilde.axdzpy_w_pattern(1.0, rd2, *iter_->sdl, nlp_->get_idl());
+  }
+  if(nlp_->m_ineq_upp()>0) {
+    hiopVector& rd2=*dir.sdu;
+    //rd2=rsvu-Vu*rdu
+    rd2.copyFrom(*r.rsvu); 
+    rd2.axzpy(-1.0, *iter_->vu, *r.rdu);
+    //rd_tilde += -Sdu^{-1}(rsvu-Vu*rdu)
+    rd_tilde.axdzpy_w_pattern(-1.0, rd2, *iter_->sdu, nlp_->get_idu());
+  }
+  nlp_->log->write("Dd (in computeDirections)", *Dd_, hovMatrices);
+}
+
 #ifdef HIOP_DEEPCHECKS
 double hiopKKTLinSysCompressedXDYcYd::
 errorCompressedLinsys(const hiopVector& rx, const hiopVector& rd,
@@ -702,8 +842,16 @@ hiopKKTLinSysLowRank::hiopKKTLinSysLowRank(hiopNlpFormulation* nlp)
 {
   nlpD = dynamic_cast<hiopNlpDenseConstraints*>(nlp_);
 
-  _kxn_mat = nlpD->alloc_multivector_primal(nlpD->m()); //!opt
+  _kxn_mat = NULL; //allocated or set as a view in 'update'
+  _kxn_mat_is_view = false;
   N = LinearAlgebraFactory::createMatrixDense(nlpD->m(),nlpD->m());
+  N_equil_ = N->alloc_clone();
+  const int k = nlpD->m();
+  N_fact_ = new double[k*k];
+  N_scal_ = new double[k];
+  N_equed_ = 'N';
+  N_work_ = new double[3*k];
+  N_iwork_ = new int[k];
 #ifdef HIOP_DEEPCHECKS
   Nmat=N->alloc_clone();
 #endif
@@ -713,6 +861,11 @@ hiopKKTLinSysLowRank::hiopKKTLinSysLowRank(hiopNlpFormulation* nlp)
 hiopKKTLinSysLowRank::~hiopKKTLinSysLowRank()
 {
   if(N)         delete N;
+  delete N_equil_;
+  delete[] N_fact_;
+  delete[] N_scal_;
+  delete[] N_work_;
+  delete[] N_iwork_;
 #ifdef HIOP_DEEPCHECKS
   if(Nmat)      delete Nmat;
 #endif
@@ -726,6 +879,7 @@ update(const hiopIterate* iter,
        const hiopMatrixDense* Jac_c, const hiopMatrixDense* Jac_d, 
        hiopHessianLowRank* Hess)
 {
+  hiopProfRegion prof_update(nlp_->prof, "kkt.update");
   nlp_->runStats.tmSolverInternal.start();
 
   iter_=iter;
@@ -734,6 +888,9 @@ update(const hiopIterate* iter,
   //Hess = dynamic_cast<hiopHessianInvLowRank*>(Hess_);
   Hess_=HessLowRank=Hess;
 
+  //the stacked Jacobian is a view when the rows of Jac_d are stored right after those of Jac_c
+  nlpD->stack_Jac_c_d(*Jac_c, *Jac_d, _kxn_mat, _kxn_mat_is_view);
+
   //compute the diagonals
   //Dx=(Sxl)^{-1}Zl + (Sxu)^{-1}Zu
   Dx_->setToZero();
@@ -755,9 +912,57 @@ update(const hiopIterate* iter,
   nlp_->runStats.tmSolverInternal.stop();
 
   nlp_->log->write("Dd_inv in KKT", *Dd_inv_, hovMatrices);
+
+  factorizeN();
   return true;
 }
 
+/* Forms N = J*(H+Dx)^{-1}*J' + [0 0; 0 Dd^{-1}] and factorizes it (equilibrated) */
+void hiopKKTLinSysLowRank::factorizeN()
+{
+  //set to [Jc;Jd] by 'update'
+  hiopMatrixDense& J = *_kxn_mat;
+
+  //N =  J*(Hess\J')
+  //Hess->symmetricTimesMat(0.0, *N, 1.0, J);
+  HessLowRank->symMatTimesInverseTimesMatTrans(0.0, *N, 1.0, J);
+
+  //subdiag of N += 1., Dd_inv
+  N->addSubDiagonal(1., nlp_->m_eq(), *Dd_inv_);
+#ifdef HIOP_DEEPCHECKS
+  assert(J.isfinite());
+  nlp_->log->write("factorizeN: N is", *N, hovMatrices);
+  nlp_->log->printf(hovLinAlgScalars, "inf norm of Dd_inv is %g\n", Dd_inv_->infnorm());
+  N->assertSymmetry(1e-10);
+  Nmat->copyFrom(*N);
+#endif
+
+  int k = N->n();
+  if(k<=0) return;
+
+  //equilibrate and factorize (no right-hand side); DPOSVX overwrites its input with the 
+  //equilibrated matrix, which is needed by the subsequent solves
+  N_equil_->copyFrom(*N);
+  char FACT='E', UPLO='L';
+  int NRHS=0, LDA=k, LDAF=k, LDB=k, LDX=k, INFO;
+  double RCOND, FERR, BERR, dummy_rhs, dummy_sol;
+  N_equed_ = 'N';
+  DPOSVX(&FACT, &UPLO, &k, &NRHS,
+	 N_equil_->local_buffer(), &LDA,
+	 N_fact_, &LDAF,
+	 &N_equed_,
+	 N_scal_,
+	 &dummy_rhs, &LDB,
+	 &dummy_sol, &LDX,
+	 &RCOND, &FERR, &BERR,
+	 N_work_, N_iwork_,
+	 &INFO);
+  if(INFO!=0) {
+    nlp_->log->printf(hovWarning, "hiopKKTLinSysLowRank::factorizeN: dposvx returned %d (rcond=%g)\n",
+		      INFO, RCOND);
+  }
+}
+
 
 /* Solves the system corresponding to directions for x, yc, and yd, namely
  * [ H_BFGS + Dx   Jc^T  Jd^T   ] [ dx]   [ rx  ]
@@ -776,6 +981,7 @@ bool hiopKKTLinSysLowRank::
 solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 		hiopVector& dx, hiopVector& dyc, hiopVector& dyd)
 {
+  hiopProfRegion prof_solve(nlp_->prof, "kkt.solve");
 #ifdef HIOP_DEEPCHECKS
   //some outputing
   nlp_->log->write("KKT Low rank: solve compressed RHS", hovIteration);
@@ -786,24 +992,10 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
   assert(Dd_inv_->isfinite_local() && "Something bad happened: nan or inf value");
 #endif
 
+  //N and its factorization were computed in 'update'
   hiopMatrixDense& J = *_kxn_mat;
-  const hiopMatrixDense* Jac_c_de = dynamic_cast<const hiopMatrixDense*>(Jac_c_); assert(Jac_c_de);
-  const hiopMatrixDense* Jac_d_de = dynamic_cast<const hiopMatrixDense*>(Jac_d_); assert(Jac_d_de);
-  J.copyRowsFrom(*Jac_c_de, nlp_->m_eq(), 0); //!opt
-  J.copyRowsFrom(*Jac_d_de, nlp_->m_ineq(), nlp_->m_eq());//!opt
-
-  //N =  J*(Hess\J')
-  //Hess->symmetricTimesMat(0.0, *N, 1.0, J);
-  HessLowRank->symMatTimesInverseTimesMatTrans(0.0, *N, 1.0, J);
-
-  //subdiag of N += 1., Dd_inv
-  N->addSubDiagonal(1., nlp_->m_eq(), *Dd_inv_);
 #ifdef HIOP_DEEPCHECKS
-  assert(J.isfinite());
-  nlp_->log->write("solveCompressed: N is", *N, hovMatrices);
   nlp_->log->write("solveCompressed: rx is", rx, hovMatrices);
-  nlp_->log->printf(hovLinAlgScalars, "inf norm of Dd_inv is %g\n", Dd_inv_->infnorm());
-  N->assertSymmetry(1e-10);
 #endif
  
   //compute the rhs of the lin sys involving N 
@@ -824,7 +1016,6 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 #ifdef HIOP_DEEPCHECKS
   nlp_->log->write("solveCompressed: dx sol is", dx, hovMatrices);
   nlp_->log->write("solveCompressed: rhs for N is", rhs, hovMatrices);
-  Nmat->copyFrom(*N);
   hiopVector* r=rhs.new_copy(); //save the rhs to check the norm of the residual
 #endif
 
@@ -856,65 +1047,58 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 
 int hiopKKTLinSysLowRank::solveWithRefin(hiopMatrixDense& M, hiopVector& rhs)
 {
-  // 1. Solve dposvx (solve + equilibrating + iterative refinement + forward and backward error estimates)
+  // 1. Solve with dposvx reusing the equilibration and the factorization computed in 'factorizeN'
+  // (solve + iterative refinement + forward and backward error estimates)
   // 2. Check the residual norm
   // 3. If residual norm is not small enough, then perform iterative refinement. This is because dposvx 
   // does not always provide a small enough residual since it stops (possibly without refinement) based on
   // the forward and backward estimates
+  assert(&M == N && "the factorization of N is cached; other matrices are not supported");
 
-  int N=M.n();
-  if(N<=0) return 0;
+  int k=M.n();
+  if(k<=0) return 0;
 
-  hiopMatrixDense* Aref = M.new_copy();
   hiopVector* rhsref = rhs.new_copy();
 
-  char FACT='E'; 
+  char FACT='F'; //reuse the factorization and the equilibration
   char UPLO='L';
 
   int NRHS=1;
-  double* A=M.local_buffer();
-  int LDA=N;
-  double* AF=new double[N*N];
-  int LDAF=N;
-  char EQUED='N'; //it is an output if FACT='E'
-  double* S = new double[N];
+  int LDA=k;
+  int LDAF=k;
   double* B = rhs.local_data();
-  int LDB=N;
-  double* X = new double[N];
-  int LDX = N;
+  int LDB=k;
+  double* X = new double[k];
+  int LDX = k;
   double RCOND, FERR, BERR;
-  double* WORK = new double[3*N];
-  int* IWORK = new int[N];
   int INFO; 
 
   //
   // 1. solve
   //
-  DPOSVX(&FACT, &UPLO, &N, &NRHS,
-	 A, &LDA,
-	 AF, &LDAF,
-	 &EQUED,
-	 S,
+  DPOSVX(&FACT, &UPLO, &k, &NRHS,
+	 N_equil_->local_buffer(), &LDA,
+	 N_fact_, &LDAF,
+	 &N_equed_,
+	 N_scal_,
 	 B, &LDB,
 	 X, &LDX,
 	 &RCOND, &FERR, &BERR, 
-	 WORK, IWORK,
+	 N_work_, N_iwork_,
 	 &INFO); 
-  //printf("INFO ===== %d  RCOND=%g  FERR=%g   BERR=%g  EQUED=%c\n", INFO, RCOND, FERR, BERR, EQUED);
+  //printf("INFO ===== %d  RCOND=%g  FERR=%g   BERR=%g  EQUED=%c\n", INFO, RCOND, FERR, BERR, N_equed_);
   //
   // 2. check residual
   //
   hiopVector* x = rhs.alloc_clone(); 
   /// TODO: how can we only use the hiopVector interface here?
-  hiopVectorPar dx(N);
-  hiopVectorPar resid(N); 
+  hiopVectorPar resid(k); 
   int nIterRefin=0;double nrmResid;
-  int info;
   const int MAX_ITER_REFIN=3;
   while(true) {
     x->copyFrom(X);
     resid.copyFrom(*rhsref);
-    Aref->timesVec(1.0, resid, -1.0, *x);
+    M.timesVec(1.0, resid, -1.0, *x);
 
     nlp_->log->write("resid", resid, hovLinAlgScalars);
 
@@ -924,7 +1108,7 @@ int hiopKKTLinSysLowRank::solveWithRefin(hiopMatrixDense& M, hiopVector& rhs)
     if(nrmResid<1e-8) break;
 
     if(nIterRefin>=MAX_ITER_REFIN) {
-      nlp_->log->write("N", *Aref, hovMatrices);
+      nlp_->log->write("N", M, hovMatrices);
       nlp_->log->write("sol", *x, hovMatrices);
       nlp_->log->write("rhs", *rhsref, hovMatrices);
 
@@ -932,84 +1116,32 @@ int hiopKKTLinSysLowRank::solveWithRefin(hiopMatrixDense& M, hiopVector& rhs)
       break;
       //assert(false && "too many refinements");
     }
-    if(0) { //iter refin based on symmetric indefinite factorization+solve 
-      
-
-      int _V_ipiv_vec[1000]; double _V_work_vec[1000]; int lwork=1000;
-      M.copyFrom(*Aref);
-      DSYTRF(&UPLO, &N, M.local_buffer(), &LDA, _V_ipiv_vec, _V_work_vec, &lwork, &info);
-      assert(info==0);
-      DSYTRS(&UPLO, &N, &NRHS, M.local_buffer(), &LDA, _V_ipiv_vec, resid.local_data(), &LDB, &info);
-      assert(info==0);
-    } else { //iter refin based on symmetric positive definite factorization+solve 
-      M.copyFrom(*Aref);
-      //for(int i=0; i<4; i++) M.local_data()[i][i] +=1e-8;
-      DPOTRF(&UPLO, &N, M.local_buffer(), &LDA, &info);
-      if(info>0)
-	nlp_->log->printf(hovError, "hiopKKTLinSysLowRank::factorizeMat: dpotrf (Chol fact) "
-			  "detected %d minor being indefinite.\n", info);
-      else
-	if(info<0) 
-	  nlp_->log->printf(hovError, "hiopKKTLinSysLowRank::factorizeMat: dpotrf returned "
-			    "error %d\n", info);
-      
-      DPOTRS(&UPLO,&N, &NRHS, M.local_buffer(), &LDA, resid.local_data(), &LDA, &info);
-      if(info<0) 
-	nlp_->log->printf(hovError, "hiopKKTLinSysLowRank::solveWithFactors: dpotrs returned "
-			  "error %d\n", info);
-    }
 
-   // //FACT='F'; EQUED='Y'; //reuse the factorization and the equilibration
-   //  M.copyFrom(*Aref);
-   //  A = M.local_buffer();
-   //  dposvx_(&FACT, &UPLO, &N, &NRHS,
-   // 	    A, &LDA,
-   // 	    AF, &LDAF,
-   // 	    &EQUED,
-   // 	    S,
-   // 	    resid.local_data(), &LDB,
-   // 	    X, &LDX,
-   // 	    &RCOND, &FERR, &BERR, 
-   // 	    WORK, IWORK,
-   // 	    &INFO); 
-   //  printf("INFO ===== %d  RCOND=%g  FERR=%g   BERR=%g  EQUED=%c\n", INFO, RCOND, FERR, BERR, EQUED);
-    
-    dx.copyFrom(resid);
-    x->axpy(1., dx);
+    //correction from the residual using the same (cached) factorization
+    DPOSVX(&FACT, &UPLO, &k, &NRHS,
+	   N_equil_->local_buffer(), &LDA,
+	   N_fact_, &LDAF,
+	   &N_equed_,
+	   N_scal_,
+	   resid.local_data(), &LDB,
+	   X, &LDX,
+	   &RCOND, &FERR, &BERR, 
+	   N_work_, N_iwork_,
+	   &INFO); 
+    if(INFO<0) 
+      nlp_->log->printf(hovError, "hiopKKTLinSysLowRank::solveWithRefin: dposvx returned "
+			"error %d\n", INFO);
+    resid.copyFrom(X);
+    x->axpy(1., resid);
+    x->copyTo(X);
     
     nIterRefin++;
   }
 
   rhs.copyFrom(*x);
-  delete[] AF;
-  delete[] S;
   delete[] X;
-  delete[] WORK;
-  delete[] IWORK;
-  delete Aref;
   delete rhsref;
   delete x;
-
-// #ifdef HIOP_DEEPCHECKS
-//   hiopVectorPar sol(rhs.get_size());
-//   hiopVectorPar rhss(rhs.get_size());
-//   sol.copyFrom(rhs); rhss.copyFrom(*r);
-//   double relErr=solveError(*Nmat, rhs, *r);
-//   if(relErr>1e-5)  {
-//     nlp_->log->printf(hovWarning, "large rel. error (%g) in linear solver occured the Cholesky solve (hiopKKTLinSys)\n", relErr);
-
-//     nlp_->log->write("matrix N=", *Nmat, hovError);
-//     nlp_->log->write("rhs", rhss, hovError);
-//     nlp_->log->write("sol", sol, hovError);
-
-//     assert(false && "large error (%g) in linear solve (hiopKKTLinSys), equilibrating the matrix and/or iterative refinement are needed (see dposvx/x)");
-//   } else 
-//     if(relErr>1e-16) 
-//       nlp_->log->printf(hovWarning, "considerable rel. error (%g) in linear solver occured the Cholesky solve (hiopKKTLinSys)\n", relErr);
-
-//   nlp_->log->printf(hovLinAlgScalars, "hiopKKTLinSysLowRank::solveCompressed: Cholesky solve: relative error %g\n", relErr);
-//   delete r;
-// #endif
   return 0;
 }
 
@@ -56,6 +56,8 @@
 
 #include "hiopCppStdUtils.hpp"
 
+#include <vector>
+
 namespace hiop
 {
 
@@ -82,6 +84,14 @@ public:
    * with the factors, then computes the "full-space" directions */
   virtual bool computeDirections(const hiopResidual* resid, hiopIterate* direction) = 0;
 
+  /* computes the directions for multiple residuals (right-hand sides) using the factorization 
+   * computed by 'update'. The default implementation calls 'computeDirections' for each residual; 
+   * the compressed linear systems override it to perform the triangular solves for all the 
+   * right-hand sides at once. As for 'computeDirections', the linear systems are dumped when the
+   * 'write_kkt' option is on and the residuals of the solves are checked in HIOP_DEEPCHECKS builds. */
+  virtual bool computeDirectionsBlock(const std::vector<const hiopResidual*>& resids, 
+				      const std::vector<hiopIterate*>& dirs);
+
   virtual void set_PD_perturb_calc(hiopPDPerturbation* p)
   {
     perturb_calc_ = p;
@@ -131,20 +141,22 @@ public:
     assert(Dx_ != NULL);
     rx_tilde_  = Dx_->alloc_clone(); 
   }
-  virtual ~hiopKKTLinSysCompressed() 
-  {
-    delete Dx_;
-    delete rx_tilde_;
-  }
+  virtual ~hiopKKTLinSysCompressed();
+
   virtual bool update(const hiopIterate* iter, 
 		      const hiopVector* grad_f, 
 		      const hiopMatrix* Jac_c, const hiopMatrix* Jac_d, hiopMatrix* Hess) = 0;
 
   virtual bool computeDirections(const hiopResidual* resid, hiopIterate* direction) = 0;
 
+protected:
+  /* computes the directions for the slacks and the bounds' duals once dx and dd are known */
+  void computeRemainingDirections(const hiopResidual& resid, hiopIterate& dir);
 protected:
   hiopVector* Dx_;
   hiopVector* rx_tilde_;
+  //rx_tilde for the 2nd, 3rd, ... right-hand sides of 'computeDirectionsBlock'
+  std::vector<hiopVector*> rx_tilde_blk_;
 };
 
 /* Provides the functionality for reducing the KKT linear system to the 
@@ -169,9 +181,21 @@ public:
 
   virtual bool computeDirections(const hiopResidual* resid, hiopIterate* direction);
 
+  virtual bool computeDirectionsBlock(const std::vector<const hiopResidual*>& resids, 
+				      const std::vector<hiopIterate*>& dirs);
+
   virtual bool solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 			       hiopVector& dx, hiopVector& dyc, hiopVector& dyd) = 0;
 
+  /* Solves the compressed linear system for multiple right-hand sides. The default 
+   * implementation calls 'solveCompressed' for each right-hand side. */
+  virtual bool solveCompressedBlock(std::vector<hiopVector*>& rx, 
+				    std::vector<hiopVector*>& ryc, 
+				    std::vector<hiopVector*>& ryd,
+				    std::vector<hiopVector*>& dx, 
+				    std::vector<hiopVector*>& dyc, 
+				    std::vector<hiopVector*>& dyd);
+
 #ifdef HIOP_DEEPCHECKS
   virtual double errorCompressedLinsys(const hiopVector& rx, 
 				       const hiopVector& ryc, 
@@ -181,9 +205,16 @@ public:
 				       const hiopVector& dyd);
 #endif
 
+protected:
+  /* performs the reduction of the residual 'r' to the rhs of the compressed system; on exit
+   * dir.sdl contains the rhs rd+Sdl^{-1}*(rsvl-Vl*rdl)-Sdu^{-1}(rsvu-Vu*rdu) needed to recover dd */
+  void formCompressedRhs(const hiopResidual& r, hiopIterate& dir, 
+			 hiopVector& rx_tilde, hiopVector& ryd_tilde);
 protected:
   hiopVector *Dd_inv_;
   hiopVector *ryd_tilde_;
+  //ryd_tilde for the 2nd, 3rd, ... right-hand sides of 'computeDirectionsBlock'
+  std::vector<hiopVector*> ryd_tilde_blk_;
 };
 
 /* Provides the functionality for reducing the KKT linear system to the 
@@ -210,11 +241,21 @@ public:
 
   virtual bool computeDirections(const hiopResidual* resid, hiopIterate* direction);
 
+  virtual bool computeDirectionsBlock(const std::vector<const hiopResidual*>& resids, 
+				      const std::vector<hiopIterate*>& dirs);
+
   virtual bool solveCompressed(hiopVector& rx, hiopVector& rd, 
 			       hiopVector& ryc, hiopVector& ryd,
 			       hiopVector& dx, hiopVector& dd, 
 			       hiopVector& dyc, hiopVector& dyd) = 0;
 
+  /* Solves the compressed linear system for multiple right-hand sides. The default 
+   * implementation calls 'solveCompressed' for each right-hand side. */
+  virtual bool solveCompressedBlock(std::vector<hiopVector*>& rx, std::vector<hiopVector*>& rd, 
+				    std::vector<hiopVector*>& ryc, std::vector<hiopVector*>& ryd,
+				    std::vector<hiopVector*>& dx, std::vector<hiopVector*>& dd, 
+				    std::vector<hiopVector*>& dyc, std::vector<hiopVector*>& dyd);
+
 #ifdef HIOP_DEEPCHECKS
   virtual double errorCompressedLinsys(const hiopVector& rx,  const hiopVector& rd, 
 				       const hiopVector& ryc, const hiopVector& ryd,
@@ -222,9 +263,15 @@ public:
 				       const hiopVector& dyc, const hiopVector& dyd);
 #endif
 
+protected:
+  /* performs the reduction of the residual 'r' to the rhs of the compressed system */
+  void formCompressedRhs(const hiopResidual& r, hiopIterate& dir, 
+			 hiopVector& rx_tilde, hiopVector& rd_tilde);
 protected:
   hiopVector *Dd_;
   hiopVector *rd_tilde_;
+  //rd_tilde for the 2nd, 3rd, ... right-hand sides of 'computeDirectionsBlock'
+  std::vector<hiopVector*> rd_tilde_blk_;
 protected: 
 #ifdef HIOP_DEEPCHECKS
   //y=beta*y+alpha*H*x
@@ -279,6 +326,8 @@ public:
 
   //LAPACK wrappers
   int solve(hiopMatrixDense& M, hiopVector& rhs);
+  /* solves with the factorization of N computed by 'factorizeN' followed by iterative refinement
+   * on the residual of the system with M=N */
   int solveWithRefin(hiopMatrixDense& M, hiopVector& rhs);
 #ifdef HIOP_DEEPCHECKS
   static double solveError(const hiopMatrixDense& M,  const hiopVector& x, hiopVector& rhs);
@@ -299,11 +348,26 @@ private:
   hiopHessianLowRank* HessLowRank;
 
   hiopMatrixDense* N; //the kxk reduced matrix
+
+  /* N and its factorization depend only on the iterate; they are computed once in 'update' 
+   * and reused by all the compressed solves until the next 'update' */
+  void factorizeN();
+  //the equilibrated N, its Cholesky factor, and the equilibration computed by DPOSVX
+  hiopMatrixDense* N_equil_;
+  double* N_fact_;
+  double* N_scal_;
+  char N_equed_;
+  //DPOSVX workspace
+  double* N_work_;
+  int* N_iwork_;
 #ifdef HIOP_DEEPCHECKS
   hiopMatrixDense* Nmat; //a copy of the above to compute the residual
 #endif
   //internal buffers
-  hiopMatrixDense* _kxn_mat; //!opt (work directly with the Jacobian)
+  //stacked Jacobian [Jc; Jd]: a view of the storage of Jac_c and Jac_d when they are stored 
+  //contiguously (see hiopNlpDenseConstraints::alloc_Jac_c_d), otherwise a copy updated at each solve
+  hiopMatrixDense* _kxn_mat;
+  bool _kxn_mat_is_view;
   hiopVector* _k_vec1;
 };
 
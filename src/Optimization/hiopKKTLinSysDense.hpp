@@ -74,7 +74,7 @@ class hiopKKTLinSysDenseXYcYd : public hiopKKTLinSysCompressedXYcYd
 {
 public:
   hiopKKTLinSysDenseXYcYd(hiopNlpFormulation* nlp)
-    : hiopKKTLinSysCompressedXYcYd(nlp), linSys(NULL), rhsXYcYd(NULL), 
+    : hiopKKTLinSysCompressedXYcYd(nlp), linSys(NULL), rhsXYcYd(NULL), rhsBlockXYcYd(NULL),
       write_linsys_counter(-1), csr_writer(nlp)
   {
   }
@@ -82,6 +82,7 @@ public:
   {
     delete linSys;
     delete rhsXYcYd;
+    delete rhsBlockXYcYd;
   }
 
   /* updates the parts in KKT system that are dependent on the iterate. 
@@ -93,6 +94,7 @@ public:
 	      const hiopMatrix* Jac_d, 
 	      hiopMatrix* Hess)
   {
+    hiopProfRegion prof_update(nlp_->prof, "kkt.update");
     nlp_->runStats.tmSolverInternal.start();
 
     iter_ = iter;   
@@ -125,6 +127,8 @@ public:
 			  "LinSysDenseXYcYd: instantiating Lapack for a matrix of size %d\n",
 			  n);
       }
+      //H+Dx is expected to be positive definite on quasi-definite KKT systems
+      linSys->set_quasidefinite_hint(nx);
     }
 
     //compute and put the barrier diagonals in
@@ -256,6 +260,7 @@ public:
   virtual bool solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 			       hiopVector& dx, hiopVector& dyc, hiopVector& dyd)
   {
+    hiopProfRegion prof_solve(nlp_->prof, "kkt.solve");
     int nx=rx.get_size(), nyc=ryc.get_size(), nyd=ryd.get_size();
     if(rhsXYcYd == NULL) rhsXYcYd = LinearAlgebraFactory::createVector(nx+nyc+nyd);
 
@@ -286,9 +291,57 @@ public:
     return true;
   }
 
+  /* All the right-hand sides are packed as rows of a dense matrix and solved for with one
+   * multiple right-hand side solve of the linear solver */
+  virtual bool solveCompressedBlock(std::vector<hiopVector*>& rx, 
+				    std::vector<hiopVector*>& ryc, 
+				    std::vector<hiopVector*>& ryd,
+				    std::vector<hiopVector*>& dx, 
+				    std::vector<hiopVector*>& dyc, 
+				    std::vector<hiopVector*>& dyd)
+  {
+    const int nrhs = rx.size();
+    if(nrhs==0) return true;
+    int nx=rx[0]->get_size(), nyc=ryc[0]->get_size(), nyd=ryd[0]->get_size();
+    if(rhsXYcYd == NULL) rhsXYcYd = LinearAlgebraFactory::createVector(nx+nyc+nyd);
+    if(rhsBlockXYcYd == NULL || rhsBlockXYcYd->m() != nrhs) {
+      delete rhsBlockXYcYd;
+      rhsBlockXYcYd = LinearAlgebraFactory::createMatrixDense(nrhs, nx+nyc+nyd);
+    }
+
+    for(int k=0; k<nrhs; k++) {
+      rx[k]-> copyToStarting(*rhsXYcYd, 0);
+      ryc[k]->copyToStarting(*rhsXYcYd, nx);
+      ryd[k]->copyToStarting(*rhsXYcYd, nx+nyc);
+      rhsBlockXYcYd->replaceRow(k, *rhsXYcYd);
+    }
+
+    //the right-hand sides are overwritten by the solve
+    hiopMatrixDense* rhs_save = write_linsys_counter>=0 ? rhsBlockXYcYd->new_copy() : NULL;
+
+    bool sol_ok = linSys->solve(*rhsBlockXYcYd);
+
+    if(rhs_save) {
+      csr_writer.writeRhsSolBlockToFile(*rhs_save, *rhsBlockXYcYd, write_linsys_counter);
+      delete rhs_save;
+    }
+
+    if(false==sol_ok) return false;
+
+    for(int k=0; k<nrhs; k++) {
+      rhsBlockXYcYd->getRow(k, *rhsXYcYd);
+      rhsXYcYd->copyToStarting(0,      *dx[k]);
+      rhsXYcYd->copyToStarting(nx,     *dyc[k]);
+      rhsXYcYd->copyToStarting(nx+nyc, *dyd[k]);
+    }
+    return true;
+  }
+
 protected:
   hiopLinSolverIndefDense* linSys;
   hiopVector* rhsXYcYd;
+  //right-hand sides as rows; used by 'solveCompressedBlock'
+  hiopMatrixDense* rhsBlockXYcYd;
   
   /** -1 when disabled; otherwise acts like a counter, 0,1,...
    * incremented each time 'solveCompressed' is called depends on the 'write_kkt' option
@@ -297,7 +350,7 @@ protected:
   hiopCSR_IO csr_writer;
 private:
   hiopKKTLinSysDenseXYcYd() 
-    :  hiopKKTLinSysCompressedXYcYd(NULL), linSys(NULL), 
+    :  hiopKKTLinSysCompressedXYcYd(NULL), linSys(NULL), rhsBlockXYcYd(NULL),
        write_linsys_counter(-1), csr_writer(NULL)
   { 
     assert(false); 
@@ -309,7 +362,7 @@ class hiopKKTLinSysDenseXDYcYd : public hiopKKTLinSysCompressedXDYcYd
 {
 public:
   hiopKKTLinSysDenseXDYcYd(hiopNlpFormulation* nlp)
-    : hiopKKTLinSysCompressedXDYcYd(nlp), linSys(NULL), rhsXDYcYd(NULL),
+    : hiopKKTLinSysCompressedXDYcYd(nlp), linSys(NULL), rhsXDYcYd(NULL), rhsBlockXDYcYd(NULL),
       write_linsys_counter(-1), csr_writer(nlp)
   {
   }
@@ -317,6 +370,7 @@ public:
   {
     delete linSys;
     delete rhsXDYcYd;
+    delete rhsBlockXDYcYd;
   }
 
   /* Updates the parts in KKT system that are dependent on the iterate. 
@@ -332,6 +386,7 @@ public:
 	      const hiopMatrix* Jac_c, const hiopMatrix* Jac_d, 
 	      hiopMatrix* Hess)
   {
+    hiopProfRegion prof_update(nlp_->prof, "kkt.update");
     nlp_->runStats.tmSolverInternal.start();
 
     iter_ = iter;   
@@ -358,6 +413,8 @@ public:
 	nlp_->log->printf(hovScalars, "LinSysDenseXDYcYd instantiating Lapack for a matrix of size %d\n", n);
 	linSys = new hiopLinSolverIndefDenseLapack(n, nlp_);
       }	
+      //[H+Dx 0; 0 Dd] is expected to be positive definite on quasi-definite KKT systems
+      linSys->set_quasidefinite_hint(nx+nineq);
     }
 
     //
@@ -501,6 +558,7 @@ public:
   virtual bool solveCompressed(hiopVector& rx, hiopVector& rd, hiopVector& ryc, hiopVector& ryd,
 			       hiopVector& dx, hiopVector& dd, hiopVector& dyc, hiopVector& dyd)
   {
+    hiopProfRegion prof_solve(nlp_->prof, "kkt.solve");
     int nx=rx.get_size(), nyc=ryc.get_size(), nyd=ryd.get_size();
     if(rhsXDYcYd == NULL) rhsXDYcYd = LinearAlgebraFactory::createVector(nx+nyc+2*nyd);
 
@@ -534,16 +592,64 @@ public:
     return true;
   }
 
+  /* All the right-hand sides are packed as rows of a dense matrix and solved for with one
+   * multiple right-hand side solve of the linear solver */
+  virtual bool solveCompressedBlock(std::vector<hiopVector*>& rx, std::vector<hiopVector*>& rd, 
+				    std::vector<hiopVector*>& ryc, std::vector<hiopVector*>& ryd,
+				    std::vector<hiopVector*>& dx, std::vector<hiopVector*>& dd, 
+				    std::vector<hiopVector*>& dyc, std::vector<hiopVector*>& dyd)
+  {
+    const int nrhs = rx.size();
+    if(nrhs==0) return true;
+    int nx=rx[0]->get_size(), nyc=ryc[0]->get_size(), nyd=ryd[0]->get_size();
+    if(rhsXDYcYd == NULL) rhsXDYcYd = LinearAlgebraFactory::createVector(nx+nyc+2*nyd);
+    if(rhsBlockXDYcYd == NULL || rhsBlockXDYcYd->m() != nrhs) {
+      delete rhsBlockXDYcYd;
+      rhsBlockXDYcYd = LinearAlgebraFactory::createMatrixDense(nrhs, nx+nyc+2*nyd);
+    }
+
+    for(int k=0; k<nrhs; k++) {
+      rx[k]-> copyToStarting(*rhsXDYcYd, 0);
+      rd[k]-> copyToStarting(*rhsXDYcYd, nx);
+      ryc[k]->copyToStarting(*rhsXDYcYd, nx+nyd);
+      ryd[k]->copyToStarting(*rhsXDYcYd, nx+nyd+nyc);
+      rhsBlockXDYcYd->replaceRow(k, *rhsXDYcYd);
+    }
+
+    //the right-hand sides are overwritten by the solve
+    hiopMatrixDense* rhs_save = write_linsys_counter>=0 ? rhsBlockXDYcYd->new_copy() : NULL;
+
+    bool sol_ok = linSys->solve(*rhsBlockXDYcYd);
+
+    if(rhs_save) {
+      csr_writer.writeRhsSolBlockToFile(*rhs_save, *rhsBlockXDYcYd, write_linsys_counter);
+      delete rhs_save;
+    }
+
+    if(false==sol_ok) return false;
+
+    for(int k=0; k<nrhs; k++) {
+      rhsBlockXDYcYd->getRow(k, *rhsXDYcYd);
+      rhsXDYcYd->copyToStarting(0,          *dx[k]);
+      rhsXDYcYd->copyToStarting(nx,         *dd[k]);
+      rhsXDYcYd->copyToStarting(nx+nyd,     *dyc[k]);
+      rhsXDYcYd->copyToStarting(nx+nyd+nyc, *dyd[k]);
+    }
+    return true;
+  }
+
 protected:
   hiopLinSolverIndefDense* linSys;
   hiopVector* rhsXDYcYd;
+  //right-hand sides as rows; used by 'solveCompressedBlock'
+  hiopMatrixDense* rhsBlockXDYcYd;
   //-1 when disabled; otherwise acts like a counter, 0,1,... incremented each time 'solveCompressed' is called
   //depends on the 'write_kkt' option
   int write_linsys_counter; 
   hiopCSR_IO csr_writer;
 private:
   hiopKKTLinSysDenseXDYcYd() 
-    : hiopKKTLinSysCompressedXDYcYd(NULL), linSys(NULL), 
+    : hiopKKTLinSysCompressedXDYcYd(NULL), linSys(NULL), rhsBlockXDYcYd(NULL),
       write_linsys_counter(-1), csr_writer(NULL)
   { 
     assert(false && "not intended to be used"); 
@@ -57,20 +57,25 @@ namespace hiop
 {
 
   hiopKKTLinSysCompressedMDSXYcYd::hiopKKTLinSysCompressedMDSXYcYd(hiopNlpFormulation* nlp)
-    : hiopKKTLinSysCompressedXYcYd(nlp), linSys_(NULL), rhs_(NULL), _buff_xs_(NULL),
-      Hxs_(NULL), HessMDS_(NULL), Jac_cMDS_(NULL), Jac_dMDS_(NULL),
+    : hiopKKTLinSysCompressedXYcYd(nlp), linSys_(NULL), rhs_(NULL), rhs_block_(NULL), _buff_xs_(NULL),
+      Hxs_(NULL), Msys_cache_(NULL), Hxs_cache_(NULL), delta_wx_cache_(0.), n_schur_assemblies_(0),
+      HessMDS_(NULL), Jac_cMDS_(NULL), Jac_dMDS_(NULL),
       write_linsys_counter_(-1), csr_writer_(nlp)
   {
     nlpMDS_ = dynamic_cast<hiopNlpMDS*>(nlp_);
     assert(nlpMDS_);
+    incremental_ic_ = "yes"==nlp_->options->GetString("mds_incremental_ic");
   }
 
   hiopKKTLinSysCompressedMDSXYcYd::~hiopKKTLinSysCompressedMDSXYcYd()
   {
     delete rhs_;
+    delete rhs_block_;
     delete linSys_;
     delete _buff_xs_;
     delete Hxs_;
+    delete Msys_cache_;
+    delete Hxs_cache_;
   }
 
   bool hiopKKTLinSysCompressedMDSXYcYd::update(const hiopIterate* iter, 
@@ -81,6 +86,8 @@ namespace hiop
   {
     if(!nlpMDS_) { assert(false); return false; }
    
+    hiopProfRegion prof_update(nlp_->prof, "kkt.update");
+    hiopProfRegion prof_init(nlp_->prof, "init");
     nlp_->runStats.tmSolverInternal.start();
     nlp_->runStats.kkt.tmUpdateInit.start();
 
@@ -108,6 +115,8 @@ namespace hiop
     //based on safe_mode_, decide whether to go with the nopiv (fast) or Bunch-Kaufman (stable) linear solve 
     //
     linSys_ = determineAndCreateLinsys(nxd, neq, nineq);
+    //the dense Hessian block Hd+Dxd is expected to be positive definite on quasi-definite systems
+    linSys_->set_quasidefinite_hint(nxd);
 
     //
     //update/compute KKT
@@ -136,10 +145,13 @@ namespace hiop
     if(!perturb_calc_->compute_initial_deltas(delta_wx, delta_wd, delta_cc, delta_cd)) {
       nlp_->log->printf(hovWarning, 
 			"KKT_MDS_XYcYd linsys: IC perturbation on new linsys failed.\n");
+      nlp_->runStats.kkt.tmUpdateInit.stop();
+      nlp_->runStats.tmSolverInternal.stop();
       return false;
     }
     
     nlp_->runStats.kkt.tmUpdateInit.stop();
+    prof_init.stop();
 
     while(num_ic_cor<=max_ic_cor) {
 
@@ -153,59 +165,10 @@ namespace hiop
       //
       //the update of the linear system, including IC perturbations
       //
+      hiopProfRegion prof_linsys(nlp_->prof, "linsys");
       nlp_->runStats.kkt.tmUpdateLinsys.start();
       {
-	Msys.setToZero();
-
-	int alpha = 1.;
-
-	// perf eval 
-	//hiopTimer tm;
-	//tm.start();
-
-	HessMDS_->de_mat()->addUpperTriangleToSymDenseMatrixUpperTriangle(0, alpha, Msys);
-	Jac_cMDS_->de_mat()->transAddToSymDenseMatrixUpperTriangle(0, nxd,     alpha, Msys);
-	Jac_dMDS_->de_mat()->transAddToSymDenseMatrixUpperTriangle(0, nxd+neq, alpha, Msys);
-
-	//tm.stop();
-	//printf("the three add methods took %g sec\n", tm.getElapsedTime());
-	//tm.reset();
-
-	//update -> add Dxd to (1,1) block of KKT matrix (Hd = HessMDS_->de_mat already added above)
-	Msys.addSubDiagonal(0, alpha, *Dx_, nxs, nxd);
-	//add perturbation 'delta_wx' for xd
-	Msys.addSubDiagonal(0, nxd, delta_wx);
-	
-	//build the diagonal Hxs = Hsparse+Dxs
-	if(NULL == Hxs_) {
-	  Hxs_ = LinearAlgebraFactory::createVector(nxs); assert(Hxs_);
-	}
-	Hxs_->startingAtCopyFromStartingAt(0, *Dx_, 0);
-	
-	//a good time to add the IC 'delta_wx' perturbation
-	Hxs_->addConstant(delta_wx);
-
-
-	//Hxs +=  diag(HessMDS->sp_mat());
-	//todo: make sure we check that the HessMDS->sp_mat() is a diagonal
-	HessMDS_->sp_mat()->startingAtAddSubDiagonalToStartingAt(0, alpha, *Hxs_, 0);
-	nlp_->log->write("Hxs in KKT_MDS_X", *Hxs_, hovMatrices);
-
-
-	//add - Jac_c_sp * (Hxs)^{-1} Jac_c_sp^T to diagonal block linSys starting at (nxd, nxd)
-	alpha = -1.;
-
-	// perf eval
-	//tm.start();
-	Jac_cMDS_->sp_mat()->addMDinvMtransToDiagBlockOfSymDeMatUTri(nxd, alpha, *Hxs_, Msys);
-
-	//tm.stop();
-	//printf("addMDinvMtransToDiagBlockOfSymDeMatUTri 111 took %g sec\n", tm.getElapsedTime());
-	//tm.reset();
-
-	Msys.addSubDiagonal(nxd, neq, -delta_cc);
-	
-	/* we've just done above the (1,1) and (2,2) blocks of
+	/* The reduced system is
 	 *
 	 * [ Hd+Dxd+delta_wx*I           Jcd^T                                 Jdd^T  ]
 	 * [  Jcd              -Jcs(Hs+Dxs+delta_wx*I)^{-1}Jcs^T-delta_cc*I    K_21   ]
@@ -215,26 +178,14 @@ namespace hiop
 	 * K_21 = - Jcs * (Hs+Dxs+delta_wx)^{-1} * Jds^T
 	 * 
 	 * M_{33} = -Jds(Hs+Dxs+delta_wx)^{-1}Jds^T - (Dd+delta_wd)*I^{-1} - delta_cd*I
-	 *   is performed below
 	 */
-	
-	alpha = -1.;
-	// add   - Jac_d_sp * (Hxs+Dxs+delta_wx*I)^{-1} * Jac_d_sp^T   to diagonal block
-	// linSys starting at (nxd+neq, nxd+neq)
-
-	// perf eval
-	//tm.start();
-
-	Jac_dMDS_->sp_mat()->
-	  addMDinvMtransToDiagBlockOfSymDeMatUTri(nxd+neq, alpha, *Hxs_, Msys); 
+	assembleReducedMatrix(Msys, delta_wx, 0==num_ic_cor);
+	nlp_->log->write("Hxs in KKT_MDS_X", *Hxs_, hovMatrices);
 
-	//tm.stop();
-	//printf("addMDinvMtransToDiagBlockOfSymDeMatUTri 222 took %g sec\n", tm.getElapsedTime());
+	//add perturbation 'delta_wx' for xd
+	Msys.addSubDiagonal(0, nxd, delta_wx);
 
-	//K_21 = - Jcs * (Hs+Dxs+delta_wx)^{-1} * Jds^T
-	alpha = -1.;
-	Jac_cMDS_->sp_mat()->
-	  addMDinvNtransToSymDeMatUTri(nxd, nxd+neq, alpha, *Hxs_, *Jac_dMDS_->sp_mat(), Msys);
+	Msys.addSubDiagonal(nxd, neq, -delta_cc);
 
 	// add -{Dd}^{-1}
 	// Dd=(Sdl)^{-1}Vu + (Sdu)^{-1}Vu + delta_wd * I
@@ -246,19 +197,20 @@ namespace hiop
 #endif 
 	Dd_inv_->invert();
 	
-	alpha=-1.;
-	Msys.addSubDiagonal(alpha, nxd+neq, *Dd_inv_);
+	Msys.addSubDiagonal(-1., nxd+neq, *Dd_inv_);
 	Msys.addSubDiagonal(nxd+neq, nineq, -delta_cd);
 	
 	nlp_->log->write("KKT_MDS_XYcYd linsys:", Msys, hovMatrices);
       } // end of update of the linear system
       nlp_->runStats.kkt.tmUpdateLinsys.stop();
+      prof_linsys.stop();
       
       //write matrix to file if requested
       if(nlp_->options->GetString("write_kkt") == "yes") write_linsys_counter_++;
       if(write_linsys_counter_>=0) csr_writer_.writeMatToFile(Msys, write_linsys_counter_); 
       
 
+      hiopProfRegion prof_fact(nlp_->prof, "factorization");
       nlp_->runStats.linsolv.start_linsolve();
       nlp_->runStats.kkt.tmUpdateInnerFact.start();
       //factorization
@@ -282,6 +234,7 @@ namespace hiop
 	}
       }
       nlp_->runStats.kkt.tmUpdateInnerFact.stop();
+      prof_fact.stop();
 
       if(n_neg_eig_11 < 0) {
 	nlp_->log->printf(hovScalars, 
@@ -303,6 +256,7 @@ namespace hiop
 	  if(!perturb_calc_->compute_perturb_singularity(delta_wx, delta_wd, delta_cc, delta_cd)) {
 	    nlp_->log->printf(hovWarning, 
 			      "KKT_MDS_XYcYd linsys: computing singularity perturbation failed.\n");
+	    nlp_->runStats.tmSolverInternal.stop();
 	    return false;
 	  }
 	  
@@ -320,6 +274,7 @@ namespace hiop
 	  if(!perturb_calc_->compute_perturb_wrong_inertia(delta_wx, delta_wd, delta_cc, delta_cd)) {
 	    nlp_->log->printf(hovWarning, 
 			      "KKT_MDS_XYcYd linsys: computing inertia perturbation failed.\n");
+	    nlp_->runStats.tmSolverInternal.stop();
 	    return false;
 	  }
 	  
@@ -335,6 +290,7 @@ namespace hiop
        if(!perturb_calc_->compute_perturb_wrong_inertia(delta_wx, delta_wd, delta_cc, delta_cd)) {
 	 nlp_->log->printf(hovWarning, 
 			   "KKT_MDS_XYcYd linsys: computing inertia perturbation failed (2).\n");
+	 nlp_->runStats.tmSolverInternal.stop();
 	 return false;
        }
        
@@ -353,12 +309,110 @@ namespace hiop
       nlp_->log->printf(hovError,
 			"KKT_MDS_XYcYd linsys: max number (%d) of inertia corrections reached.\n",
 			max_ic_cor);
+      nlp_->runStats.tmSolverInternal.stop();
       return false;
     }
     nlp_->runStats.tmSolverInternal.stop();
     return true;
   }
 
+  void hiopKKTLinSysCompressedMDSXYcYd::addDeltaFreeBlocks(hiopMatrixDense& M)
+  {
+    const int nxs = HessMDS_->n_sp(), nxd = HessMDS_->n_de(), neq = Jac_cMDS_->m();
+    const double alpha = 1.;
+    hiopProfRegion prof_dense(nlp_->prof, "denseBlocks");
+
+    HessMDS_->de_mat()->addUpperTriangleToSymDenseMatrixUpperTriangle(0, alpha, M);
+    Jac_cMDS_->de_mat()->transAddToSymDenseMatrixUpperTriangle(0, nxd,     alpha, M);
+    Jac_dMDS_->de_mat()->transAddToSymDenseMatrixUpperTriangle(0, nxd+neq, alpha, M);
+
+    //add Dxd to (1,1) block of KKT matrix (Hd = HessMDS_->de_mat already added above)
+    M.addSubDiagonal(0, alpha, *Dx_, nxs, nxd);
+  }
+
+  void hiopKKTLinSysCompressedMDSXYcYd::addSchurBlocks(hiopMatrixDense& M, 
+						       const double& alpha, 
+						       const hiopVector& D)
+  {
+    const int nxd = HessMDS_->n_de(), neq = Jac_cMDS_->m();
+
+    //add alpha * Jac_c_sp * D^{-1} Jac_c_sp^T to diagonal block starting at (nxd, nxd)
+    {
+      hiopProfRegion prof_schur(nlp_->prof, "schurJcJc");
+      Jac_cMDS_->sp_mat()->addMDinvMtransToDiagBlockOfSymDeMatUTri(nxd, alpha, D, M);
+    }
+    //add alpha * Jac_d_sp * D^{-1} * Jac_d_sp^T to diagonal block starting at (nxd+neq, nxd+neq)
+    {
+      hiopProfRegion prof_schur(nlp_->prof, "schurJdJd");
+      Jac_dMDS_->sp_mat()->addMDinvMtransToDiagBlockOfSymDeMatUTri(nxd+neq, alpha, D, M);
+    }
+    //K_21 block: alpha * Jac_c_sp * D^{-1} * Jac_d_sp^T
+    {
+      hiopProfRegion prof_schur(nlp_->prof, "schurJcJd");
+      Jac_cMDS_->sp_mat()->addMDinvNtransToSymDeMatUTri(nxd, nxd+neq, alpha, D, *Jac_dMDS_->sp_mat(), M);
+    }
+  }
+
+  void hiopKKTLinSysCompressedMDSXYcYd::computeHxs(const double& delta_wx)
+  {
+    const int nxs = HessMDS_->n_sp();
+    //build the diagonal Hxs = Hsparse+Dxs
+    if(NULL == Hxs_) {
+      Hxs_ = LinearAlgebraFactory::createVector(nxs); assert(Hxs_);
+    }
+    Hxs_->startingAtCopyFromStartingAt(0, *Dx_, 0);
+
+    //Hxs +=  diag(HessMDS->sp_mat());
+    //todo: make sure we check that the HessMDS->sp_mat() is a diagonal
+    HessMDS_->sp_mat()->startingAtAddSubDiagonalToStartingAt(0, 1.0, *Hxs_, 0);
+
+    //the IC 'delta_wx' perturbation is added last so that Hxs does not depend on whether
+    //Hsparse+Dxs was cached (see 'assembleReducedMatrix')
+    Hxs_->addConstant(delta_wx);
+  }
+
+  void hiopKKTLinSysCompressedMDSXYcYd::assembleReducedMatrix(hiopMatrixDense& M,
+							      const double& delta_wx,
+							      bool first_trial)
+  {
+    if(!incremental_ic_) {
+      M.setToZero();
+      addDeltaFreeBlocks(M);
+      computeHxs(delta_wx);
+      addSchurBlocks(M, -1., *Hxs_);
+      n_schur_assemblies_++;
+      return;
+    }
+
+    if(first_trial) {
+      //Hsparse+Dxs changes only with the iterate
+      computeHxs(0.);
+      if(NULL==Hxs_cache_) {
+	Hxs_cache_ = Hxs_->alloc_clone();
+      }
+      Hxs_cache_->copyFrom(*Hxs_);
+    }
+
+    //Hxs_ is used by the solve and by the inertia count
+    Hxs_->copyFrom(*Hxs_cache_);
+    Hxs_->addConstant(delta_wx);
+
+    if(first_trial || delta_wx != delta_wx_cache_) {
+      //the Schur blocks depend on (Hsparse+Dxs+delta_wx)^{-1} and are recomputed exactly; the
+      //retries that change only delta_wd, delta_cc, or delta_cd reuse them
+      if(NULL==Msys_cache_) {
+	Msys_cache_ = M.alloc_clone();
+      }
+      Msys_cache_->setToZero();
+      addDeltaFreeBlocks(*Msys_cache_);
+      addSchurBlocks(*Msys_cache_, -1., *Hxs_);
+      n_schur_assemblies_++;
+      delta_wx_cache_ = delta_wx;
+    }
+    //the factorization overwrites 'M', the caller adds the diagonal IC perturbations to the copy
+    M.copyFrom(*Msys_cache_);
+  }
+
   bool hiopKKTLinSysCompressedMDSXYcYd::
   solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 		  hiopVector& dx, hiopVector& dyc, hiopVector& dyd)
@@ -368,8 +422,101 @@ namespace hiop
     if(!Jac_cMDS_) { assert(false); return false; }
     if(!Jac_dMDS_) { assert(false); return false; }
 
+    hiopProfRegion prof_solve(nlp_->prof, "kkt.solve");
+    nlp_->runStats.kkt.tmSolveRhsManip.start();
+
+    formReducedRhs(rx, ryc, ryd, dyc);
+
+    if(write_linsys_counter_>=0) 
+      csr_writer_.writeRhsToFile(*rhs_, write_linsys_counter_);
+
+    nlp_->runStats.kkt.tmSolveRhsManip.stop();
+
+    nlp_->runStats.kkt.tmSolveTriangular.start();
+    //
+    // solve
+    //
+    bool linsol_ok = linSys_->solve(*rhs_);
+    nlp_->runStats.kkt.tmSolveTriangular.stop();
+    nlp_->runStats.linsolv.end_linsolve();
+
+    if(perf_report_) {
+      nlp_->log->printf(hovSummary, "(summary for linear solver from KKT_MDS_XYcYd)\n%s", 
+			nlp_->runStats.linsolv.get_summary_last_solve().c_str());
+    }
+    
+    if(write_linsys_counter_>=0) 
+      csr_writer_.writeSolToFile(*rhs_, write_linsys_counter_);
+
+    if(false==linsol_ok) return false;
+
+    nlp_->runStats.kkt.tmSolveRhsManip.start();
+    recoverFromReducedSol(rx, dx, dyc, dyd);
+    nlp_->runStats.kkt.tmSolveRhsManip.stop();
+    return true;
+  }
+
+  bool hiopKKTLinSysCompressedMDSXYcYd::
+  solveCompressedBlock(std::vector<hiopVector*>& rx, 
+		       std::vector<hiopVector*>& ryc, 
+		       std::vector<hiopVector*>& ryd,
+		       std::vector<hiopVector*>& dx, 
+		       std::vector<hiopVector*>& dyc, 
+		       std::vector<hiopVector*>& dyd)
+  {
+    if(!nlpMDS_)   { assert(false); return false; }
+    if(!HessMDS_)  { assert(false); return false; }
+    if(!Jac_cMDS_) { assert(false); return false; }
+    if(!Jac_dMDS_) { assert(false); return false; }
+
+    const int nrhs = rx.size();
+    if(nrhs==0) return true;
+
+    hiopProfRegion prof_solve(nlp_->prof, "kkt.solveBlock");
+    nlp_->runStats.kkt.tmSolveRhsManip.start();
+
+    const int nrows = nlpMDS_->nx_de() + ryc[0]->get_size() + ryd[0]->get_size();
+    if(NULL==rhs_block_ || rhs_block_->m() != nrhs) {
+      delete rhs_block_;
+      rhs_block_ = LinearAlgebraFactory::createMatrixDense(nrhs, nrows);
+    }
+    for(int k=0; k<nrhs; k++) {
+      formReducedRhs(*rx[k], *ryc[k], *ryd[k], *dyc[k]);
+      rhs_block_->replaceRow(k, *rhs_);
+    }
+    //the right-hand sides are overwritten by the solve
+    hiopMatrixDense* rhs_save = write_linsys_counter_>=0 ? rhs_block_->new_copy() : NULL;
+    nlp_->runStats.kkt.tmSolveRhsManip.stop();
+
+    nlp_->runStats.kkt.tmSolveTriangular.start();
+    bool linsol_ok = linSys_->solve(*rhs_block_);
+    nlp_->runStats.kkt.tmSolveTriangular.stop();
+    nlp_->runStats.linsolv.end_linsolve();
+
+    if(perf_report_) {
+      nlp_->log->printf(hovSummary, "(summary for linear solver from KKT_MDS_XYcYd)\n%s", 
+			nlp_->runStats.linsolv.get_summary_last_solve().c_str());
+    }
+
+    if(rhs_save) {
+      csr_writer_.writeRhsSolBlockToFile(*rhs_save, *rhs_block_, write_linsys_counter_);
+      delete rhs_save;
+    }
+
+    if(false==linsol_ok) return false;
+
     nlp_->runStats.kkt.tmSolveRhsManip.start();
+    for(int k=0; k<nrhs; k++) {
+      rhs_block_->getRow(k, *rhs_);
+      recoverFromReducedSol(*rx[k], *dx[k], *dyc[k], *dyd[k]);
+    }
+    nlp_->runStats.kkt.tmSolveRhsManip.stop();
+    return true;
+  }
 
+  void hiopKKTLinSysCompressedMDSXYcYd::formReducedRhs(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
+						       hiopVector& dyc)
+  {
     int nx=rx.get_size(), nyc=ryc.get_size(), nyd=ryd.get_size();
     int nxsp=Hxs_->get_size(); assert(nxsp<=nx);
     int nxde = nlpMDS_->nx_de();
@@ -404,31 +551,14 @@ namespace hiop
     dyc.copyToStarting(*rhs_, nxde);
     //ths[nxde+nyc:nxde+nyc+nyd-1] = ryd
     ryd.copyToStarting(*rhs_, nxde+nyc);
+  }
 
-    if(write_linsys_counter_>=0) 
-      csr_writer_.writeRhsToFile(*rhs_, write_linsys_counter_);
-
-    nlp_->runStats.kkt.tmSolveRhsManip.stop();
-
-    nlp_->runStats.kkt.tmSolveTriangular.start();
-    //
-    // solve
-    //
-    bool linsol_ok = linSys_->solve(*rhs_);
-    nlp_->runStats.kkt.tmSolveTriangular.stop();
-    nlp_->runStats.linsolv.end_linsolve();
-
-    if(perf_report_) {
-      nlp_->log->printf(hovSummary, "(summary for linear solver from KKT_MDS_XYcYd)\n%s", 
-			nlp_->runStats.linsolv.get_summary_last_solve().c_str());
-    }
-    
-    if(write_linsys_counter_>=0) 
-      csr_writer_.writeSolToFile(*rhs_, write_linsys_counter_);
-
-    if(false==linsol_ok) return false;
-
-    nlp_->runStats.kkt.tmSolveRhsManip.start();
+  void hiopKKTLinSysCompressedMDSXYcYd::recoverFromReducedSol(hiopVector& rx, hiopVector& dx, 
+							      hiopVector& dyc, hiopVector& dyd)
+  {
+    int nyc=dyc.get_size();
+    int nxsp=Hxs_->get_size();
+    int nxde = nlpMDS_->nx_de();
 
     //
     // unpack 
@@ -452,9 +582,6 @@ namespace hiop
     nlp_->log->write("SOL KKT_MDS_XYcYd dx: ", dx,  hovMatrices);
     nlp_->log->write("SOL KKT_MDS_XYcYd dyc:", dyc, hovMatrices);
     nlp_->log->write("SOL KKT_MDS_XYcYd dyd:", dyd, hovMatrices);
-  
-    nlp_->runStats.kkt.tmSolveRhsManip.stop();
-    return true;
   }
 
   hiopLinSolverIndefDense* 
@@ -108,9 +108,19 @@ public:
   virtual bool solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 			       hiopVector& dx, hiopVector& dyc, hiopVector& dyd);
 
+  /* Performs the reduction for each right-hand side and solves the reduced (dense) systems 
+   * with a single multiple right-hand side solve */
+  virtual bool solveCompressedBlock(std::vector<hiopVector*>& rx, 
+				    std::vector<hiopVector*>& ryc, 
+				    std::vector<hiopVector*>& ryd,
+				    std::vector<hiopVector*>& dx, 
+				    std::vector<hiopVector*>& dyc, 
+				    std::vector<hiopVector*>& dyd);
+
 protected:
   hiopLinSolverIndefDense* linSys_;
   hiopVector *rhs_; //[rxdense, ryc, ryd]
+  hiopMatrixDense* rhs_block_; //rows are the rhs_ of the rhs in 'solveCompressedBlock'
   hiopVector *_buff_xs_; //an auxiliary buffer 
 
   //
@@ -126,6 +136,17 @@ protected:
   // Keeps Hxs = HessMDS->sp_mat() + Dxs (Dx=log-barrier diagonal for xs)
   hiopVector *Hxs_; 
 
+  // Incremental inertia correction (option 'mds_incremental_ic'): 'Msys_cache_' keeps the reduced 
+  // system without the diagonal IC perturbations, that is, the delta-free blocks and the Schur blocks
+  // computed with delta_wx = 'delta_wx_cache_'; 'Hxs_cache_' keeps Hsparse+Dxs. The Schur blocks are 
+  // recomputed only when delta_wx changes; the other IC retries only re-apply the diagonals.
+  bool incremental_ic_;
+  hiopMatrixDense* Msys_cache_;
+  hiopVector *Hxs_cache_;
+  double delta_wx_cache_;
+  // number of times the (sparse) Schur blocks were computed
+  long long n_schur_assemblies_;
+
   //just dynamic_cast-ed pointers
   hiopNlpMDS* nlpMDS_;
   hiopMatrixSymBlockDiagMDS* HessMDS_;
@@ -137,6 +158,33 @@ protected:
   int write_linsys_counter_; 
   hiopCSR_IO csr_writer_;
 
+  /* Eliminates the sparse part xs from the compressed system and forms in 'rhs_' the rhs of the
+   * dense reduced system; 'ryd' is altered and 'dyc' is used as buffer */
+  void formReducedRhs(hiopVector& rx, hiopVector& ryc, hiopVector& ryd, hiopVector& dyc);
+
+  /* Unpacks the solution of the reduced system from 'rhs_' and computes dxs */
+  void recoverFromReducedSol(hiopVector& rx, hiopVector& dx, hiopVector& dyc, hiopVector& dyd);
+
+  /* Adds to 'M' the blocks of the reduced system that do not depend on the IC perturbations,
+   * namely Hd+Dxd, Jcd^T and Jdd^T (profiler region 'denseBlocks') */
+  void addDeltaFreeBlocks(hiopMatrixDense& M);
+
+  /* Adds to 'M' the blocks of the reduced system involving the inverse of 'D' (Hxs), namely
+   * alpha * [Jcs D^{-1} Jcs^T    Jcs D^{-1} Jds^T]
+   *         [      .             Jds D^{-1} Jds^T]
+   * starting at diagonal entry (nxd,nxd) of 'M' (upper triangle only); each of the three sparse
+   * kernels has its own profiler region ('schurJcJc', 'schurJdJd', and 'schurJcJd')
+   */
+  void addSchurBlocks(hiopMatrixDense& M, const double& alpha, const hiopVector& D);
+
+  /* Computes Hxs_ = Hs + Dxs + delta_wx */
+  void computeHxs(const double& delta_wx);
+
+  /* Sets 'M' to the delta-free blocks plus the Schur blocks computed with Hxs_ = Hs + Dxs + delta_wx.
+   * With 'mds_incremental_ic', Hs + Dxs is computed only by the first trial of an update 
+   * ('first_trial' true) and the blocks are recomputed only when delta_wx changes. */
+  void assembleReducedMatrix(hiopMatrixDense& M, const double& delta_wx, bool first_trial);
+
 private:
   //placeholder for the code that decides which linear solver to used based on safe_mode_
   hiopLinSolverIndefDense* determineAndCreateLinsys(int nxd, int neq, int nineq);
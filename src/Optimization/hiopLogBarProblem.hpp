@@ -90,8 +90,14 @@ public:
     mu=mu_; c_nlp=&c_; d_nlp=&d_; Jac_c_nlp=&Jac_c_; Jac_d_nlp=&Jac_d_; iter=&iter_;
     _grad_x_logbar->copyFrom(gradf_);
     _grad_d_logbar->setToZero(); 
+    //the log and damping terms of the function are reduced across ranks in one shot
+    hiopReductionPlan plan(nlp->get_comm());
+    const int idx_logbar = iter->evalLogBarrier(plan);
+    const int idx_damping = kappa_d>0. ? iter->linearDampingTerm(plan, mu, kappa_d) : -1;
+    plan.resolve();
+
     //add log terms to function
-    double aux=-mu * iter->evalLogBarrier();
+    double aux=-mu * plan.get(idx_logbar);
     f_logbar = f + aux;
 
 #ifdef HIOP_DEEPCHECKS
@@ -110,7 +116,7 @@ public:
       iter->addLinearDampingTermToGrad_x(mu,kappa_d,1.0,*_grad_x_logbar);
       iter->addLinearDampingTermToGrad_d(mu,kappa_d,1.0,*_grad_d_logbar);
 
-      f_logbar += iter->linearDampingTerm(mu,kappa_d);
+      f_logbar += plan.get(idx_damping);
 #ifdef HIOP_DEEPCHECKS
       nlp->log->write("gradx_log_bar final, with damping:", *_grad_x_logbar, hovLinesearchVerb);
       nlp->log->write("gradd_log_bar final, with damping:", *_grad_d_logbar, hovLinesearchVerb);
@@ -125,8 +131,13 @@ public:
     nlp->runStats.tmSolverInternal.start();
     
     c_nlp_trial=&c_; d_nlp_trial=&d_; iter_trial=&iter_;
-    f_logbar_trial = f - mu * iter_trial->evalLogBarrier();
-    if(kappa_d>0.) f_logbar_trial += iter_trial->linearDampingTerm(mu,kappa_d);
+    hiopReductionPlan plan(nlp->get_comm());
+    const int idx_logbar = iter_trial->evalLogBarrier(plan);
+    const int idx_damping = kappa_d>0. ? iter_trial->linearDampingTerm(plan, mu, kappa_d) : -1;
+    plan.resolve();
+
+    f_logbar_trial = f - mu * plan.get(idx_logbar);
+    if(kappa_d>0.) f_logbar_trial += plan.get(idx_damping);
 
     nlp->runStats.tmSolverInternal.stop();
   }
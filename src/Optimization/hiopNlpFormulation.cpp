@@ -51,6 +51,7 @@
 #include "hiopVector.hpp"
 #include "hiopLinAlgFactory.hpp"
 #include "hiopLogger.hpp"
+#include "hiopLinSolverWorkspacePool.hpp"
 
 #ifdef HIOP_USE_MPI
 #include "mpi.h"
@@ -73,6 +74,9 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_)
 {
   strFixedVars = ""; //uninitialized
   dFixedVarsTol=-1.; //uninitialized
+  strScaling = ""; //uninitialized
+  dScalingMaxGrad=-1.; //uninitialized
+  nlp_scaling_ = NULL;
   bool bret;
 #ifdef HIOP_USE_MPI
   bret = interface_base.get_MPI_comm(comm); assert(bret);
@@ -102,6 +106,8 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_)
   options->SetLog(log);
   //log->write(NULL, *options, hovSummary);//! comment this at some point
 
+  omp_params_.set(options->GetInteger("num_threads"), options->GetInteger("omp_serial_threshold"));
+
   runStats = hiopRunStats(comm);
 
   /* NLP members intialization */
@@ -124,9 +130,13 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_)
   vec_distrib=NULL;
 #endif
   cons_eval_type_ = -1;
+  derivs_eval_type_ = -1;
   cons_body_ = NULL;
   cons_Jac_ = NULL;
   cons_lambdas_ = NULL;
+  zl_user_ = NULL;
+  zu_user_ = NULL;
+  dense_linsolver_ws_pool_ = NULL;
 }
 
 hiopNlpFormulation::~hiopNlpFormulation()
@@ -163,6 +173,17 @@ hiopNlpFormulation::~hiopNlpFormulation()
   delete[] cons_body_;
   delete cons_Jac_;
   delete[] cons_lambdas_;
+  delete zl_user_;
+  delete zu_user_;
+  delete dense_linsolver_ws_pool_;
+}
+
+hiopDenseLinSolverWorkspacePool& hiopNlpFormulation::get_dense_linsolver_ws_pool()
+{
+  if(NULL==dense_linsolver_ws_pool_) {
+    dense_linsolver_ws_pool_ = new hiopDenseLinSolverWorkspacePool();
+  }
+  return *dense_linsolver_ws_pool_;
 }
 
 bool hiopNlpFormulation::finalizeInitialization()
@@ -176,7 +197,12 @@ bool hiopNlpFormulation::finalizeInitialization()
   if(dFixedVarsTol != fixedVarTol) {
     doinit=true;
   }
-  //more tests here (for example change in the rescaling)
+  if(strScaling != options->GetString("scaling_type")) {
+    doinit=true;
+  }
+  if(dScalingMaxGrad != options->GetNumeric("scaling_max_grad")) {
+    doinit=true;
+  }
   if(!doinit) {
     return true;
   } else {
@@ -187,6 +213,8 @@ bool hiopNlpFormulation::finalizeInitialization()
 
   nlp_transformations.clear();
   nlp_transformations.setUserNlpNumVars(n_vars);
+  //the scaling is computed at the starting point, see 'get_starting_point'
+  nlp_scaling_ = NULL;
 
   if(xl) delete xl;
   if(xu) delete xu;
@@ -204,6 +232,7 @@ bool hiopNlpFormulation::finalizeInitialization()
 #else
   xl   = LinearAlgebraFactory::createVector(n_vars);
 #endif  
+  xl->set_omp_params(&omp_params_);
   xu = xl->alloc_clone();
 
   int nlocal=xl->get_local_size();
@@ -380,6 +409,9 @@ bool hiopNlpFormulation::finalizeInitialization()
   cons_eq_type = new  hiopInterfaceBase::NonlinearityType[n_cons_eq];
   dl    = LinearAlgebraFactory::createVector(n_cons_ineq);
   du    = LinearAlgebraFactory::createVector(n_cons_ineq);
+  c_rhs->set_omp_params(&omp_params_);
+  dl->set_omp_params(&omp_params_);
+  du->set_omp_params(&omp_params_);
   cons_ineq_type = new  hiopInterfaceBase::NonlinearityType[n_cons_ineq];
   cons_eq_mapping_   = new long long[n_cons_eq];
   cons_ineq_mapping_ = new long long[n_cons_ineq];
@@ -433,6 +465,8 @@ bool hiopNlpFormulation::finalizeInitialization()
     fixedVarsRemover->setupConstraintsPart(n_cons_eq, n_cons_ineq);
   }
   strFixedVars = options->GetString("fixed_var");
+  strScaling = options->GetString("scaling_type");
+  dScalingMaxGrad = options->GetNumeric("scaling_max_grad");
 
   //compute the overall n_low and n_upp
 #ifdef HIOP_USE_MPI
@@ -445,6 +479,7 @@ bool hiopNlpFormulation::finalizeInitialization()
 
   //reset/release info and data related to one-call constraints evaluation
   cons_eval_type_ = -1;
+  derivs_eval_type_ = -1;
   
   delete[] cons_body_;
   cons_body_ = NULL;
@@ -454,6 +489,11 @@ bool hiopNlpFormulation::finalizeInitialization()
 
   delete[] cons_lambdas_;
   cons_lambdas_ = NULL;
+
+  delete zl_user_;
+  zl_user_ = NULL;
+  delete zu_user_;
+  zu_user_ = NULL;
   return bret;
 }
 
@@ -477,6 +517,7 @@ hiopVector* hiopNlpFormulation::alloc_dual_vec() const
 #ifdef HIOP_DEEPCHECKS
   assert(ret!=NULL);
 #endif
+  ret->set_omp_params(&omp_params_);
   return ret;
 }
 
@@ -484,11 +525,12 @@ bool hiopNlpFormulation::eval_f(double* x, bool new_x, double& f)
 {
   double* xx = nlp_transformations.applyTox(x, new_x);
 
+  hiopProfRegion prof_reg(prof, "eval_f");
   runStats.tmEvalObj.start();
   bool bret = interface_base.eval_f(nlp_transformations.n_post(),xx,new_x,f);
   runStats.tmEvalObj.stop(); runStats.nEvalObj++;
 
-  f = nlp_transformations.applyToObj(f);
+  f = nlp_transformations.applyInvToObj(f);
   return bret;
 }
 bool hiopNlpFormulation::eval_grad_f(double* x, bool new_x, double* gradf)
@@ -496,6 +538,7 @@ bool hiopNlpFormulation::eval_grad_f(double* x, bool new_x, double* gradf)
   double* xx     = nlp_transformations.applyTox(x, new_x);
   double* gradff = nlp_transformations.applyToGradObj(gradf);
   bool bret; 
+  hiopProfRegion prof_reg(prof, "eval_grad_f");
   runStats.tmEvalGrad_f.start();
   bret = interface_base.eval_grad_f(nlp_transformations.n_post(),xx,new_x,gradff);
   runStats.tmEvalGrad_f.stop(); runStats.nEvalGrad_f++;
@@ -531,6 +574,27 @@ bool hiopNlpFormulation::get_starting_point(hiopVector& x0,
 					   zL0_for_user,
 					   zU0_for_user,
 					   lambda_for_user);
+  if(!bret) {
+    duals_avail = false;
+    bret = interface_base.get_starting_point(nlp_transformations.n_post(), x0_for_user);
+  }
+  
+  if(bret) {
+    nlp_transformations.applyInvTox(x0_for_user, x0_for_hiop);
+
+    //the scaling factors are computed at the (first) starting point and are kept for subsequent
+    //solves, unless the options relevant to the transformations change
+    if(strScaling=="gradient" && NULL==nlp_scaling_) {
+      if(!setup_scaling(x0)) {
+	return false;
+      }
+    }
+  } else {
+    if(strScaling=="gradient" && NULL==nlp_scaling_) {
+      log->printf(hovWarning, "the problem is not scaled since the user did not provide a starting point\n");
+    }
+  }
+
   if(duals_avail) {
     double* yc0d = yc0_for_hiop.local_data();
     double* yd0d = yd0_for_hiop.local_data();
@@ -538,6 +602,10 @@ bool hiopNlpFormulation::get_starting_point(hiopVector& x0,
     assert(n_cons_eq   == yc0.get_size() && "when did the cons change?");
     assert(n_cons_ineq == yd0.get_size() && "when did the cons change?");
     assert(n_cons_eq+n_cons_ineq == n_cons);
+
+    nlp_transformations.applyInvToConsDuals(lambda_for_user, n_cons);
+    nlp_transformations.applyInvToBoundsDuals(zL0_for_user, zL0.get_local_size());
+    nlp_transformations.applyInvToBoundsDuals(zU0_for_user, zU0.get_local_size());
     
     //copy back 
     for(int i=0; i<n_cons_eq; ++i) {
@@ -548,14 +616,39 @@ bool hiopNlpFormulation::get_starting_point(hiopVector& x0,
     }
   }
   
-  if(!bret) {
-    bret = interface_base.get_starting_point(nlp_transformations.n_post(), x0_for_user);
-  }
-  
+  return bret;
+}
+
+bool hiopNlpFormulation::setup_scaling(hiopVector& x0)
+{
+  assert(NULL == nlp_scaling_);
+  hiopVector* gradf = alloc_primal_vec();
+  hiopMatrix *Jac_c, *Jac_d;
+  alloc_Jac_c_d(Jac_c, Jac_d);
+
+  double* x0a = x0.local_data();
+  bool bret = eval_grad_f(x0a, true, gradf->local_data());
   if(bret) {
-    nlp_transformations.applyInvTox(x0_for_user, x0_for_hiop);
+    bret = eval_Jac_c_d(x0a, false, *Jac_c, *Jac_d);
   }
-  
+  if(!bret) {
+    log->printf(hovError, "the evaluation of the derivatives needed by the scaling failed\n");
+  } else {
+    const long long n_user = nlp_transformations.n_post();
+    const int n_user_local = nlp_transformations.n_post_local();
+    nlp_scaling_ = new hiopNLPObjGradScaling(dScalingMaxGrad, *gradf, *Jac_c, *Jac_d, 
+					     cons_eq_mapping_, cons_ineq_mapping_,
+					     n_user, n_user_local);
+    nlp_transformations.append(nlp_scaling_);
+    nlp_scaling_->applyInvToConsBounds(*c_rhs, *dl, *idl, *du, *idu);
+
+    log->printf(hovSummary, "Gradient-based scaling: objective scaled by %.3e, %d out of %lld "
+		"constraints scaled.\n", nlp_scaling_->get_obj_scale(), nlp_scaling_->get_num_scaled_cons(),
+		n_cons);
+  }
+  delete Jac_d;
+  delete Jac_c;
+  delete gradf;
   return bret;
 }
 
@@ -564,6 +657,7 @@ bool hiopNlpFormulation::eval_c(double*x, bool new_x, double* c)
   double* xx = nlp_transformations.applyTox(x, new_x);
   double* cc = c;//nlp_transformations.applyToCons(c, n_cons_eq); //not needed for now
 
+  hiopProfRegion prof_reg(prof, "eval_cons");
   runStats.tmEvalCons.start();
   bool bret = interface_base.eval_cons(nlp_transformations.n_post(),
 				       n_cons,n_cons_eq,
@@ -572,7 +666,7 @@ bool hiopNlpFormulation::eval_c(double*x, bool new_x, double* c)
 				       cc);
   runStats.tmEvalCons.stop(); runStats.nEvalCons_eq++;
 
-  //c = nlp_transformations.applyInvToCons(c, n_cons_eq); //not needed for now
+  c = nlp_transformations.applyInvToConsEq(cc, n_cons_eq);
   return bret;
 }
 bool hiopNlpFormulation::eval_d(double*x, bool new_x, double* d)
@@ -580,13 +674,14 @@ bool hiopNlpFormulation::eval_d(double*x, bool new_x, double* d)
   double* xx = nlp_transformations.applyTox(x, new_x);
   double* dd = d;//nlp_transformations.applyToCons(d, n_cons_ineq); //not needed for now
 
+  hiopProfRegion prof_reg(prof, "eval_cons");
   runStats.tmEvalCons.start();
   bool bret = interface_base.eval_cons(nlp_transformations.n_post(),
 				       n_cons, n_cons_ineq, cons_ineq_mapping_,
 				       xx, new_x, dd);
   runStats.tmEvalCons.stop(); runStats.nEvalCons_ineq++;
 
-  //d = nlp_transformations.applyInvToCons(d, n_cons_ineq); //not needed for now
+  d = nlp_transformations.applyInvToConsIneq(dd, n_cons_ineq);
   return bret;
 }
 
@@ -627,10 +722,12 @@ bool hiopNlpFormulation::eval_c_d(double*x, bool new_x, double* c, double* d)
     double* xx = nlp_transformations.applyTox(x, new_x);
     double* body = cons_body_;//nlp_transformations.applyToCons(d, n_cons_ineq); //not needed for now
 
+    hiopProfRegion prof_reg(prof, "eval_cons");
     runStats.tmEvalCons.start();
     bool bret = interface_base.eval_cons(nlp_transformations.n_post(),
 					 n_cons, 
 					 xx, new_x, body);
+    body = nlp_transformations.applyInvToCons(body, n_cons);
     //copy back to c and d
     for(int i=0; i<n_cons_eq; ++i) {
       c[i] = body[cons_eq_mapping_[i]];
@@ -643,7 +740,6 @@ bool hiopNlpFormulation::eval_c_d(double*x, bool new_x, double* c, double* d)
     runStats.nEvalCons_eq++;
     runStats.nEvalCons_ineq++;
     
-    //d = nlp_transformations.applyInvToCons(d, n_cons_ineq); //not needed for now
     return bret;
   }
 }
@@ -686,6 +782,40 @@ bool hiopNlpFormulation::eval_Jac_c_d(double* x, bool new_x, hiopMatrix& Jac_c,
   return true;
 }
 
+bool hiopNlpFormulation::eval_derivs(double* x, bool new_x,
+				     double* gradf,
+				     hiopMatrix& Jac_c, hiopMatrix& Jac_d,
+				     const double& obj_factor,
+				     const double* lambda_eq,
+				     const double* lambda_ineq,
+				     bool new_lambdas,
+				     hiopMatrix& Hess_L)
+{
+  if(0 != derivs_eval_type_) {
+    bool bret = eval_derivs_interface_impl(x, new_x, gradf, Jac_c, Jac_d,
+					   obj_factor, lambda_eq, lambda_ineq, new_lambdas, Hess_L);
+    if(1 == derivs_eval_type_) {
+      return bret;
+    }
+    assert(-1 == derivs_eval_type_);
+    if(bret) {
+      derivs_eval_type_ = 1;
+      return true;
+    }
+    //the user does not provide the one-call evaluator; use the individual evaluators from now on
+    derivs_eval_type_ = 0;
+    log->printf(hovScalars, "One-call derivatives evaluation not available; will evaluate separately.\n");
+  }
+
+  if(!eval_grad_f(x, new_x, gradf)) {
+    return false;
+  }
+  if(!eval_Jac_c_d(x, new_x, Jac_c, Jac_d)) {
+    return false;
+  }
+  return eval_Hess_Lagr(x, new_x, obj_factor, lambda_eq, lambda_ineq, new_lambdas, Hess_L);
+}
+
 void hiopNlpFormulation::
 get_dual_solutions(const hiopIterate& it, double* zl_a, double* zu_a, double* lambda_a)
 {
@@ -693,8 +823,11 @@ get_dual_solutions(const hiopIterate& it, double* zl_a, double* zu_a, double* la
   const hiopVectorPar& zu = dynamic_cast<hiopVectorPar&>(*it.get_zu());
   zl.copyTo(zl_a);
   zu.copyTo(zu_a);
+  nlp_transformations.applyToBoundsDuals(zl_a, zl.get_local_size());
+  nlp_transformations.applyToBoundsDuals(zu_a, zu.get_local_size());
 
   copy_EqIneq_to_cons(*it.get_yc(), *it.get_yd(), n_cons, lambda_a);
+  nlp_transformations.applyToConsDuals(lambda_a, n_cons);
 }
 
 void hiopNlpFormulation::copy_EqIneq_to_cons(const hiopVector& yc_in,
@@ -715,6 +848,19 @@ void hiopNlpFormulation::copy_EqIneq_to_cons(const hiopVector& yc_in,
   }
 }
 
+const double* hiopNlpFormulation::user_bounds_duals(const hiopVector& z, hiopVector*& z_user)
+{
+  //the multipliers of the bounds change only when the problem is scaled
+  if(NULL == nlp_scaling_) {
+    return z.local_data_const();
+  }
+  if(NULL == z_user) {
+    z_user = z.alloc_clone();
+  }
+  z_user->copyFrom(z);
+  return nlp_transformations.applyToBoundsDuals(z_user->local_data(), z_user->get_local_size());
+}
+
 void hiopNlpFormulation::user_callback_solution(hiopSolveStatus status,
 						const hiopVector& x,
 						const hiopVector& z_L,
@@ -744,16 +890,22 @@ void hiopNlpFormulation::user_callback_solution(hiopSolveStatus status,
     cons_body_ = new double[n_cons];
   }
   copy_EqIneq_to_cons(c, d, n_cons, cons_body_);
+
+  //transform to the user's scale
+  nlp_transformations.applyToConsDuals(cons_lambdas_, n_cons);
+  nlp_transformations.applyToCons(cons_body_, n_cons);
+  const double* zl_a = user_bounds_duals(zl, zl_user_);
+  const double* zu_a = user_bounds_duals(zu, zu_user_);
   
   //! todo -> test this when fixed variables are removed -> the internal
   //! zl and zu may have different sizes than what user expects since HiOp removes
   //! variables internally
   interface_base.solution_callback(status, 
 				   (int)n_vars, xp.local_data_const(),
-				   zl.local_data_const(), zu.local_data_const(),
+				   zl_a, zu_a,
 				   (int)n_cons, cons_body_,
 				   cons_lambdas_,
-				   obj_value);
+				   user_obj(obj_value));
 }
 
 bool hiopNlpFormulation::user_callback_iterate(int iter,
@@ -792,14 +944,20 @@ bool hiopNlpFormulation::user_callback_iterate(int iter,
     cons_body_ = new double[n_cons];
   }
   copy_EqIneq_to_cons(c, d, n_cons, cons_body_);
+
+  //transform to the user's scale
+  nlp_transformations.applyToConsDuals(cons_lambdas_, n_cons);
+  nlp_transformations.applyToCons(cons_body_, n_cons);
+  const double* zl_a = user_bounds_duals(zl, zl_user_);
+  const double* zu_a = user_bounds_duals(zu, zu_user_);
   
   //! todo -> test this when fixed variables are removed -> the internal
   //! zl and zu may have different sizes than what user expects since HiOp removes
   //! variables internally
   
-  return interface_base.iterate_callback(iter, obj_value, 
+  return interface_base.iterate_callback(iter, user_obj(obj_value), 
 					 (int)n_vars, xp.local_data_const(),
-					 zl.local_data_const(), zu.local_data_const(),
+					 zl_a, zu_a,
 					 (int)n_cons, cons_body_, 
 					 cons_lambdas_,
 					 inf_pr, inf_du, mu, alpha_du, alpha_pr,  ls_trials);
@@ -855,6 +1013,7 @@ bool hiopNlpDenseConstraints::eval_Jac_c(double* x, bool new_x, double** Jac_c)
   double*  x_user      = nlp_transformations.applyTox(x, new_x);
   double** Jac_c_user = nlp_transformations.applyToJacobEq(Jac_c, n_cons_eq);
 
+  hiopProfRegion prof_reg(prof, "eval_Jac_cons");
   runStats.tmEvalJac_con.start();
   bool bret = interface.eval_Jac_cons(nlp_transformations.n_post(),n_cons,n_cons_eq,cons_eq_mapping_,
 				      x_user,new_x,Jac_c_user);
@@ -868,6 +1027,7 @@ bool hiopNlpDenseConstraints::eval_Jac_d(double* x, bool new_x, double** Jac_d)
   double* x_user      = nlp_transformations.applyTox(x, new_x);
   double** Jac_d_user = nlp_transformations.applyToJacobIneq(Jac_d, n_cons_ineq);
  
+  hiopProfRegion prof_reg(prof, "eval_Jac_cons");
   runStats.tmEvalJac_con.start();
   bool bret = interface.eval_Jac_cons(nlp_transformations.n_post(),n_cons,n_cons_ineq,cons_ineq_mapping_,
 				      x_user,new_x,Jac_d_user);
@@ -897,6 +1057,7 @@ bool hiopNlpDenseConstraints::eval_Jac_c_d_interface_impl(double* x, bool new_x,
   double** Jac_consde = cons_Jac_de->local_data();
   double** Jac_user = nlp_transformations.applyToJacobCons(Jac_consde, n_cons);
 
+  hiopProfRegion prof_reg(prof, "eval_Jac_cons");
   runStats.tmEvalJac_con.start();
   bool bret = interface.eval_Jac_cons(nlp_transformations.n_post(), n_cons,
 				      x_user, new_x,
@@ -953,6 +1114,14 @@ hiopMatrixDense* hiopNlpDenseConstraints::alloc_Jac_cons()
   return alloc_multivector_primal(n_cons);
 }
 
+void hiopNlpDenseConstraints::alloc_Jac_c_d(hiopMatrix*& Jac_c, hiopMatrix*& Jac_d)
+{
+  hiopMatrixDense* Jac_c_de = alloc_multivector_primal(n_cons_eq, n_cons);
+  Jac_d = Jac_c_de->new_rows_view(n_cons_eq, n_cons_ineq);
+  assert(Jac_d);
+  Jac_c = Jac_c_de;
+}
+
 hiopMatrix* hiopNlpDenseConstraints::alloc_Hess_Lagr()
 {
   return new hiopHessianLowRank(this, this->options->GetInteger("secant_memory_len"));
@@ -981,9 +1150,35 @@ hiopMatrixDense* hiopNlpDenseConstraints::alloc_multivector_primal(int nrows, in
   else
     M = LinearAlgebraFactory::createMatrixDense(nrows, n_vars, NULL, MPI_COMM_SELF, maxrows);
 #endif
+  M->set_omp_params(&omp_params_);
   return M;
 }
 
+void hiopNlpDenseConstraints::stack_Jac_c_d(const hiopMatrixDense& Jac_c, const hiopMatrixDense& Jac_d, 
+					    hiopMatrixDense*& J, bool& J_is_view) const
+{
+  if(!J_is_view || J->local_buffer() != Jac_c.local_buffer()) {
+    hiopMatrixDense* Jview = Jac_c.new_rows_view(0, m());
+    if(Jview && Jview->m()>m_eq() && Jview->local_data()[m_eq()] != Jac_d.local_data()[0]) {
+      delete Jview;
+      Jview = NULL;
+    }
+    if(Jview) {
+      delete J;
+      J = Jview;
+      J_is_view = true;
+    } else if(NULL==J || J_is_view) {
+      delete J;
+      J = alloc_multivector_primal(m());
+      J_is_view = false;
+    }
+  }
+  if(!J_is_view) {
+    J->copyRowsFrom(Jac_c, m_eq(), 0);
+    J->copyRowsFrom(Jac_d, m_ineq(), m_eq());
+  }
+}
+
 /* ***********************************************************************************
  *    hiopNlpMDS class implementation 
  * ***********************************************************************************
@@ -994,9 +1189,8 @@ bool hiopNlpMDS::eval_Jac_c(double* x, bool new_x, hiopMatrix& Jac_c)
   assert(pJac_c);
   if(pJac_c) {
     double* x_user = nlp_transformations.applyTox(x, new_x);
-    //! todo -> need hiopNlpTransformation::applyToJacobXXX to work with MDS Jacobian
-    //double** Jac_c_user = nlp_transformations.applyToJacobEq(Jac_c, n_cons_eq); //!
     
+    hiopProfRegion prof_reg(prof, "eval_Jac_cons");
     runStats.tmEvalJac_con.start();
     
     int nnz = pJac_c->sp_nnz();
@@ -1007,8 +1201,7 @@ bool hiopNlpMDS::eval_Jac_c(double* x, bool new_x, hiopMatrix& Jac_c)
 					nnz, pJac_c->sp_irow(), pJac_c->sp_jcol(), pJac_c->sp_M(),
 					pJac_c->de_local_data());
 
-    //! todo -> need hiopNlpTransformation::applyInvToJacobXXX to work with MDS Jacobian
-    //Jac_c = nlp_transformations.applyInvToJacobEq(Jac_c_user, n_cons_eq); //!
+    nlp_transformations.applyInvToJacobEq(*pJac_c, n_cons_eq);
     runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_eq++;
     return bret;
@@ -1022,9 +1215,8 @@ bool hiopNlpMDS::eval_Jac_d(double* x, bool new_x, hiopMatrix& Jac_d)
   assert(pJac_d);
   if(pJac_d) {
     double* x_user      = nlp_transformations.applyTox(x, new_x);
-    //! todo -> need hiopNlpTransformation::applyToJacobXXX to work with MDS Jacobian
-    //double** Jac_d_user = nlp_transformations.applyToJacobIneq(Jac_d, n_cons_ineq);
     
+    hiopProfRegion prof_reg(prof, "eval_Jac_cons");
     runStats.tmEvalJac_con.start();
   
     int nnz = pJac_d->sp_nnz();
@@ -1035,8 +1227,7 @@ bool hiopNlpMDS::eval_Jac_d(double* x, bool new_x, hiopMatrix& Jac_d)
 					 nnz, pJac_d->sp_irow(), pJac_d->sp_jcol(), pJac_d->sp_M(),
 					 pJac_d->de_local_data());
 
-    //! todo -> need hiopNlpTransformation::applyInvToJacobXXX to work with MDS Jacobian
-    //Jac_d = nlp_transformations.applyInvToJacobIneq(Jac_d_user, n_cons_ineq);
+    nlp_transformations.applyInvToJacobIneq(*pJac_d, n_cons_ineq);
     runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_ineq++;
     return bret;
@@ -1062,9 +1253,8 @@ bool hiopNlpMDS::eval_Jac_c_d_interface_impl(double* x,
     assert(cons_Jac->sp_nnz() == pJac_c->sp_nnz() + pJac_d->sp_nnz());
     
     double* x_user      = nlp_transformations.applyTox(x, new_x);
-    //! todo -> need hiopNlpTransformation::applyInvToJacobIneq to work with MDS Jacobian
-    //double** Jac_d_user = nlp_transformations.applyToJacobIneq(Jac_d, n_cons_ineq);
     
+    hiopProfRegion prof_reg(prof, "eval_Jac_cons");
     runStats.tmEvalJac_con.start();
   
     int nnz = cons_Jac->sp_nnz();
@@ -1073,8 +1263,7 @@ bool hiopNlpMDS::eval_Jac_c_d_interface_impl(double* x,
 					pJac_d->n_sp(), pJac_d->n_de(), 
 					nnz, cons_Jac->sp_irow(), cons_Jac->sp_jcol(), cons_Jac->sp_M(),
 					cons_Jac->de_local_data());
-    //! todo -> need hiopNlpTransformation::applyInvToJacobIneq to work with MDS Jacobian
-    //Jac_d = nlp_transformations.applyInvToJacobIneq(Jac_d_user, n_cons_ineq);
+    nlp_transformations.applyInvToJacobCons(*cons_Jac, n_cons);
     
     //copy back to Jac_c and Jac_d
     pJac_c->copyRowsFrom(*cons_Jac, cons_eq_mapping_, n_cons_eq);
@@ -1098,6 +1287,7 @@ bool hiopNlpMDS::eval_Hess_Lagr(const double* x, bool new_x, const double& obj_f
   hiopMatrixSymBlockDiagMDS* pHessL = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(&Hess_L);
   assert(pHessL);
 
+  hiopProfRegion prof_reg(prof, "eval_Hess_Lagr");
   runStats.tmEvalHessL.start();
 
   bool bret = false;
@@ -1111,11 +1301,15 @@ bool hiopNlpMDS::eval_Hess_Lagr(const double* x, bool new_x, const double& obj_f
     assert(_buf_lambda);
     _buf_lambda->copyFromStarting(0,         lambda_eq,   n_cons_eq);
     _buf_lambda->copyFromStarting(n_cons_eq, lambda_ineq, n_cons_ineq);
+    double* lambda_user = _buf_lambda->local_data();
+    nlp_transformations.applyToHessConsEqMults  (lambda_user,           n_cons_eq);
+    nlp_transformations.applyToHessConsIneqMults(lambda_user+n_cons_eq, n_cons_ineq);
+    const double obj_factor_user = nlp_transformations.applyToHessObjFactor(obj_factor);
     
     int nnzHSS = pHessL->sp_nnz(), nnzHSD = 0;
     
     bret = interface.eval_Hess_Lagr(n_vars, n_cons, x, new_x, 
-				    obj_factor, _buf_lambda->local_data(), new_lambdas, 
+				    obj_factor_user, lambda_user, new_lambdas, 
 				    pHessL->n_sp(), pHessL->n_de(),
 				    nnzHSS, pHessL->sp_irow(), pHessL->sp_jcol(), pHessL->sp_M(),
 				    pHessL->de_local_data(),
@@ -1133,6 +1327,79 @@ bool hiopNlpMDS::eval_Hess_Lagr(const double* x, bool new_x, const double& obj_f
   return bret;
 }
 
+bool hiopNlpMDS::eval_derivs_interface_impl(double* x, bool new_x,
+					    double* gradf,
+					    hiopMatrix& Jac_c, hiopMatrix& Jac_d,
+					    const double& obj_factor,
+					    const double* lambda_eq,
+					    const double* lambda_ineq,
+					    bool new_lambdas,
+					    hiopMatrix& Hess_L)
+{
+  hiopMatrixMDS* pJac_c = dynamic_cast<hiopMatrixMDS*>(&Jac_c);
+  hiopMatrixMDS* pJac_d = dynamic_cast<hiopMatrixMDS*>(&Jac_d);
+  hiopMatrixSymBlockDiagMDS* pHessL = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(&Hess_L);
+  assert(pJac_c && pJac_d && pHessL);
+  if(NULL==pJac_c || NULL==pJac_d || NULL==pHessL) {
+    return false;
+  }
+
+  //the full Jacobian buffer is also used by the one-call Jacobian evaluator; it is allocated here 
+  //when the constraints are evaluated separately
+  if(NULL == cons_Jac_) {
+    cons_Jac_ = alloc_Jac_cons();
+  }
+  hiopMatrixMDS* cons_Jac = dynamic_cast<hiopMatrixMDS*>(cons_Jac_);
+  assert(cons_Jac);
+  assert(cons_Jac->sp_nnz() == pJac_c->sp_nnz() + pJac_d->sp_nnz());
+
+  if(n_cons_eq + n_cons_ineq != _buf_lambda->get_size()) {
+    delete _buf_lambda;
+    _buf_lambda = LinearAlgebraFactory::createVector(n_cons_eq + n_cons_ineq);
+  }
+  _buf_lambda->copyFromStarting(0,         lambda_eq,   n_cons_eq);
+  _buf_lambda->copyFromStarting(n_cons_eq, lambda_ineq, n_cons_ineq);
+  double* lambda_user = _buf_lambda->local_data();
+  nlp_transformations.applyToHessConsEqMults  (lambda_user,           n_cons_eq);
+  nlp_transformations.applyToHessConsIneqMults(lambda_user+n_cons_eq, n_cons_ineq);
+  const double obj_factor_user = nlp_transformations.applyToHessObjFactor(obj_factor);
+
+  double* x_user = nlp_transformations.applyTox(x, new_x);
+  double* gradf_user = nlp_transformations.applyToGradObj(gradf);
+
+  //the timer of the gradient accounts for the entire one-call evaluation
+  hiopProfRegion prof_reg(prof, "eval_derivs");
+  runStats.tmEvalGrad_f.start();
+  int nnzJacS = cons_Jac->sp_nnz(), nnzHSS = pHessL->sp_nnz(), nnzHSD = 0;
+  bool bret = interface.eval_derivs(n_vars, n_cons, x_user, new_x,
+				    obj_factor_user, lambda_user, new_lambdas,
+				    pJac_d->n_sp(), pJac_d->n_de(),
+				    gradf_user,
+				    nnzJacS, cons_Jac->sp_irow(), cons_Jac->sp_jcol(), cons_Jac->sp_M(),
+				    cons_Jac->de_local_data(),
+				    nnzHSS, pHessL->sp_irow(), pHessL->sp_jcol(), pHessL->sp_M(),
+				    pHessL->de_local_data(),
+				    nnzHSD, NULL, NULL, NULL);
+  runStats.tmEvalGrad_f.stop();
+  if(!bret) {
+    return false;
+  }
+  assert(nnzHSD==0);
+
+  gradf = nlp_transformations.applyInvToGradObj(gradf_user);
+  nlp_transformations.applyInvToJacobCons(*cons_Jac, n_cons);
+
+  //copy back to Jac_c and Jac_d
+  pJac_c->copyRowsFrom(*cons_Jac, cons_eq_mapping_, n_cons_eq);
+  pJac_d->copyRowsFrom(*cons_Jac, cons_ineq_mapping_, n_cons_ineq);
+
+  runStats.nEvalGrad_f++;
+  runStats.nEvalJac_con_eq++;
+  runStats.nEvalJac_con_ineq++;
+  runStats.nEvalHessL++;
+  return true;
+}
+
 bool hiopNlpMDS::finalizeInitialization()
 {
   if(!interface.get_sparse_dense_blocks_info(nx_sparse, nx_dense,
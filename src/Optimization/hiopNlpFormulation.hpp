@@ -61,13 +61,16 @@
 #include "hiopNlpTransforms.hpp"
 
 #include "hiopRunStats.hpp"
+#include "hiopProfiler.hpp"
 #include "hiopLogger.hpp"
 #include "hiopOptions.hpp"
+#include "hiopOmp.hpp"
 
 #include <cstring>
 
 namespace hiop
 {
+class hiopDenseLinSolverWorkspacePool;
 
 /** Class for a general NlpFormulation with general constraints and bounds on the variables. 
  * This class also  acts as a factory for linear algebra objects (derivative 
@@ -114,6 +117,33 @@ public:
 			      const double* lambda_ineq, 
 			      bool new_lambdas, 
 			      hiopMatrix& Hess_L)=0;
+  /** 
+   * Evaluates the gradient of the objective, the Jacobians of the constraints, and the Hessian 
+   * of the Lagrangian at the same point. The one-call user evaluator 'eval_derivs' is used when 
+   * the user provides it, otherwise the individual evaluators above are called.
+   */
+  virtual bool eval_derivs(double* x, bool new_x,
+			   double* gradf,
+			   hiopMatrix& Jac_c, hiopMatrix& Jac_d,
+			   const double& obj_factor,
+			   const double* lambda_eq,
+			   const double* lambda_ineq,
+			   bool new_lambdas,
+			   hiopMatrix& Hess_L);
+protected:
+  //calls specific hiopInterfaceXXX::eval_derivs; returns false when the interface does not support it
+  virtual bool eval_derivs_interface_impl(double* x, bool new_x,
+					  double* gradf,
+					  hiopMatrix& Jac_c, hiopMatrix& Jac_d,
+					  const double& obj_factor,
+					  const double* lambda_eq,
+					  const double* lambda_ineq,
+					  bool new_lambdas,
+					  hiopMatrix& Hess_L)
+  {
+    return false;
+  }
+public:
   /* starting point */
   virtual bool get_starting_point(hiopVector& x0,
 				  bool& duals_avail,
@@ -129,6 +159,13 @@ public:
   virtual hiopMatrix* alloc_Jac_c() = 0;
   virtual hiopMatrix* alloc_Jac_d() = 0;
   virtual hiopMatrix* alloc_Jac_cons() = 0;
+  /* allocates both Jacobians; specializations may store them in a shared buffer, in which case
+   * 'Jac_c' owns the buffer and should be deleted after 'Jac_d' is no longer used */
+  virtual void alloc_Jac_c_d(hiopMatrix*& Jac_c, hiopMatrix*& Jac_d)
+  {
+    Jac_c = alloc_Jac_c();
+    Jac_d = alloc_Jac_d();
+  }
   virtual hiopMatrix* alloc_Hess_Lagr() = 0;
 
   virtual
@@ -179,6 +216,9 @@ public:
   inline long long n_low_local() const {return n_bnds_low_local;}
   inline long long n_upp_local() const {return n_bnds_upp_local;}
 
+  /* the gradient scaling of the problem; NULL when the problem is not scaled */
+  inline const hiopNLPObjGradScaling* get_nlp_scaling() const { return nlp_scaling_; }
+
   /* methods for transforming the internal objects to corresponding user objects */
   inline double user_obj(double hiop_f) { return nlp_transformations.applyToObj(hiop_f); }
   inline void   user_x(hiopVector& hiop_x, double* user_x) 
@@ -189,12 +229,17 @@ public:
     memcpy(user_x, user_xa, nlp_transformations.n_post_local()*sizeof(double));
   }
 
-  /* copies/unpacks duals of the bounds and of constraints from 'it' to the three arrays */
+  /* copies/unpacks duals of the bounds and of constraints from 'it' to the three arrays; the 
+   * duals are returned in the user's scale */
   void get_dual_solutions(const hiopIterate& it,
 			  double* zl_a,
 			  double* zu_a,
 			  double* lambda_a);
   
+  /* returns the multipliers of the bounds 'z' in the user's scale; 'z_user' is used as buffer when
+   * these differ from the internal multipliers */
+  const double* user_bounds_duals(const hiopVector& z, hiopVector*& z_user);
+
   /* packs constraint rhs or constraint multipliers into one array based on the internal mappings 
    * 'cons_eq_mapping_'and 'cons_ineq_mapping_ */
   void copy_EqIneq_to_cons(const hiopVector& yc,
@@ -205,13 +250,26 @@ public:
   /* outputing and debug-related functionality*/
   hiopLogger* log;
   hiopRunStats runStats;
+  /* regions of the solver's phases; enabled by the option 'profile' */
+  hiopProfiler prof;
   hiopOptions* options;
+  /* threading parameters of the vectors and matrices allocated by the NLP (options 'num_threads'
+   * and 'omp_serial_threshold'); these objects and their clones point to them */
+  inline const hiopOmpParams* get_omp_params() const { return &omp_params_; }
+  inline void set_omp_params(int num_threads, long long serial_threshold)
+  {
+    omp_params_.set(num_threads, serial_threshold);
+  }
+  /* pool of workspaces of the dense linear solvers; persists across solves */
+  hiopDenseLinSolverWorkspacePool& get_dense_linsolver_ws_pool();
   //prints a summary of the problem
   virtual void print(FILE* f=NULL, const char* msg=NULL, int rank=-1) const;
 #ifdef HIOP_USE_MPI
   inline MPI_Comm get_comm() const { return comm; }
   inline int      get_rank() const { return rank; }
   inline int      get_num_ranks() const { return num_ranks; }
+#else
+  inline MPI_Comm get_comm() const { return MPI_COMM_SELF; }
 #endif
 protected:
 #ifdef HIOP_USE_MPI
@@ -240,10 +298,18 @@ protected:
   //options for which this class was setup
   std::string strFixedVars; //"none", "fixed", "relax"
   double dFixedVarsTol;
+  std::string strScaling; //"none", "gradient"
+  double dScalingMaxGrad;
 
-  //internal NLP transformations (currently fixing/relaxing variables implemented)
+  //internal NLP transformations (fixing/relaxing variables and scaling implemented)
   hiopNlpTransformations nlp_transformations;
 
+  //the scaling transformation, owned by 'nlp_transformations'; NULL when the problem is not scaled
+  //or the scaling was not yet computed (this is done at the starting point)
+  hiopNLPObjGradScaling* nlp_scaling_;
+
+  hiopOmpParams omp_params_;
+
 #ifdef HIOP_USE_MPI
   //inter-process distribution of vectors
   long long* vec_distrib;
@@ -260,6 +326,15 @@ protected:
    *  1 : at once
    */
   int cons_eval_type_;
+
+  /**
+   * Flag to indicate whether the derivatives are evaluated in one call via the user's 
+   * 'eval_derivs'. Possible values
+   * -1 : not initialized/not decided
+   *  0 : separately
+   *  1 : at once
+   */
+  int derivs_eval_type_;
   
   /** 
    * Internal buffer for constraints. Used only when constraints and Jacobian are evaluated at 
@@ -278,8 +353,16 @@ protected:
    * ineq. into and to return it to the user via @user_callback_solution and @user_callback_iterate
    */
   double* cons_lambdas_;
+
+  /// Internal buffers for the multipliers of the bounds returned to the user when the problem is scaled
+  hiopVector *zl_user_, *zu_user_;
+
+  /// Lazily created pool of dense linear solver workspaces, see get_dense_linsolver_ws_pool
+  hiopDenseLinSolverWorkspacePool* dense_linsolver_ws_pool_;
 private:
   hiopNlpFormulation(const hiopNlpFormulation& s) : interface_base(s.interface_base) {};
+  /* computes the gradient-based scaling at 'x0' and appends it to 'nlp_transformations' */
+  bool setup_scaling(hiopVector& x0);
 };
 
 /* *************************************************************************
@@ -320,6 +403,9 @@ public:
   virtual hiopMatrixDense* alloc_Jac_c();
   virtual hiopMatrixDense* alloc_Jac_d();
   virtual hiopMatrixDense* alloc_Jac_cons();
+  /* the rows of Jac_d are stored right after the rows of Jac_c, so that the two Jacobians can be
+   * used as one stacked matrix without copying them (see hiopKKTLinSysLowRank) */
+  virtual void alloc_Jac_c_d(hiopMatrix*& Jac_c, hiopMatrix*& Jac_d);
   //returns hiopHessianLowRank which (fakely) inherits from hiopMatrix
   virtual hiopMatrix* alloc_Hess_Lagr();
 
@@ -329,6 +415,15 @@ public:
    */
   virtual hiopMatrixDense* alloc_multivector_primal(int nrows, int max_rows=-1) const;
 
+  /* Sets 'J' to the stacked Jacobian [Jac_c;Jac_d]. 'J' is a view of 'Jac_c' when the rows of
+   * 'Jac_d' are stored right after those of 'Jac_c' (which is the case for the Jacobians 
+   * allocated by 'alloc_Jac_c_d'); otherwise the rows are copied in a matrix allocated here.
+   * 'J' and 'J_is_view' are kept by the caller across calls, so that the view or the matrix 
+   * is reused, and 'J' is to be deleted by the caller.
+   */
+  void stack_Jac_c_d(const hiopMatrixDense& Jac_c, const hiopMatrixDense& Jac_d, 
+		     hiopMatrixDense*& J, bool& J_is_view) const;
+
 private:
   /* interface implemented and provided by the user */
   hiopInterfaceDenseConstraints& interface;
@@ -371,26 +466,47 @@ public:
 			      const double* lambda_ineq,
 			      bool new_lambdas,
 			      hiopMatrix& Hess_L);
+protected:
+  virtual bool eval_derivs_interface_impl(double* x, bool new_x,
+					  double* gradf,
+					  hiopMatrix& Jac_c, hiopMatrix& Jac_d,
+					  const double& obj_factor,
+					  const double* lambda_eq,
+					  const double* lambda_ineq,
+					  bool new_lambdas,
+					  hiopMatrix& Hess_L);
+public:
   
   virtual hiopMatrix* alloc_Jac_c() 
   {
     assert(n_vars == nx_sparse+nx_dense);
-    return new hiopMatrixMDS(n_cons_eq, nx_sparse, nx_dense, nnz_sparse_Jaceq);
+    hiopMatrix* Jac = new hiopMatrixMDS(n_cons_eq, nx_sparse, nx_dense, nnz_sparse_Jaceq, 
+					options->GetString("sparse_format"));
+    Jac->set_omp_params(get_omp_params());
+    return Jac;
   }
   virtual hiopMatrix* alloc_Jac_d() 
   {
     assert(n_vars == nx_sparse+nx_dense);
-    return new hiopMatrixMDS(n_cons_ineq, nx_sparse, nx_dense, nnz_sparse_Jacineq);
+    hiopMatrix* Jac = new hiopMatrixMDS(n_cons_ineq, nx_sparse, nx_dense, nnz_sparse_Jacineq, 
+					options->GetString("sparse_format"));
+    Jac->set_omp_params(get_omp_params());
+    return Jac;
   }
   virtual hiopMatrix* alloc_Jac_cons()
   {
     assert(n_vars == nx_sparse+nx_dense);
-    return new hiopMatrixMDS(n_cons, nx_sparse, nx_dense, nnz_sparse_Jaceq+nnz_sparse_Jacineq);
+    hiopMatrix* Jac = new hiopMatrixMDS(n_cons, nx_sparse, nx_dense, nnz_sparse_Jaceq+nnz_sparse_Jacineq, 
+					options->GetString("sparse_format"));
+    Jac->set_omp_params(get_omp_params());
+    return Jac;
   }
   virtual hiopMatrix* alloc_Hess_Lagr()
   {
     assert(0==nnz_sparse_Hess_Lagr_SD);
-    return new hiopMatrixSymBlockDiagMDS(nx_sparse, nx_dense, nnz_sparse_Hess_Lagr_SS);
+    hiopMatrix* Hess = new hiopMatrixSymBlockDiagMDS(nx_sparse, nx_dense, nnz_sparse_Hess_Lagr_SS);
+    Hess->set_omp_params(get_omp_params());
+    return Hess;
   }
   virtual long long nx_sp() const { return nx_sparse; }
   virtual long long nx_de() const { return nx_dense; }
@@ -48,8 +48,10 @@
 
 #include "hiopNlpTransforms.hpp"
 #include "hiopLinAlgFactory.hpp"
+#include "hiop_blasdefs.hpp"
 
 #include <cmath>
+#include <cstring>
 namespace hiop
 {
 
@@ -60,9 +62,9 @@ hiopFixedVarsRemover(const hiopVector& xl,
 		     const long long& numFixedVars,
 		     const long long& numFixedVars_local)
   : n_fixed_vars_local(numFixedVars_local), fixedVarTol(fixedVarTol_),
-    Jacc_fs(NULL), Jacd_fs(NULL),
+    Jacc_fs(NULL), Jacd_fs(NULL), Jaccons_fs(NULL),
     fs2rs_idx_map(xl.get_local_size()),
-    x_rs_ref(NULL), Jacc_rs_ref(NULL), Jacd_rs_ref(NULL)
+    x_rs_ref(NULL), Jacc_rs_ref(NULL), Jacd_rs_ref(NULL), Jaccons_rs_ref(NULL)
 {
   xl_fs = xl.new_copy();
   xu_fs = xu.new_copy();
@@ -81,6 +83,7 @@ hiopFixedVarsRemover::~hiopFixedVarsRemover()
   delete grad_fs;
   if(Jacc_fs) delete Jacc_fs;
   if(Jacd_fs) delete Jacd_fs;
+  if(Jaccons_fs) delete Jaccons_fs;
 };
 
 #ifdef HIOP_USE_MPI
@@ -151,6 +154,19 @@ bool hiopFixedVarsRemover::setupDecisionVectorPart()
   }
   assert(it_rs+n_fixed_vars_local==n_fs_local);
 
+  /* group the non-fixed variables in ranges of consecutive indexes; the ranges are computed once
+   * here and used by all the fs<->rs copies, so that the gather of a Jacobian row costs one 
+   * memcpy per range instead of a lookup in 'fs2rs_idx_map' per column */
+  free_ranges.clear();
+  for(int i=0; i<n_fs_local; i++) {
+    if(fs2rs_idx_map[i]<0) continue;
+    if(!free_ranges.empty() && free_ranges.back().fs_start+free_ranges.back().len==i) {
+      free_ranges.back().len++;
+    } else {
+      FreeRange r = {i, fs2rs_idx_map[i], 1};
+      free_ranges.push_back(r);
+    }
+  }
   return true;
 };
 
@@ -159,20 +175,26 @@ bool hiopFixedVarsRemover::setupConstraintsPart(const int& neq, const int& nineq
   assert(Jacc_fs==NULL && "should not be allocated at this point");
   assert(Jacd_fs==NULL && "should not be allocated at this point");
 
+  Jacc_fs = allocFSJacobian(neq);
+  Jacd_fs = allocFSJacobian(nineq);
+  //the user evaluates directly in the full-space gradient and Jacobian buffers (nothing is copied 
+  //in them from the rs objects), so start from zeros in case the user does not write all entries
+  grad_fs->setToZero();
+  return true;
+}
+
+/* allocates a zero full-space Jacobian with m rows; the one for the one-call Jacobian is allocated 
+ * on the first use since most of the user NLPs work with the equalities and inequalities separately */
+hiopMatrixDense* hiopFixedVarsRemover::allocFSJacobian(const int& m)
+{
+  hiopMatrixDense* J;
 #ifdef HIOP_USE_MPI
-  if(fs_vec_distrib.size())
-  {
-    Jacc_fs = LinearAlgebraFactory::createMatrixDense(neq,   n_fs, fs_vec_distrib.data(), comm);
-    Jacd_fs = LinearAlgebraFactory::createMatrixDense(nineq, n_fs, fs_vec_distrib.data(), comm);
-  } else {
-    Jacc_fs = LinearAlgebraFactory::createMatrixDense(neq,   n_fs, NULL, comm);
-    Jacd_fs = LinearAlgebraFactory::createMatrixDense(nineq, n_fs, NULL, comm);
-  }
+  J = LinearAlgebraFactory::createMatrixDense(m, n_fs, fs_vec_distrib.size() ? fs_vec_distrib.data() : NULL, comm);
 #else
-  Jacc_fs = LinearAlgebraFactory::createMatrixDense(neq,   n_fs);
-  Jacd_fs = LinearAlgebraFactory::createMatrixDense(nineq, n_fs);
+  J = LinearAlgebraFactory::createMatrixDense(m, n_fs);
 #endif
-  return true;
+  J->setToZero();
+  return J;
 }
 
 /* "copies" a full space vector/array to a reduced space vector/array */
@@ -198,57 +220,51 @@ copyFsToRs(const hiopInterfaceBase::NonlinearityType* fs, hiopInterfaceBase::Non
 /* from rs to fs */
 void hiopFixedVarsRemover::applyToArray(const double* vec_rs, double* vec_fs)
 {
-  double* xl_fs_arr = xl_fs->local_data();
-  int rs_idx;
-  for(int i=0; i<fs2rs_idx_map.size(); i++) {
-    rs_idx = fs2rs_idx_map[i];
-    if(rs_idx<0) {
-      vec_fs[i] = xl_fs_arr[i];
-    } else {
-      vec_fs[i] = vec_rs[rs_idx];
-    }
+  const double* xl_fs_arr = xl_fs->local_data_const();
+  //the gaps between the ranges are the fixed variables
+  int fs_next = 0;
+  for(const FreeRange& r : free_ranges) {
+    if(r.fs_start>fs_next)
+      memcpy(vec_fs+fs_next, xl_fs_arr+fs_next, (r.fs_start-fs_next)*sizeof(double));
+    memcpy(vec_fs+r.fs_start, vec_rs+r.rs_start, r.len*sizeof(double));
+    fs_next = r.fs_start+r.len;
   }
+  const int n_fs_local = fs2rs_idx_map.size();
+  if(n_fs_local>fs_next)
+    memcpy(vec_fs+fs_next, xl_fs_arr+fs_next, (n_fs_local-fs_next)*sizeof(double));
 }
 
 /* from fs to rs */
 void hiopFixedVarsRemover::applyInvToArray(const double* x_fs, double* x_rs)
 {
-  int rs_idx;
-  for(int i=0; i<fs2rs_idx_map.size(); i++)  {
-    rs_idx = fs2rs_idx_map[i];
-    if(rs_idx>=0) {
-      x_rs[rs_idx]=x_fs[i];
-    }
-  }
+  for(const FreeRange& r : free_ranges)
+    memcpy(x_rs+r.rs_start, x_fs+r.fs_start, r.len*sizeof(double));
 }
 
-/* from rs to fs */
+/* from rs to fs; the entries of the fixed columns are not needed and are zeroed, so that each
+ * entry of a row is written once: one memcpy per range and one memset per gap between ranges */
 void hiopFixedVarsRemover::applyToMatrix(const double*const* M_rs, const int& m_in, double** M_fs)
 {
-  int rs_idx;
+  const int n_fs_local = fs2rs_idx_map.size();
   for(int i=0; i<m_in; i++) {
-    for(int j=0; j<fs2rs_idx_map.size(); j++) {
-      rs_idx = fs2rs_idx_map[j];
-      if(rs_idx<0) {
-  	M_fs[i][j] = 0.; //really no need to initialize this, these entries will be later ignored
-      } else {
-  	M_fs[i][j] = M_rs[i][rs_idx];
-      }
+    int fs_next = 0;
+    for(const FreeRange& r : free_ranges) {
+      if(r.fs_start>fs_next)
+	memset(M_fs[i]+fs_next, 0, (r.fs_start-fs_next)*sizeof(double));
+      memcpy(M_fs[i]+r.fs_start, M_rs[i]+r.rs_start, r.len*sizeof(double));
+      fs_next = r.fs_start+r.len;
     }
+    if(n_fs_local>fs_next)
+      memset(M_fs[i]+fs_next, 0, (n_fs_local-fs_next)*sizeof(double));
   }
 }
 
-/* from fs to rs */
+/* from fs to rs; one memcpy per row and range of non-fixed columns */
 void hiopFixedVarsRemover::applyInvToMatrix(const double*const* M_fs, const int& m_in, double** M_rs)
 {
-  int rs_idx;
   for(int i=0; i<m_in; i++) {
-    for(int j=0; j<fs2rs_idx_map.size(); j++) {
-      rs_idx = fs2rs_idx_map[j];
-      if(rs_idx>=0) {
-  	M_rs[i][rs_idx] = M_fs[i][j];
-      }
-    }
+    for(const FreeRange& r : free_ranges)
+      memcpy(M_rs[i]+r.rs_start, M_fs[i]+r.fs_start, r.len*sizeof(double));
   }
 }
 
@@ -290,5 +306,143 @@ relax(const double& fixed_var_tol, const double& fixed_var_perturb, hiopVector&
   }
 }
 
+hiopNLPObjGradScaling::
+hiopNLPObjGradScaling(const double& max_grad,
+		      const hiopVector& gradf,
+		      hiopMatrix& Jac_c,
+		      hiopMatrix& Jac_d,
+		      const long long* cons_eq_mapping,
+		      const long long* cons_ineq_mapping,
+		      const long long& n_vars_,
+		      const int& n_vars_local_)
+  : n_vars(n_vars_), n_vars_local(n_vars_local_), n_scaled_cons(0)
+{
+  //smallest scaling factor; larger gradients are not scaled down to 'max_grad'
+  const double min_scale = 1e-8;
+  const int m_eq = Jac_c.m(), m_ineq = Jac_d.m();
+
+  const double gradf_nrm = gradf.infnorm();
+  obj_scale = gradf_nrm>max_grad ? fmax(min_scale, max_grad/gradf_nrm) : 1.;
+
+  c_scale = LinearAlgebraFactory::createVector(m_eq);
+  d_scale = LinearAlgebraFactory::createVector(m_ineq);
+  cons_scale = LinearAlgebraFactory::createVector(m_eq+m_ineq);
+
+  //the row norms of the Jacobians are computed in place and then turned into scaling factors
+  Jac_c.row_max_abs_value(*c_scale);
+  Jac_d.row_max_abs_value(*d_scale);
+
+  double *c_sc=c_scale->local_data(), *d_sc=d_scale->local_data(), *cons_sc=cons_scale->local_data();
+  for(int i=0; i<m_eq; i++) {
+    if(c_sc[i]>max_grad) {
+      c_sc[i] = fmax(min_scale, max_grad/c_sc[i]);
+      n_scaled_cons++;
+    } else {
+      c_sc[i] = 1.;
+    }
+    cons_sc[cons_eq_mapping[i]] = c_sc[i];
+  }
+  for(int i=0; i<m_ineq; i++) {
+    if(d_sc[i]>max_grad) {
+      d_sc[i] = fmax(min_scale, max_grad/d_sc[i]);
+      n_scaled_cons++;
+    } else {
+      d_sc[i] = 1.;
+    }
+    cons_sc[cons_ineq_mapping[i]] = d_sc[i];
+  }
+}
+
+hiopNLPObjGradScaling::~hiopNLPObjGradScaling()
+{
+  delete c_scale;
+  delete d_scale;
+  delete cons_scale;
+}
+
+double* hiopNLPObjGradScaling::applyInvToGradObj(double* grad_in)
+{
+  if(obj_scale!=1.) {
+    int one=1;
+    DSCAL(&n_vars_local, &obj_scale, grad_in, &one);
+  }
+  return grad_in;
+}
+
+/* y_user = s/s_f * y */
+double* hiopNLPObjGradScaling::applyToConsDuals(double* lambda_in, const int& m_in)
+{
+  assert(m_in == cons_scale->get_size());
+  const double* s = cons_scale->local_data_const();
+  for(int i=0; i<m_in; i++)
+    lambda_in[i] *= s[i]/obj_scale;
+  return lambda_in;
+}
+
+double* hiopNLPObjGradScaling::applyInvToConsDuals(double* lambda_in, const int& m_in)
+{
+  assert(m_in == cons_scale->get_size());
+  const double* s = cons_scale->local_data_const();
+  for(int i=0; i<m_in; i++)
+    lambda_in[i] *= obj_scale/s[i];
+  return lambda_in;
+}
+
+double* hiopNLPObjGradScaling::applyToBoundsDuals(double* z_in, const int& n_in)
+{
+  for(int i=0; i<n_in; i++)
+    z_in[i] /= obj_scale;
+  return z_in;
+}
+
+double* hiopNLPObjGradScaling::applyInvToBoundsDuals(double* z_in, const int& n_in)
+{
+  for(int i=0; i<n_in; i++)
+    z_in[i] *= obj_scale;
+  return z_in;
+}
+
+void hiopNLPObjGradScaling::applyInvToConsBounds(hiopVector& c_rhs, 
+						 hiopVector& dl, const hiopVector& idl,
+						 hiopVector& du, const hiopVector& idu)
+{
+  scaleArray(c_rhs.local_data(), *c_scale, false);
+
+  //infinite bounds (the ones with idl/idu zero) are left unchanged
+  const int m_ineq = d_scale->get_size();
+  const double *d_sc=d_scale->local_data_const(), *idla=idl.local_data_const(), *idua=idu.local_data_const();
+  double *dla=dl.local_data(), *dua=du.local_data();
+  for(int i=0; i<m_ineq; i++) {
+    if(idla[i]==1.) dla[i] *= d_sc[i];
+    if(idua[i]==1.) dua[i] *= d_sc[i];
+  }
+}
+
+double* hiopNLPObjGradScaling::scaleArray(double* arr, const hiopVector& scale, const bool inv_scale)
+{
+  const int m = scale.get_size();
+  const double* s = scale.local_data_const();
+  if(inv_scale) {
+    for(int i=0; i<m; i++) arr[i] /= s[i];
+  } else {
+    for(int i=0; i<m; i++) arr[i] *= s[i];
+  }
+  return arr;
+}
+
+/* the rows of the user's dense Jacobian have 'n_vars_local' entries */
+double** hiopNLPObjGradScaling::scaleRows(double** M, const hiopVector& scale)
+{
+  const int m = scale.get_size();
+  const double* s = scale.local_data_const();
+  int one=1;
+  for(int i=0; i<m; i++) {
+    if(s[i]!=1.) {
+      double si = s[i];
+      DSCAL(&n_vars_local, &si, M[i], &one);
+    }
+  }
+  return M;
+}
 
 } //end of namespace
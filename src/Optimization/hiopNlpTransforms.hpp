@@ -102,8 +102,8 @@ public:
   //the following two are for when the underlying NLP formulation works with full body constraints,
   //that is, evaluates both equalities and inequalities at once (a.k.a. one-call constraints and
   //and Jacobian evaluations)
-  virtual inline double* applyToCons(double* cons_in, const int* m_in) { return cons_in; }
-  virtual inline double* applyInvToCons(double* cons_in, const int* m_in) { return cons_in; }
+  virtual inline double* applyToCons(double* cons_in, const int& m_in) { return cons_in; }
+  virtual inline double* applyInvToCons(double* cons_in, const int& m_in) { return cons_in; }
 
   //! todo -> abstractize the below methods to work with other Jacobian types: sparse and MDS
   virtual inline double** applyToJacobEq      (double** Jac_in, const int& m_in) { return Jac_in; }
@@ -113,8 +113,23 @@ public:
   virtual inline double** applyToJacobCons    (double** Jac_in, const int& m_in) { return Jac_in; }
   //the following two are for when the underlying NLP formulation works with full body constraints
   virtual inline double** applyInvToJacobCons (double** Jac_in, const int& m_in) { return Jac_in; }
-
-  //! todo -> transformations for Hessian ?!?
+  //variants for Jacobians that are not dense (MDS); these work in place on the matrix evaluated 
+  //by the user
+  virtual inline void applyInvToJacobEq  (hiopMatrix& Jac_in, const int& m_in) { }
+  virtual inline void applyInvToJacobIneq(hiopMatrix& Jac_in, const int& m_in) { }
+  virtual inline void applyInvToJacobCons(hiopMatrix& Jac_in, const int& m_in) { }
+
+  //multipliers of the constraints (in the user's ordering, size m_in) and of the bounds
+  virtual inline double* applyToConsDuals   (double* lambda_in, const int& m_in) { return lambda_in; }
+  virtual inline double* applyInvToConsDuals(double* lambda_in, const int& m_in) { return lambda_in; }
+  virtual inline double* applyToBoundsDuals   (double* z_in, const int& n_in) { return z_in; }
+  virtual inline double* applyInvToBoundsDuals(double* z_in, const int& n_in) { return z_in; }
+
+  //objective factor and multipliers of the equalities and inequalities passed to user's Hessian 
+  //of the Lagrangian
+  virtual inline double applyToHessObjFactor(const double& obj_factor) { return obj_factor; }
+  virtual inline double* applyToHessConsEqMults  (double* lambda_in, const int& m_in) { return lambda_in; }
+  virtual inline double* applyToHessConsIneqMults(double* lambda_in, const int& m_in) { return lambda_in; }
 public:
   hiopNlpTransformation() {}; 
   virtual ~hiopNlpTransformation() {};
@@ -128,6 +143,10 @@ public:
  *
  * applyInvToXXX: takes XXX as seen by the user calling code and returns the corresponding
  * reduced-space XXX object.
+ *
+ * For the objects that the user only writes (gradient and Jacobians), applyToXXX just returns the 
+ * full-space buffer in which the user evaluates and applyInvToXXX gathers the non-fixed entries 
+ * from it, one memcpy per range of consecutive non-fixed variables.
  */
 class hiopFixedVarsRemover : public hiopNlpTransformation
 {
@@ -177,11 +196,11 @@ public:
     applyInvToArray(x_in, xv_out.local_data());
   }
   
-  /* from rs to fs and return the fs*/
+  /* returns the fs buffer in which the user evaluates the gradient; the rs gradient is not 
+   * copied into it since the user overwrites it */
   inline double* applyToGradObj(double* grad_in)
   {
     grad_rs_ref = grad_in;
-    applyToArray(grad_in, grad_fs->local_data());
     return grad_fs->local_data();
   }
   /* from fs to rs */
@@ -191,12 +210,12 @@ public:
     applyInvToArray(grad_in, grad_rs_ref);
     return grad_rs_ref;
   }
-  /* from rs to fs */
+  /* returns the fs buffer in which the user evaluates the Jacobian; as for the gradient, 
+   * there is no rs to fs copy */
   inline double** applyToJacobEq(double** Jac_in, const int& m_in)
   {
     Jacc_rs_ref = Jac_in;
     assert(Jacc_fs->m()==m_in);
-    applyToMatrix(Jac_in, m_in, Jacc_fs->get_M());
     return Jacc_fs->get_M();
   }
   inline double** applyInvToJacobEq(double** Jac_in, const int& m_in)
@@ -209,7 +228,6 @@ public:
   {
     Jacd_rs_ref = Jac_in;
     assert(Jacd_fs->m()==m_in);
-    applyToMatrix(Jac_in, m_in, Jacd_fs->get_M());
     return Jacd_fs->get_M();
   }
   inline double** applyInvToJacobIneq(double** Jac_in, const int& m_in)
@@ -218,6 +236,20 @@ public:
     applyInvToMatrix(Jac_in, m_in, Jacd_rs_ref);
     return Jacd_rs_ref;
   }
+  /* one-call Jacobian (equalities and inequalities at once) */
+  inline double** applyToJacobCons(double** Jac_in, const int& m_in)
+  {
+    Jaccons_rs_ref = Jac_in;
+    if(NULL==Jaccons_fs) Jaccons_fs = allocFSJacobian(m_in);
+    assert(Jaccons_fs->m()==m_in);
+    return Jaccons_fs->get_M();
+  }
+  inline double** applyInvToJacobCons(double** Jac_in, const int& m_in)
+  {
+    assert(Jaccons_fs->m()==m_in);
+    applyInvToMatrix(Jac_in, m_in, Jaccons_rs_ref);
+    return Jaccons_rs_ref;
+  }
 
   /** methods not inherited from parent class */
 
@@ -243,6 +275,8 @@ protected:
 
   void applyToMatrix   (const double*const* M_rs, const int& m_in, double** M_fs);
   void applyInvToMatrix(const double*const* M_fs, const int& m_in, double** M_rs);
+
+  hiopMatrixDense* allocFSJacobian(const int& m);
 protected:
   long long n_fixed_vars_local;
   long long n_fixed_vars;
@@ -255,17 +289,21 @@ protected:
   //working buffer used to hold the full-space (user's) vector of decision variables and other optimiz objects
   hiopVector*x_fs, *grad_fs;
   //working buffers for the full-space Jacobians
-  hiopMatrixDense *Jacc_fs, *Jacd_fs;
+  hiopMatrixDense *Jacc_fs, *Jacd_fs, *Jaccons_fs;
 
   //a copy of the lower and upper bounds provided by user
   hiopVector*xl_fs, *xu_fs;
   //indexes corresponding to fixed variables (local indexes)
   std::vector<int> fs2rs_idx_map;
+  //maximal ranges of consecutive non-fixed (local) variables, used to copy between the fs and rs
+  //layouts with one memcpy per range instead of one indexed access per entry
+  struct FreeRange { int fs_start, rs_start, len; };
+  std::vector<FreeRange> free_ranges;
 
   //references to reduced-space buffers - returned in applyInvXXX
   double* x_rs_ref;
   double* grad_rs_ref;
-  double **Jacc_rs_ref, **Jacd_rs_ref;
+  double **Jacc_rs_ref, **Jacd_rs_ref, **Jaccons_rs_ref;
 #ifdef HIOP_USE_MPI
   std::vector<long long> fs_vec_distrib;
   MPI_Comm comm;
@@ -298,6 +336,105 @@ private:
   long long  n_vars; int n_vars_local;
 };
 
+/** Gradient-based scaling of the objective and of the constraints (see option 'scaling_type').
+ *
+ * The objective is scaled by s_f = min(1, max_grad/||grad f(x0)||_inf) and each constraint by
+ * s_i = min(1, max_grad/||grad c_i(x0)||_inf), where x0 is the starting point. The variables are 
+ * not scaled. The scaled multipliers are y_i = s_f/s_i*y_user_i and z = s_f*z_user.
+ *
+ * applyToXXX: takes the internal (scaled) XXX and returns the user's (unscaled) XXX.
+ * applyInvToXXX: takes the user's XXX and returns the internal (scaled) XXX.
+ * The arrays are transformed in place.
+ */
+class hiopNLPObjGradScaling : public hiopNlpTransformation
+{
+public:
+  /* 'gradf', 'Jac_c', and 'Jac_d' are evaluated at the starting point; 'n_vars_local' is the 
+   * number of (local) columns of the dense Jacobians seen by the user */
+  hiopNLPObjGradScaling(const double& max_grad,
+			const hiopVector& gradf,
+			hiopMatrix& Jac_c,
+			hiopMatrix& Jac_d,
+			const long long* cons_eq_mapping,
+			const long long* cons_ineq_mapping,
+			const long long& n_vars,
+			const int& n_vars_local);
+  virtual ~hiopNLPObjGradScaling();
+
+  inline bool setup() { return true; }
+
+  /* the variables are not scaled */
+  inline long long n_post() { return n_vars; }
+  inline long long n_pre () { return n_vars; }
+  inline long long n_post_local() { return n_vars_local; }
+
+  inline double applyToObj   (double& f_in) { return f_in/obj_scale; }
+  inline double applyInvToObj(double& f_in) { return f_in*obj_scale; }
+
+  double* applyInvToGradObj(double* grad_in);
+
+  inline double* applyToConsEq      (double* c_in, const int& m_in) { return scaleArray(c_in, *c_scale, true);  }
+  inline double* applyInvToConsEq   (double* c_in, const int& m_in) { return scaleArray(c_in, *c_scale, false); }
+  inline double* applyToConsIneq    (double* d_in, const int& m_in) { return scaleArray(d_in, *d_scale, true);  }
+  inline double* applyInvToConsIneq (double* d_in, const int& m_in) { return scaleArray(d_in, *d_scale, false); }
+  inline double* applyToCons        (double* cons_in, const int& m_in) 
+  { 
+    return scaleArray(cons_in, *cons_scale, true);
+  }
+  inline double* applyInvToCons     (double* cons_in, const int& m_in) 
+  {
+    return scaleArray(cons_in, *cons_scale, false);
+  }
+
+  inline double** applyInvToJacobEq  (double** Jac_in, const int& m_in) { return scaleRows(Jac_in, *c_scale); }
+  inline double** applyInvToJacobIneq(double** Jac_in, const int& m_in) { return scaleRows(Jac_in, *d_scale); }
+  inline double** applyInvToJacobCons(double** Jac_in, const int& m_in) { return scaleRows(Jac_in, *cons_scale); }
+
+  inline void applyInvToJacobEq  (hiopMatrix& Jac_in, const int& m_in) { Jac_in.scale_row(*c_scale, false); }
+  inline void applyInvToJacobIneq(hiopMatrix& Jac_in, const int& m_in) { Jac_in.scale_row(*d_scale, false); }
+  inline void applyInvToJacobCons(hiopMatrix& Jac_in, const int& m_in) { Jac_in.scale_row(*cons_scale, false); }
+
+  double* applyToConsDuals   (double* lambda_in, const int& m_in);
+  double* applyInvToConsDuals(double* lambda_in, const int& m_in);
+  double* applyToBoundsDuals   (double* z_in, const int& n_in);
+  double* applyInvToBoundsDuals(double* z_in, const int& n_in);
+
+  inline double applyToHessObjFactor(const double& obj_factor) { return obj_factor*obj_scale; }
+  inline double* applyToHessConsEqMults(double* lambda_in, const int& m_in) 
+  { 
+    return scaleArray(lambda_in, *c_scale, false); 
+  }
+  inline double* applyToHessConsIneqMults(double* lambda_in, const int& m_in) 
+  { 
+    return scaleArray(lambda_in, *d_scale, false); 
+  }
+
+  /** methods not inherited from parent class */
+
+  /* scales the rhs of the equalities and the finite bounds of the inequalities */
+  void applyInvToConsBounds(hiopVector& c_rhs, 
+			    hiopVector& dl, const hiopVector& idl,
+			    hiopVector& du, const hiopVector& idu);
+
+  inline double get_obj_scale() const { return obj_scale; }
+  /* scaling factors of the equalities and of the inequalities in HiOp's ordering */
+  inline const hiopVector& get_c_scale() const { return *c_scale; }
+  inline const hiopVector& get_d_scale() const { return *d_scale; }
+  /* number of constraints whose scaling factor is less than one */
+  inline int get_num_scaled_cons() const { return n_scaled_cons; }
+private:
+  double* scaleArray(double* arr, const hiopVector& scale, const bool inv_scale);
+  double** scaleRows(double** M, const hiopVector& scale);
+private:
+  long long n_vars; 
+  int n_vars_local;
+  double obj_scale;
+  //scaling factors of the equalities, of the inequalities, and of all the constraints in the 
+  //user's ordering
+  hiopVector *c_scale, *d_scale, *cons_scale;
+  int n_scaled_cons;
+};
+
 
 class hiopNlpTransformations : public hiopNlpTransformation
 {
@@ -430,6 +567,159 @@ public:
     return ret;
   }
 
+  double** applyToJacobCons(double** Jac_in, const int& m_in)
+  {
+    double** ret = Jac_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it)
+      ret = (*it)->applyToJacobCons(ret, m_in);
+    return ret;
+  }
+
+  double** applyInvToJacobCons(double** Jac_in, const int& m_in)
+  {
+    double** ret = Jac_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it)
+      ret = (*it)->applyInvToJacobCons(ret, m_in);
+    return ret;
+  }
+
+  double applyToObj(double& f_in)
+  {
+    double ret = f_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it)
+      ret = (*it)->applyToObj(ret);
+    return ret;
+  }
+
+  double applyInvToObj(double& f_in)
+  {
+    double ret = f_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it)
+      ret = (*it)->applyInvToObj(ret);
+    return ret;
+  }
+
+  double* applyToConsEq(double* c_in, const int& m_in)
+  {
+    double* ret = c_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it)
+      ret = (*it)->applyToConsEq(ret, m_in);
+    return ret;
+  }
+
+  double* applyInvToConsEq(double* c_in, const int& m_in)
+  {
+    double* ret = c_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it)
+      ret = (*it)->applyInvToConsEq(ret, m_in);
+    return ret;
+  }
+
+  double* applyToConsIneq(double* d_in, const int& m_in)
+  {
+    double* ret = d_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it)
+      ret = (*it)->applyToConsIneq(ret, m_in);
+    return ret;
+  }
+
+  double* applyInvToConsIneq(double* d_in, const int& m_in)
+  {
+    double* ret = d_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it)
+      ret = (*it)->applyInvToConsIneq(ret, m_in);
+    return ret;
+  }
+
+  double* applyToCons(double* cons_in, const int& m_in)
+  {
+    double* ret = cons_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it)
+      ret = (*it)->applyToCons(ret, m_in);
+    return ret;
+  }
+
+  double* applyInvToCons(double* cons_in, const int& m_in)
+  {
+    double* ret = cons_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it)
+      ret = (*it)->applyInvToCons(ret, m_in);
+    return ret;
+  }
+
+  void applyInvToJacobEq(hiopMatrix& Jac_in, const int& m_in)
+  {
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it)
+      (*it)->applyInvToJacobEq(Jac_in, m_in);
+  }
+
+  void applyInvToJacobIneq(hiopMatrix& Jac_in, const int& m_in)
+  {
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it)
+      (*it)->applyInvToJacobIneq(Jac_in, m_in);
+  }
+
+  void applyInvToJacobCons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it)
+      (*it)->applyInvToJacobCons(Jac_in, m_in);
+  }
+
+  double* applyToConsDuals(double* lambda_in, const int& m_in)
+  {
+    double* ret = lambda_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it)
+      ret = (*it)->applyToConsDuals(ret, m_in);
+    return ret;
+  }
+
+  double* applyInvToConsDuals(double* lambda_in, const int& m_in)
+  {
+    double* ret = lambda_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it)
+      ret = (*it)->applyInvToConsDuals(ret, m_in);
+    return ret;
+  }
+
+  double* applyToBoundsDuals(double* z_in, const int& n_in)
+  {
+    double* ret = z_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it)
+      ret = (*it)->applyToBoundsDuals(ret, n_in);
+    return ret;
+  }
+
+  double* applyInvToBoundsDuals(double* z_in, const int& n_in)
+  {
+    double* ret = z_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it)
+      ret = (*it)->applyInvToBoundsDuals(ret, n_in);
+    return ret;
+  }
+
+  double applyToHessObjFactor(const double& obj_factor)
+  {
+    double ret = obj_factor;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it)
+      ret = (*it)->applyToHessObjFactor(ret);
+    return ret;
+  }
+
+  double* applyToHessConsEqMults(double* lambda_in, const int& m_in)
+  {
+    double* ret = lambda_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it)
+      ret = (*it)->applyToHessConsEqMults(ret, m_in);
+    return ret;
+  }
+
+  double* applyToHessConsIneqMults(double* lambda_in, const int& m_in)
+  {
+    double* ret = lambda_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it)
+      ret = (*it)->applyToHessConsIneqMults(ret, m_in);
+    return ret;
+  }
 
 private:
   std::list<hiopNlpTransformation*> list_trans_;
@@ -77,6 +77,9 @@ hiopResidual::hiopResidual(hiopNlpFormulation* nlp_)
 
   nrmInf_nlp_optim = nrmInf_nlp_feasib = nrmInf_nlp_complem = 1e6;
   nrmInf_bar_optim = nrmInf_bar_feasib = nrmInf_bar_complem = 1e6;
+  nrmInf_nlp_optim_unscaled = nrmInf_nlp_feasib_unscaled = nrmInf_nlp_complem_unscaled = 1e6;
+  nrmOne_duals_eq = nrmOne_duals_bnd = 0.;
+  duals_iter_ = NULL;
 }
 
 hiopResidual::~hiopResidual()
@@ -95,6 +98,18 @@ hiopResidual::~hiopResidual()
   if(rsvu) delete rsvu;
 }
 
+//local inf norm of v.*s or, when 'inv_scale' is true, of v./s
+static double infnormScaledLocal(const hiopVector& v, const hiopVector& s, bool inv_scale)
+{
+  const double *va=v.local_data_const(), *sa=s.local_data_const();
+  const long long n=v.get_local_size();
+  assert(n==s.get_local_size());
+  double nrm=0.;
+  for(long long i=0; i<n; i++)
+    nrm = fmax(nrm, fabs(inv_scale ? va[i]/sa[i] : va[i]*sa[i]));
+  return nrm;
+}
+
 double hiopResidual::computeNlpInfeasInfNorm(const hiopIterate& it, 
 			       const hiopVector& c, 
 			       const hiopVector& d)
@@ -141,17 +156,65 @@ double hiopResidual::computeNlpInfeasInfNorm(const hiopIterate& it,
     nrmInf_infeasib = fmax(nrmInf_infeasib, rdu->infnorm_local());
   }
 
-#ifdef HIOP_USE_MPI
-  //here we reduce each of the norm together for a total cost of 1 Allreduce of 3 doubles
-  //otherwise, if calling infnorm() for each vector, there will be 12 Allreduce's, each of 1 double
-  double aux;
-  int ierr = MPI_Allreduce(&nrmInf_infeasib, &aux, 1, MPI_DOUBLE, MPI_MAX, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
-  nrmInf_infeasib = aux;
-#endif
+  //here we reduce each of the norm together for a total cost of 1 Allreduce of 1 double
+  //otherwise, if calling infnorm() for each vector, there will be 6 Allreduce's, each of 1 double
+  hiopReductionPlan plan(nlp->get_comm());
+  const int idx = plan.add_max(nrmInf_infeasib);
+  plan.resolve();
+  nrmInf_infeasib = plan.get(idx);
   nlp->runStats.tmSolverInternal.stop();
   return nrmInf_infeasib;
 }
 
+void hiopResidual::copyFrom(const hiopResidual& other)
+{
+  rx->copyFrom(*other.rx);
+  rd->copyFrom(*other.rd);
+  rxl->copyFrom(*other.rxl);
+  rxu->copyFrom(*other.rxu);
+  rdl->copyFrom(*other.rdl);
+  rdu->copyFrom(*other.rdu);
+  ryc->copyFrom(*other.ryc);
+  ryd->copyFrom(*other.ryd);
+  rszl->copyFrom(*other.rszl);
+  rszu->copyFrom(*other.rszu);
+  rsvl->copyFrom(*other.rsvl);
+  rsvu->copyFrom(*other.rsvu);
+
+  nrmInf_nlp_optim = other.nrmInf_nlp_optim;
+  nrmInf_nlp_feasib = other.nrmInf_nlp_feasib;
+  nrmInf_nlp_complem = other.nrmInf_nlp_complem;
+  nrmInf_bar_optim = other.nrmInf_bar_optim;
+  nrmInf_bar_feasib = other.nrmInf_bar_feasib;
+  nrmInf_bar_complem = other.nrmInf_bar_complem;
+  nrmInf_nlp_optim_unscaled = other.nrmInf_nlp_optim_unscaled;
+  nrmInf_nlp_feasib_unscaled = other.nrmInf_nlp_feasib_unscaled;
+  nrmInf_nlp_complem_unscaled = other.nrmInf_nlp_complem_unscaled;
+  nrmOne_duals_eq = other.nrmOne_duals_eq;
+  nrmOne_duals_bnd = other.nrmOne_duals_bnd;
+  duals_iter_ = other.duals_iter_;
+}
+
+void hiopResidual::getDualsNormOne(const hiopIterate& it, double& nrm1Eq, double& nrm1Bnd) const
+{
+  if(&it == duals_iter_) {
+    nrm1Eq = nrmOne_duals_eq; 
+    nrm1Bnd = nrmOne_duals_bnd;
+  } else {
+    it.normOneOfDuals(nrm1Eq, nrm1Bnd);
+  }
+}
+
+void hiopResidual::updateSecondOrderCorrection(const double& alpha, const hiopResidual& resid_trial)
+{
+  //ryc = alpha*ryc + ryc_trial
+  ryc->scale(alpha);
+  ryc->axpy(1.0, *resid_trial.ryc);
+  //ryd = alpha*ryd + ryd_trial
+  ryd->scale(alpha);
+  ryd->axpy(1.0, *resid_trial.ryd);
+}
+
 int hiopResidual::update(const hiopIterate& it, 
 			 const double& f, const hiopVector& c, const hiopVector& d,
 			 const hiopVector& grad, const hiopMatrix& jac_c, const hiopMatrix& jac_d, 
@@ -161,6 +224,12 @@ int hiopResidual::update(const hiopIterate& it,
 
   nrmInf_nlp_optim = nrmInf_nlp_feasib = nrmInf_nlp_complem = 0;
   nrmInf_bar_optim = nrmInf_bar_feasib = nrmInf_bar_complem = 0;
+  //the errors of the user's problem are also computed when the problem is scaled: the duals of the
+  //scaled problem are y*s_f/s and the residuals of its constraints are r/s, s being the scaling
+  //factor of the constraint (see hiopNLPObjGradScaling)
+  const hiopNLPObjGradScaling* scaling = nlp->get_nlp_scaling();
+  const double obj_scale = scaling ? scaling->get_obj_scale() : 1.;
+  nrmInf_nlp_optim_unscaled = nrmInf_nlp_feasib_unscaled = 0.;
 
   long long nx_loc=rx->get_local_size();
   const double&  mu=logprob.mu;
@@ -180,6 +249,7 @@ int hiopResidual::update(const hiopIterate& it,
   buf = rx->infnorm_local();
   nrmInf_nlp_optim = fmax(nrmInf_nlp_optim, buf);
   nlp->log->printf(hovScalars,"NLP resid [update]: inf norm rx=%22.17e\n", buf);
+  nrmInf_nlp_optim_unscaled = buf/obj_scale;
   logprob.addNonLogBarTermsToGrad_x(1.0, *rx);
   rx->negate();
   nrmInf_bar_optim = fmax(nrmInf_bar_optim, rx->infnorm_local());
@@ -191,6 +261,10 @@ int hiopResidual::update(const hiopIterate& it,
   buf = rd->infnorm_local();
   nrmInf_nlp_optim = fmax(nrmInf_nlp_optim, buf);
   nlp->log->printf(hovScalars,"NLP resid [update]: inf norm rd=%22.17e\n", buf);
+  if(scaling) {
+    buf = infnormScaledLocal(*rd, scaling->get_d_scale(), false)/obj_scale;
+    nrmInf_nlp_optim_unscaled = fmax(nrmInf_nlp_optim_unscaled, buf);
+  }
   logprob.addNonLogBarTermsToGrad_d(-1.0,*rd);
   nrmInf_bar_optim = fmax(nrmInf_bar_optim, rd->infnorm_local());
   //ryc
@@ -199,6 +273,10 @@ int hiopResidual::update(const hiopIterate& it,
   buf = ryc->infnorm_local();
   nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, buf);
   nlp->log->printf(hovScalars,"NLP resid [update]: inf norm ryc=%22.17e\n", buf);
+  if(scaling) {
+    buf = infnormScaledLocal(*ryc, scaling->get_c_scale(), true);
+  }
+  nrmInf_nlp_feasib_unscaled = fmax(nrmInf_nlp_feasib_unscaled, buf);
 
   //ryd
   ryd->copyFrom(*it.d);
@@ -206,6 +284,10 @@ int hiopResidual::update(const hiopIterate& it,
   buf = ryd->infnorm_local();
   nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, buf);
   nlp->log->printf(hovScalars,"NLP resid [update]: inf norm ryd=%22.17e\n", buf);
+  if(scaling) {
+    buf = infnormScaledLocal(*ryd, scaling->get_d_scale(), true);
+  }
+  nrmInf_nlp_feasib_unscaled = fmax(nrmInf_nlp_feasib_unscaled, buf);
   
   //rxl=x-sxl-xl
   if(nlp->n_low_local()>0) {
@@ -218,6 +300,7 @@ int hiopResidual::update(const hiopIterate& it,
     buf = rxl->infnorm_local();
     nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, buf);
     nlp->log->printf(hovScalars,"NLP resid [update]: inf norm rxl=%22.17e\n", buf);
+    nrmInf_nlp_feasib_unscaled = fmax(nrmInf_nlp_feasib_unscaled, buf);
   }
   //printf("  %10.4e (xl)", nrmInf_nlp_feasib);
   //rxu=-x-sxu+xu
@@ -230,6 +313,7 @@ int hiopResidual::update(const hiopIterate& it,
     buf = rxu->infnorm_local();
     nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, buf);
     nlp->log->printf(hovScalars,"NLP resid [update]: inf norm rxu=%22.17e\n", buf);
+    nrmInf_nlp_feasib_unscaled = fmax(nrmInf_nlp_feasib_unscaled, buf);
   }  
   //printf("  %10.4e (xu)", nrmInf_nlp_feasib);
   //rdl=d-sdl-dl
@@ -239,6 +323,10 @@ int hiopResidual::update(const hiopIterate& it,
     buf = rdl->infnorm_local();
     nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, buf);
     nlp->log->printf(hovScalars,"NLP resid [update]: inf norm rdl=%22.17e\n", buf);
+    if(scaling) {
+      buf = infnormScaledLocal(*rdl, scaling->get_d_scale(), true);
+    }
+    nrmInf_nlp_feasib_unscaled = fmax(nrmInf_nlp_feasib_unscaled, buf);
   }
   //printf("  %10.4e (dl)", nrmInf_nlp_feasib);
   //rdu=-d-sdu+du
@@ -249,7 +337,11 @@ int hiopResidual::update(const hiopIterate& it,
     rdu->selectPattern(nlp->get_idu());
     buf = rdu->infnorm_local();
     nrmInf_nlp_feasib = fmax(nrmInf_nlp_feasib, buf);
-    nlp->log->printf(hovScalars,"NLP resid [update]: inf norm rdl=%22.17e\n", buf);
+    nlp->log->printf(hovScalars,"NLP resid [update]: inf norm rdu=%22.17e\n", buf);
+    if(scaling) {
+      buf = infnormScaledLocal(*rdu, scaling->get_d_scale(), true);
+    }
+    nrmInf_nlp_feasib_unscaled = fmax(nrmInf_nlp_feasib_unscaled, buf);
   }
   //printf("  %10.4e (du)\n", nrmInf_nlp_feasib);
   //set the feasibility error for the log barrier problem
@@ -313,14 +405,37 @@ int hiopResidual::update(const hiopIterate& it,
     nlp->log->printf(hovScalars,"NLP resid [update]: inf norm rsvu=%22.17e\n", buf);
   }
 
-#ifdef HIOP_USE_MPI
-  //here we reduce each of the norm together for a total cost of 1 Allreduce of 3 doubles
-  //otherwise, if calling infnorm() for each vector, there will be 12 Allreduce's, each of 1 double
-  double aux[6]={nrmInf_nlp_optim,nrmInf_nlp_feasib,nrmInf_nlp_complem,nrmInf_bar_optim,nrmInf_bar_feasib,nrmInf_bar_complem}, aux_g[6];
-  int ierr = MPI_Allreduce(aux, aux_g, 6, MPI_DOUBLE, MPI_MAX, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
-  nrmInf_nlp_optim=aux_g[0]; nrmInf_nlp_feasib=aux_g[1]; nrmInf_nlp_complem=aux_g[2];
-  nrmInf_bar_optim=aux_g[3]; nrmInf_bar_feasib=aux_g[4]; nrmInf_bar_complem=aux_g[5];
-#endif
+  //here we reduce each of the norms together, as well as the one-norms of the duals (needed 
+  //by the scaling of the errors), for a total cost of 1 Allreduce of 8 doubles; otherwise, if 
+  //calling infnorm() for each vector, there will be 12+ Allreduce's, each of 1 double
+  hiopReductionPlan plan(nlp->get_comm());
+  int idx[6];
+  idx[0] = plan.add_max(nrmInf_nlp_optim);
+  idx[1] = plan.add_max(nrmInf_nlp_feasib);
+  idx[2] = plan.add_max(nrmInf_nlp_complem);
+  idx[3] = plan.add_max(nrmInf_bar_optim);
+  idx[4] = plan.add_max(nrmInf_bar_feasib);
+  idx[5] = plan.add_max(nrmInf_bar_complem);
+  int idx_unscaled[2] = {-1, -1};
+  if(scaling) {
+    idx_unscaled[0] = plan.add_max(nrmInf_nlp_optim_unscaled);
+    idx_unscaled[1] = plan.add_max(nrmInf_nlp_feasib_unscaled);
+  }
+  int idx_nrm1_eq, idx_nrm1_bnd;
+  it.normOneOfDuals(plan, idx_nrm1_eq, idx_nrm1_bnd);
+  plan.resolve();
+
+  nrmInf_nlp_optim=plan.get(idx[0]); nrmInf_nlp_feasib=plan.get(idx[1]); nrmInf_nlp_complem=plan.get(idx[2]);
+  nrmInf_bar_optim=plan.get(idx[3]); nrmInf_bar_feasib=plan.get(idx[4]); nrmInf_bar_complem=plan.get(idx[5]);
+  nrmOne_duals_eq=plan.get(idx_nrm1_eq); nrmOne_duals_bnd=plan.get(idx_nrm1_bnd);
+  if(scaling) {
+    nrmInf_nlp_optim_unscaled=plan.get(idx_unscaled[0]); nrmInf_nlp_feasib_unscaled=plan.get(idx_unscaled[1]);
+  } else {
+    nrmInf_nlp_optim_unscaled=nrmInf_nlp_optim; nrmInf_nlp_feasib_unscaled=nrmInf_nlp_feasib;
+  }
+  //the products of the slacks and of the bounds duals are scaled by s_f
+  nrmInf_nlp_complem_unscaled = nrmInf_nlp_complem/obj_scale;
+  duals_iter_ = &it;
   nlp->runStats.tmSolverInternal.stop();
   return true;
 }
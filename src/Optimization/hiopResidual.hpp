@@ -72,8 +72,15 @@ public:
   /* Return the Nlp and Log-bar errors computed at the previous update call. */ 
   inline void getNlpErrors(double& optim, double& feas, double& comple) const
   { optim=nrmInf_nlp_optim; feas=nrmInf_nlp_feasib; comple=nrmInf_nlp_complem;};
+  /* Return the Nlp errors computed at the previous update call in the scale of the user's problem;
+   * these differ from the ones returned by 'getNlpErrors' only when the problem is scaled. */
+  inline void getUnscaledNlpErrors(double& optim, double& feas, double& comple) const
+  { optim=nrmInf_nlp_optim_unscaled; feas=nrmInf_nlp_feasib_unscaled; comple=nrmInf_nlp_complem_unscaled;};
   inline void getBarrierErrors(double& optim, double& feas, double& comple) const
   { optim=nrmInf_bar_optim; feas=nrmInf_bar_feasib; comple=nrmInf_bar_complem;};
+  /* Return the one-norms of the duals of 'it'. These are computed by 'update' to share its 
+   * global reduction and are recomputed here when 'update' was last called with another iterate. */
+  void getDualsNormOne(const hiopIterate& it, double& nrm1Eq, double& nrm1Bnd) const;
   /* get the previously computed Infeasibility */
   inline double getInfeasInfNorm() const { 
     return nrmInf_nlp_feasib;
@@ -86,6 +93,14 @@ public:
 				 const hiopVector& c_eval, 
 				 const hiopVector& d_eval);
 
+  /* copies the residual vectors and the cached norms of 'other' */
+  void copyFrom(const hiopResidual& other);
+
+  /* right-hand side of a second-order correction: ryc and ryd are set to alpha*ryc+ryc_trial and
+   * alpha*ryd+ryd_trial, where ryc_trial and ryd_trial are the residuals at the trial point as
+   * computed by 'computeNlpInfeasInfNorm' on 'resid_trial'; the other residuals are not changed */
+  void updateSecondOrderCorrection(const double& alpha, const hiopResidual& resid_trial);
+
   /* residual printing function - calls hiopVector::print 
    * prints up to max_elems (by default all), on rank 'rank' (by default on all) */
   virtual void print(FILE*, const char* msg=NULL, int max_elems=-1, int rank=-1) const;
@@ -105,10 +120,16 @@ private:
    *  for the nlp (\mu=0)
    */
   double nrmInf_nlp_optim, nrmInf_nlp_feasib, nrmInf_nlp_complem; 
+  /** the norms above in the scale of the user's problem (see hiopNLPObjGradScaling) */
+  double nrmInf_nlp_optim_unscaled, nrmInf_nlp_feasib_unscaled, nrmInf_nlp_complem_unscaled;
   /** storage for the norm of [rx,rd], [rxl,...,rdu,ryc,ryd], and [rszl,...,rsvu]  
    *  for the barrier subproblem
    */
   double nrmInf_bar_optim, nrmInf_bar_feasib, nrmInf_bar_complem; 
+  /** one-norms of the duals of the equalities and bounds (see hiopIterate::normOneOfDuals) */
+  double nrmOne_duals_eq, nrmOne_duals_bnd;
+  /** the iterate passed to the last 'update', to which the one-norms above correspond */
+  const hiopIterate* duals_iter_;
   // and associated info from problem formulation
   hiopNlpFormulation * nlp;
 private:
@@ -119,6 +140,7 @@ private:
   friend class hiopKKTLinSysCompressedXDYcYd;
   friend class hiopKKTLinSysLowRank;
   friend class hiopKKTLinSys;
+  friend class hiopKKTLinSysCompressed;
 };
 
 }
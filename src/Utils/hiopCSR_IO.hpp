@@ -2,58 +2,86 @@
 #define HIOP_CSR_IO
 
 #include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <cassert>
 #ifdef HIOP_USE_MPI
 #include <mpi.h>
 #endif
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace hiop
 {
+  /* Layout of the binary KKT dumps (.bkkt files), see also src/LinAlg/csr_iajaaa.md. All the
+   * arrays start at offsets that are multiples of 8 bytes so that they can be used in place
+   * from a memory mapping of the file.
+   *   header (64 bytes): magic "HIOPKKTB", int32 version, int32 n, int64 nnz, 40 reserved bytes
+   *   int64  row_start[n+1]  - offsets (0-based) of the rows in col and val
+   *   int32  col[nnz]        - 0-based column indexes, padded with zeros to a multiple of 8 bytes
+   *   double val[nnz]        - the upper triangle of the symmetric matrix
+   *   double vec[n] ...      - rhs, sol, rhs, sol, ... appended until the end of the file
+   */
+  struct hiopCSR_BinaryHeader
+  {
+    char magic[8];
+    int32_t version;
+    int32_t n;
+    int64_t nnz;
+    int64_t reserved[5];
+  };
+  static const char hiopCSR_BinaryMagic[8] = {'H','I','O','P','K','K','T','B'};
+
   //saves a dense or other matrices in the CSR format. Expects the following order of calls
-  // 1. writeMatToFile -> will create/overwrite kkt_linsys_counter.iajaaa file and will write 
-  // the matrix  passed as argument
+  // 1. writeMatToFile -> will create/overwrite kkt_linsys_counter.bkkt (or .iajaaa) file and
+  // will write the matrix  passed as argument
   // 2. writeRhsToFile -> will append the rhs
   // 3. writeSolToFile -> will append the sol
+  //The format is selected by the option 'write_kkt_format' and only the systems with the
+  //counter a multiple of the option 'write_kkt_every' are saved
   class hiopCSR_IO {
   public:
     // masterrank=-1 means all ranks save
     hiopCSR_IO(hiopNlpFormulation* nlp, int masterrank=0)
-      : _nlp(nlp), _master_rank(masterrank), _f(NULL), m(-1), last_counter(-1)
+      : _nlp(nlp), _master_rank(masterrank), _f(NULL), m(-1), last_counter(-1),
+	binary_(true), skip_(false)
     {
     }
 
-    virtual ~hiopCSR_IO() 
+    virtual ~hiopCSR_IO()
     {
     }
 
     void writeRhsToFile(const hiopVector& rhs, const int& counter)
     {
-#ifdef HIOP_USE_MPI
-      if(_master_rank>=0 && _master_rank != _nlp->get_rank()) return;
-#endif
-      assert(counter == last_counter);
-      assert(m == rhs.get_size());
-
-      std::string fname = "kkt_linsys_"; 
-      fname += std::to_string(counter); 
-      fname += ".iajaaa";
-      FILE* f = fopen(fname.c_str(), "a+");
-      if(NULL==f) {
-	_nlp->log->printf(hovError, "Could not open '%s' for writing the rhs/sol.\n", fname.c_str());
-	return;
-      }
-
       const double* v = rhs.local_data_const();
-      for(int i=0; i<m; i++)
-	fprintf(f, "%.20f ", v[i]);
-      fprintf(f, "\n");
-      fclose(f);
+      writeArraysToFile(&v, 1, rhs.get_size(), counter);
     }
     inline void writeSolToFile(const hiopVector& sol, const int& counter)
-    { 
-      writeRhsToFile(sol, counter); 
+    {
+      writeRhsToFile(sol, counter);
+    }
+    //appends the rows of 'rhs' and 'sol' (the right-hand sides and the solutions of a multiple 
+    //right-hand side solve), in the order written by the single right-hand side solves
+    void writeRhsSolBlockToFile(const hiopMatrixDense& rhs, const hiopMatrixDense& sol, 
+				const int& counter)
+    {
+      assert(rhs.m() == sol.m() && rhs.n() == sol.n());
+      std::vector<const double*> v;
+      for(int k=0; k<rhs.m(); k++) {
+	v.push_back(rhs.local_data()[k]);
+	v.push_back(sol.local_data()[k]);
+      }
+      writeArraysToFile(v.data(), v.size(), rhs.n(), counter);
     }
 
-    //write a dense matrix in the iajaaa format; zero elements are not written
+    //write a dense matrix in the binary or the iajaaa format; zero elements are not written
     //counter specifies the suffix in the filename, essentially is the iteration #
     void writeMatToFile(hiopMatrixDense& Msys, const int& counter)
     {
@@ -63,60 +91,226 @@ namespace hiop
       last_counter = counter;
       m = Msys.m();
 
-      std::string fname = "kkt_linsys_"; 
-      fname += std::to_string(counter); 
-      fname += ".iajaaa";
-      FILE* f = fopen(fname.c_str(), "w+");
+      binary_ = _nlp->options->GetString("write_kkt_format") == "binary";
+      skip_ = (counter % _nlp->options->GetInteger("write_kkt_every")) != 0;
+      if(skip_) return;
+
+      std::string fname = filename(counter);
+      FILE* f = fopen(fname.c_str(), binary_ ? "wb" : "w+");
       if(NULL==f) {
 	_nlp->log->printf(hovError, "Could not open '%s' for writing the linsys.\n", fname.c_str());
 	return;
       }
-      
+      if(binary_) {
+	writeMatBinary(Msys, f);
+      } else {
+	writeMatIajaaa(Msys, f);
+      }
+      fclose(f);
+    }
+  private:
+    //appends the 'num' arrays of size 'len' (the size of the matrix) in 'v'
+    void writeArraysToFile(const double* const* v, int num, long long len, const int& counter)
+    {
+#ifdef HIOP_USE_MPI
+      if(_master_rank>=0 && _master_rank != _nlp->get_rank()) return;
+#endif
+      assert(counter == last_counter);
+      assert(m == len);
+      if(skip_) return;
+
+      std::string fname = filename(counter);
+      FILE* f = fopen(fname.c_str(), binary_ ? "ab" : "a+");
+      if(NULL==f) {
+	_nlp->log->printf(hovError, "Could not open '%s' for writing the rhs/sol.\n", fname.c_str());
+	return;
+      }
+
+      for(int k=0; k<num; k++) {
+	if(binary_) {
+	  fwrite(v[k], sizeof(double), m, f);
+	} else {
+	  for(int i=0; i<m; i++)
+	    fprintf(f, "%.20f ", v[k][i]);
+	  fprintf(f, "\n");
+	}
+      }
+      fclose(f);
+    }
+
+    inline std::string filename(const int& counter) const
+    {
+      std::string fname = "kkt_linsys_";
+      fname += std::to_string(counter);
+      fname += binary_ ? ".bkkt" : ".iajaaa";
+      return fname;
+    }
+
+    //one pass over the upper triangle to build the CSR arrays, then one fwrite per array
+    void writeMatBinary(hiopMatrixDense& Msys, FILE* f)
+    {
+      const double zero_tol = 1e-25;
+      double** M = Msys.local_data();
+      row_start_.resize(m+1);
+      col_.clear();
+      val_.clear();
+      row_start_[0] = 0;
+      for(int i=0; i<m; i++) {
+	const double* Mi = M[i];
+	for(int j=i; j<m; j++) {
+	  if(fabs(Mi[j])>zero_tol) {
+	    col_.push_back(j);
+	    val_.push_back(Mi[j]);
+	  }
+	}
+	row_start_[i+1] = col_.size();
+      }
+      const int64_t nnz = col_.size();
+
+      hiopCSR_BinaryHeader header;
+      memset(&header, 0, sizeof(header));
+      memcpy(header.magic, hiopCSR_BinaryMagic, sizeof(header.magic));
+      header.version = 1;
+      header.n = m;
+      header.nnz = nnz;
+      fwrite(&header, sizeof(header), 1, f);
+      fwrite(row_start_.data(), sizeof(int64_t), m+1, f);
+      if(nnz%2) col_.push_back(0); //padding
+      fwrite(col_.data(), sizeof(int32_t), col_.size(), f);
+      fwrite(val_.data(), sizeof(double), nnz, f);
+    }
+
+    void writeMatIajaaa(hiopMatrixDense& Msys, FILE* f)
+    {
       //count nnz
       const double zero_tol = 1e-25;
       int nnz=0;
       double** M = Msys.local_data();
       for(int i=0; i<m; i++) for(int j=i; j<m; j++) if(fabs(M[i][j])>zero_tol) nnz++;
-      
+
       //start writing -> indexes are starting at 1
       fprintf(f, "%d\n %d\n", m, nnz);
-      
+
       //array of pointers/offsets in of the first nonzero of each row; first entry is 1 and the last entry is nnz+1
       int offset = 1;
       fprintf(f, "%d ", offset);
       for(int i=0; i<m; i++) {
-	for(int j=i; j<m; j++) 
+	for(int j=i; j<m; j++)
 	  if(fabs(M[i][j])>zero_tol)
 	    offset++;
-	
+
 	fprintf(f, "%d ", offset);
       }
       assert(offset == nnz+1);
       fprintf(f, "\n");
-      
+
       //array of the column indexes of nonzeros
       for(int i=0; i<m; i++) {
-	for(int j=i; j<m; j++) 
+	for(int j=i; j<m; j++)
 	  if(fabs(M[i][j])>zero_tol)
 	    fprintf(f, "%d ", j);
     }
       fprintf(f, "\n");
-      
+
       //array of nonzero entries of the matrix
       for(int i=0; i<m; i++) {
-	for(int j=i; j<m; j++) 
+	for(int j=i; j<m; j++)
 	  if(fabs(M[i][j])>zero_tol)
 	    fprintf(f, "%.20f ", M[i][j]);
       }
       fprintf(f, "\n");
-      
-      fclose(f);
     }
   private:
     FILE* _f;
     hiopNlpFormulation* _nlp;
     int _master_rank;
     int m, last_counter; //used only for consistency (such as order of calls) checks
+    bool binary_; //format of the current system
+    bool skip_;   //current system is not saved (see option 'write_kkt_every')
+    //buffers for the CSR arrays of the binary format
+    std::vector<int64_t> row_start_;
+    std::vector<int32_t> col_;
+    std::vector<double> val_;
+  };
+
+  /** Read-only view of a binary KKT dump (.bkkt) through a memory mapping of the file; the
+   * arrays are used in place and remain valid until 'close' is called or the view destroyed.
+   */
+  class hiopCSR_BinaryView {
+  public:
+    hiopCSR_BinaryView()
+      : n(0), nnz(0), row_start(NULL), col(NULL), val(NULL), num_vecs(0),
+	addr_(NULL), size_(0)
+    {
+    }
+    ~hiopCSR_BinaryView()
+    {
+      close();
+    }
+
+    /* maps the file and checks its layout; returns false if the file is not a valid dump */
+    bool open(const char* fname)
+    {
+      close();
+      int fd = ::open(fname, O_RDONLY);
+      if(fd<0) return false;
+      struct stat st;
+      if(fstat(fd, &st)!=0 || st.st_size<(off_t)sizeof(hiopCSR_BinaryHeader)) {
+	::close(fd);
+	return false;
+      }
+      size_ = st.st_size;
+      addr_ = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+      if(addr_==MAP_FAILED) {
+	addr_ = NULL;
+	return false;
+      }
+
+      const hiopCSR_BinaryHeader* h = (const hiopCSR_BinaryHeader*) addr_;
+      if(memcmp(h->magic, hiopCSR_BinaryMagic, sizeof(h->magic))!=0 || h->version!=1 ||
+	 h->n<0 || h->nnz<0) {
+	close();
+	return false;
+      }
+      n = h->n; nnz = h->nnz;
+      const char* p = (const char*) addr_ + sizeof(hiopCSR_BinaryHeader);
+      row_start = (const int64_t*) p;      p += (n+1)*sizeof(int64_t);
+      col = (const int32_t*) p;            p += (nnz + nnz%2)*sizeof(int32_t);
+      val = (const double*) p;             p += nnz*sizeof(double);
+      const size_t data_size = p - (const char*) addr_;
+      if(data_size>size_ || row_start[0]!=0 || row_start[n]!=nnz) {
+	close();
+	return false;
+      }
+      num_vecs = n>0 ? (size_-data_size)/(n*sizeof(double)) : 0;
+      vecs_ = (const double*) p;
+      return true;
+    }
+    void close()
+    {
+      if(addr_) munmap(addr_, size_);
+      addr_ = NULL; size_ = 0;
+      n = 0; nnz = 0; num_vecs = 0;
+      row_start = NULL; col = NULL; val = NULL; vecs_ = NULL;
+    }
+    /* the k-th appended vector: rhs for k even and the solution of the previous rhs for k odd */
+    inline const double* vec(int k) const
+    {
+      assert(k>=0 && k<num_vecs);
+      return vecs_ + (size_t)k*n;
+    }
+  public:
+    int n;
+    int64_t nnz;
+    const int64_t* row_start;
+    const int32_t* col;
+    const double* val;
+    int num_vecs;
+  private:
+    void* addr_;
+    size_t size_;
+    const double* vecs_;
   };
 } // end namespace
 
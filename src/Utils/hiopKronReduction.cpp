@@ -6,8 +6,8 @@
 namespace hiop
 {
 
-  hiopKronReduction::hiopKronReduction()
-    : linsolver_(NULL), map_nonaux_to_aux_(NULL)
+  hiopKronReduction::hiopKronReduction(KronRetainMode retain_mode/*=kronRetainNothing*/)
+    : retain_mode_(retain_mode), linsolver_(NULL), map_nonaux_to_aux_(NULL), Ybb_(NULL), Yba_(NULL)
   {
     
   }
@@ -15,6 +15,24 @@ namespace hiop
   {
     delete linsolver_;
     delete map_nonaux_to_aux_;
+    delete Ybb_;
+    delete Yba_;
+  }
+
+  bool hiopKronReduction::same_sparsity_pattern(const hiopMatrixComplexSparseTriplet& Ybb) const
+  {
+    if(NULL==Ybb_) return false;
+    if(Ybb_->m()!=Ybb.m() || Ybb_->n()!=Ybb.n()) return false;
+
+    const int nnz = Ybb.numberOfNonzeros();
+    if(Ybb_->numberOfNonzeros()!=nnz) return false;
+
+    const int *irow = Ybb.storage()->i_row(), *jcol = Ybb.storage()->j_col();
+    const int *irow_ = Ybb_->storage()->i_row(), *jcol_ = Ybb_->storage()->j_col();
+    for(int it=0; it<nnz; it++) {
+      if(irow[it]!=irow_[it] || jcol[it]!=jcol_[it]) return false;
+    }
+    return true;
   }
   
   bool hiopKronReduction::go(const std::vector<int>& idx_nonaux_buses, 
@@ -44,13 +62,28 @@ namespace hiop
 			       idx_aux_buses.size(),
 			       idx_nonaux_buses.data(),
 			       idx_nonaux_buses.size());
-    
-    if(NULL != linsolver_) {
-      assert(false);
+
+    if(NULL != linsolver_ && same_sparsity_pattern(*Ybb)) {
+      //only the values changed: update them in the matrix the solver refers to; the symbolic
+      //analysis of the solver is reused by 'matrixChanged'
+      assert(retain_mode_ != kronRetainNothing);
+      const int nnz = Ybb->numberOfNonzeros();
+      std::complex<double>* vals = Ybb_->storage()->M();
+      const std::complex<double>* vals_new = Ybb->storage()->M();
+      for(int it=0; it<nnz; it++) vals[it] = vals_new[it];
+      delete Ybb;
+    } else {
       delete linsolver_;
+      delete Ybb_;
+      Ybb_ = Ybb;
+      linsolver_ = new hiopLinSolverUMFPACKZ(*Ybb_);
     }
+    Ybb = NULL;
 
-    linsolver_ = new hiopLinSolverUMFPACKZ(*Ybb);
+    delete map_nonaux_to_aux_;
+    map_nonaux_to_aux_ = NULL;
+    delete Yba_;
+    Yba_ = NULL;
 
     int nret = linsolver_->matrixChanged();
     if(nret>=0) {
@@ -61,30 +94,42 @@ namespace hiop
 
       //Ybb\Yba
       //hiopMatrixComplexDense Ybbinv_Yba(Yba_->m(), Yba_->n());
-      assert(map_nonaux_to_aux_==NULL);
-      delete map_nonaux_to_aux_;
-      map_nonaux_to_aux_ = new hiopMatrixComplexDense(Yba->m(), Yba->n());
-      linsolver_->solve(*Yba, *map_nonaux_to_aux_);
+      hiopMatrixComplexDense* map_nonaux_to_aux = new hiopMatrixComplexDense(Yba->m(), Yba->n());
+      linsolver_->solve(*Yba, *map_nonaux_to_aux);
 
-      map_nonaux_to_aux_->negate();
+      map_nonaux_to_aux->negate();
       //Ybbinv_Yba.print();
-      delete Ybb;
-      delete linsolver_;
-      linsolver_ = NULL;
 
       //Ybus_red = - Yab*(Ybb\Yba)
-      Yba->transTimesMat(0.0, Ybus_red, 1.0, *map_nonaux_to_aux_);
-      delete Yba;
+      Yba->transTimesMat(0.0, Ybus_red, 1.0, *map_nonaux_to_aux);
       
       Ybus_red.addSparseMatrix(std::complex<double>(1.0, 0.0), *Yaa);
       delete Yaa;
 
+      if(retain_mode_ == kronRetainNumeric) {
+	//apply_nonaux_to_aux will use Yba and the factors of Ybb
+	delete map_nonaux_to_aux;
+	Yba_ = Yba;
+      } else {
+	map_nonaux_to_aux_ = map_nonaux_to_aux;
+	delete Yba;
+
+	if(retain_mode_ == kronRetainSymbolic) {
+	  linsolver_->release_numeric();
+	} else {
+	  delete linsolver_;
+	  linsolver_ = NULL;
+	  delete Ybb_;
+	  Ybb_ = NULL;
+	}
+      }
     } else {
       printf("Error occured while performing the Kron reduction (factorization issue)\n");
       delete linsolver_;
       linsolver_ = NULL;
       delete Yaa;
-      delete Ybb;
+      delete Ybb_;
+      Ybb_ = NULL;
       delete Yba;
       return false;
     }
@@ -98,9 +143,23 @@ namespace hiop
   bool hiopKronReduction::apply_nonaux_to_aux(const std::vector<std::complex<double> >& v_nonaux_in,
 					     std::vector<std::complex<double> >& v_aux_out)
   {
-
-    assert(map_nonaux_to_aux_);
-    if(NULL==map_nonaux_to_aux_) return false;
+    if(NULL==map_nonaux_to_aux_) {
+      //sparse variant: v_aux_out = - Ybb\(Yba*v_nonaux_in), same sign as the dense map
+      assert(retain_mode_ == kronRetainNumeric);
+      assert(Yba_ && linsolver_);
+      if(NULL==Yba_ || NULL==linsolver_) return false;
+
+      assert(v_nonaux_in.size() == Yba_->n());
+      assert(v_aux_out.size() == Yba_->m());
+
+      std::vector<std::complex<double> > Yba_x_vnonaux(Yba_->m());
+      Yba_->timesVec(0., Yba_x_vnonaux.data(), 1., v_nonaux_in.data());
+      if(!linsolver_->solve(Yba_x_vnonaux.data(), v_aux_out.data())) {
+	return false;
+      }
+      for(auto& v : v_aux_out) v = -v;
+      return true;
+    }
 
     assert(v_nonaux_in.size() == map_nonaux_to_aux_->n());
     assert(v_aux_out.size() == map_nonaux_to_aux_->m());
@@ -109,19 +168,6 @@ namespace hiop
 				 v_aux_out.data(),
 				 std::complex<double>(1.,0.),
 				 v_nonaux_in.data());
-
-    
-    // assert(linsolver_);
-    // std::complex<double> Yba_x_vnonaux[Yba_->n()];
-
-    // for(int i=0; i<Yba_->n(); i++) {
-    //   Yba_x_vnonaux[i]=0.;
-    // }
-    
-    // Yba_->timesVec(0., Yba_x_vnonaux, 1., v_nonaux_in.data());
-
-    // assert(Yba_->m() == v_aux_out.size());
-    // linsolver_->solve(Yba_x_vnonaux, v_aux_out.data());
     
     return true;
   }
@@ -56,6 +56,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <cassert>
 
 namespace hiop
 {
@@ -69,7 +70,18 @@ namespace hiop
   class hiopKronReduction
   {
   public:
-    hiopKronReduction();
+    /* What is kept between calls to @go
+     *  - kronRetainNothing: nothing, except the dense map (Ybb\Yba) used by @apply_nonaux_to_aux
+     *  - kronRetainSymbolic: the symbolic analysis of Ybb is reused by subsequent calls to @go 
+     * when the sparsity pattern of Ybb does not change, i.e., only the numeric factorization
+     * is redone when only the admittance values change
+     *  - kronRetainNumeric: as kronRetainSymbolic and, additionally, the numeric factors of 
+     * Ybb are kept and @apply_nonaux_to_aux is performed with sparse solves; the dense map is
+     * not kept (@map_nonaux_to_aux is not available)
+     */
+    enum KronRetainMode { kronRetainNothing=0, kronRetainSymbolic, kronRetainNumeric };
+
+    hiopKronReduction(KronRetainMode retain_mode=kronRetainNothing);
     virtual ~hiopKronReduction();
     
     /* Performs the Kron reduction (computes Schur complement)
@@ -89,17 +101,31 @@ namespace hiop
 
     /** 
      * Performs v_aux_out = (Ybb\Yba)* v_nonaux_in
+     *
+     * Uses the dense map or, in the kronRetainNumeric mode, a sparse mat-vec with Yba 
+     * followed by a solve with the retained factors of Ybb.
      */
     bool apply_nonaux_to_aux(const std::vector<std::complex<double> >& v_nonaux_in,
 			    std::vector<std::complex<double> >& v_aux_out);
 
+    /* not available in the kronRetainNumeric mode */
     const hiopMatrixComplexDense& map_nonaux_to_aux() const
     {
+      assert(map_nonaux_to_aux_);
       return *map_nonaux_to_aux_;
     } 
   private:
+    //true when Ybb_ and Ybb have the same dimensions and sparsity pattern
+    bool same_sparsity_pattern(const hiopMatrixComplexSparseTriplet& Ybb) const;
+  private:
+    KronRetainMode retain_mode_;
     hiopLinSolverUMFPACKZ* linsolver_;
     hiopMatrixComplexDense* map_nonaux_to_aux_;
+    
+    //matrix factorized by linsolver_; kept (when linsolver_ is kept) since the solver refers to it
+    hiopMatrixComplexSparseTriplet* Ybb_;
+    //kept only in the kronRetainNumeric mode
+    hiopMatrixComplexSparseTriplet* Yba_;
   };
 
 } //end namespace
@@ -0,0 +1,116 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#pragma once
+
+/**
+ * @file hiopOmp.hpp
+ *
+ * Threading parameters and OpenMP loop macros shared by the CPU kernels. The loops run with the 
+ * number of threads and are executed serially below the size threshold of the hiopOmpParams of 
+ * the NLP (options 'num_threads' and 'omp_serial_threshold'), which the vectors and matrices 
+ * allocated by the NLP point to. Without HIOP_USE_OPENMP the macros expand to nothing.
+ */
+
+#include "hiop_defs.hpp"
+
+#ifdef HIOP_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace hiop
+{
+
+class hiopOmpParams
+{
+public:
+  hiopOmpParams() 
+  {
+    set(0, 10000);
+  }
+  /// @brief a number of threads equal to 0 selects the OpenMP default
+  void set(int num_threads, long long serial_threshold)
+  {
+#ifdef HIOP_USE_OPENMP
+    num_threads_ = num_threads>0 ? num_threads : omp_get_max_threads();
+#else
+    num_threads_ = 1;
+#endif
+    serial_threshold_ = serial_threshold;
+  }
+  inline int num_threads() const { return num_threads_; }
+  inline long long serial_threshold() const { return serial_threshold_; }
+
+  /// @brief the parameters of the objects not allocated by an NLP
+  static const hiopOmpParams* defaults()
+  {
+    static const hiopOmpParams params;
+    return &params;
+  }
+private:
+  int num_threads_;
+  long long serial_threshold_;
+};
+
+} //end of namespace
+
+#ifdef HIOP_USE_OPENMP
+#define HIOP_PRAGMA(x) _Pragma(#x)
+// parallel loop over 'n' entries (of a vector, rows, tiles, or nonzeros of a matrix) with the 
+// threading parameters 'params' (a pointer to hiopOmpParams)
+#define HIOP_OMP_FOR(n, params)						\
+  HIOP_PRAGMA(omp parallel for schedule(static) num_threads((params)->num_threads()) \
+	      if((n)>=(params)->serial_threshold()))
+// as above with a reduction 'op' of the variables in the remaining arguments
+#define HIOP_OMP_FOR_REDUCTION(n, params, op, ...)				\
+  HIOP_PRAGMA(omp parallel for schedule(static) num_threads((params)->num_threads()) \
+	      if((n)>=(params)->serial_threshold()) reduction(op:__VA_ARGS__))
+#else
+#define HIOP_OMP_FOR(n, params)
+#define HIOP_OMP_FOR_REDUCTION(n, params, op, ...)
+#endif
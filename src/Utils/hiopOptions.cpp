@@ -116,6 +116,12 @@ void hiopOptions::registerOptions()
   registerNumOption("theta_mu", 1.5,  1.0,   2.0, 
 		    "Exponential reduction coefficient for mu (default 1.5) (eqn (7) in Filt-IPM paper)");
   registerNumOption("eta_phi", 1e-8, 0, 0.01, "Parameter of (suff. decrease) in Armijo Rule");
+  registerIntOption("max_soc_iter", 4, 0, 1000,
+		    "Maximum number of second-order correction steps attempted when the first trial point "
+		    "of the line search is rejected; 0 disables the corrections (default 4)");
+  registerNumOption("kappa_soc", 0.99, 1e-8, 1.,
+		    "A second-order correction is attempted only if the previous one reduced the "
+		    "infeasibility by at least this factor, in (0,1] (default 0.99)");
   registerNumOption("tolerance", 1e-8, 1e-14, 1e-1, 
 		    "Absolute error tolerance for the NLP (default 1e-8)");
   registerNumOption("rel_tolerance", 0., 0., 0.1, 
@@ -146,6 +152,23 @@ void hiopOptions::registerOptions()
 
   registerIntOption("max_iter", 3000, 1, 1e6, "Max number of iterations (default 3000)");
 
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("warm_start", range[0], range,
+		      "Use the primal-dual starting point provided by the user through "
+		      "'get_starting_point' (with duals) as a warm start: the point is pushed inside "
+		      "the bounds by 'warm_start_bound_push' instead of 'kappa1' and 'kappa2' and the "
+		      "bound duals by 'warm_start_mult_bound_push'. The initial barrier parameter is "
+		      "'mu0', which should be set accordingly, e.g., to the final value of the barrier "
+		      "parameter of the previous solve (default 'no')");
+    registerNumOption("warm_start_bound_push", 1e-9, 1e-16, 0.49999,
+		      "Relative push of the warm-start primal point inside the bounds, used in place "
+		      "of 'kappa1' and 'kappa2' when 'warm_start' is 'yes' (default 1e-9)");
+    registerNumOption("warm_start_mult_bound_push", 1e-9, 0., 1e+20,
+		      "Smallest value of the bound duals provided by the user when 'warm_start' is "
+		      "'yes' (default 1e-9)");
+  }
+
   registerNumOption("acceptable_tolerance", 1e-6, 1e-14, 1e-1, 
 		    "HiOp will terminate if the NLP residuals are below for 'acceptable_iterations' "
 		    "many consecutive iterations (default 1e-6)");   
@@ -192,6 +215,19 @@ void hiopOptions::registerOptions()
 		      "fixed_var_perturb (default 1e-8)");
   }
 
+  //scaling of the problem
+  {
+    vector<string> range(2); range[0]="none"; range[1]="gradient";
+    registerStrOption("scaling_type", "none", range,
+		      "Scaling of the problem: 'none' or 'gradient', in which case the objective and each "
+		      "constraint are scaled so that the max norm of their gradients at the starting "
+		      "point is at most 'scaling_max_grad' (default 'none')");
+
+    registerNumOption("scaling_max_grad", 100., 1e-20, 1e+20,
+		      "The gradient-based scaling is applied to the functions whose gradients have the "
+		      "max norm larger than this value at the starting point (default 100)");
+  }
+
   //optimization method used
   {
     vector<string> range(2); range[0]="quasinewton_approx"; range[1]="analytical_exact"; 
@@ -216,6 +252,31 @@ void hiopOptions::registerOptions()
 		      "'forcequick'=rely on faster solvers on all situations "
 		      "(experimental, avoid)");
   }
+  {
+    vector<string> range(2); range[0]="auto"; range[1]="ldl";
+    registerStrOption("dense_fact_strategy", "auto", range,
+		      "Factorization used by the dense (LAPACK) linear solver: 'auto' uses Cholesky on the "
+		      "blocks of quasi-definite KKT matrices, with the inertia obtained from Haynsworth's "
+		      "formula, and falls back to Bunch-Kaufman (DSYTRF) when Cholesky fails; "
+		      "'ldl' always uses Bunch-Kaufman");
+  }
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("mds_incremental_ic", range[0], range,
+		      "Cache the parts of the MDS reduced KKT matrix that do not depend on the inertia "
+		      "correction perturbations and only update the perturbation-dependent parts at "
+		      "each inertia correction (requires memory for an additional copy of the reduced "
+		      "matrix) (default 'no')");
+  }
+
+  {
+    vector<string> range(2); range[0]="triplet"; range[1]="csr";
+    registerStrOption("sparse_format", range[0], range,
+		      "Storage of the sparse blocks of the MDS matrices: 'triplet' (default) or 'csr', "
+		      "which uses compressed sparse rows with threaded products with vectors (the "
+		      "sparse triplets provided by the user need to be ordered on rows and then on "
+		      "columns)");
+  }
 
   //computations
   {
@@ -224,6 +285,15 @@ void hiopOptions::registerOptions()
 		      "'auto', 'cpu', 'hybrid'; 'hybrid'=cpu+gpu; 'auto' will decide between "
 		      "'cpu' and 'hybrid' based on the other options passed");
   }
+  {
+    registerIntOption("num_threads", 0, 0, 4096,
+		      "Number of OpenMP threads used by the vector and sparse CSR matrix kernels when "
+		      "HiOp is built with "
+		      "HIOP_USE_OPENMP; 0 uses the OpenMP default, e.g., OMP_NUM_THREADS (default 0)");
+    registerIntOption("omp_serial_threshold", 10000, 0, 1e9,
+		      "Local vector length below which the vector kernels are executed serially "
+		      "even when HiOp is built with HIOP_USE_OPENMP (default 10000)");
+  }
   //inertia correction and Jacobian regularization
   {
     //Hessian related
@@ -259,6 +329,14 @@ void hiopOptions::registerOptions()
 		      "turn on/off performance timers and reporting of the computational constituents of the "
 		      "KKT solve process");
   }
+  {
+    vector<string> range(3); range[0]="off"; range[1]="json"; range[2]="chrome";
+    registerStrOption("profile", range[0], range,
+		      "profile the phases of the solver (calls, inclusive and exclusive times, bytes and "
+		      "flops, with min/avg/max over the MPI ranks) and write the profile at the end of "
+		      "the run to 'hiop_profile.json' (json) or to 'hiop_profile_trace.json' in the Chrome "
+		      "trace format (chrome) (default 'off')");
+  }
 
   //other options
   {
@@ -266,6 +344,14 @@ void hiopOptions::registerOptions()
     registerStrOption("write_kkt", range[0], range, 
 		      "write internal KKT linear system (matrix, rhs, sol) to file (default 'no')");
   }
+  {
+    vector<string> range(2); range[0]="binary"; range[1]="iajaaa";
+    registerStrOption("write_kkt_format", range[0], range,
+		      "format of the KKT linear systems written when 'write_kkt' is 'yes': memory-mappable "
+		      "binary '.bkkt' files or text '.iajaaa' files (default 'binary')");
+  }
+  registerIntOption("write_kkt_every", 1, 1, 1e6,
+		    "write only every k-th KKT linear system when 'write_kkt' is 'yes' (default 1)");
 }
 
 void hiopOptions::registerNumOption(const std::string& name, double defaultValue, 
@@ -0,0 +1,336 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#include "hiopProfiler.hpp"
+#include "hiopLogger.hpp"
+
+#ifndef HIOP_USE_MPI
+#include <sys/time.h>
+#endif
+
+#include <cassert>
+#include <cstring>
+#include <map>
+
+namespace hiop
+{
+
+/* same clock as hiopTimer */
+static inline double wtime()
+{
+#ifdef HIOP_USE_MPI
+  return MPI_Wtime();
+#else
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec)/1000000.0;
+#endif
+}
+
+/* region names are written as JSON strings */
+static void write_json_string(FILE* f, const std::string& s)
+{
+  fputc('"', f);
+  for(char c : s) {
+    if(c=='"' || c=='\\') fputc('\\', f);
+    fputc(c, f);
+  }
+  fputc('"', f);
+}
+
+hiopProfiler::hiopProfiler()
+  : enabled_(false), current_(-1)
+{
+}
+
+hiopProfiler::~hiopProfiler()
+{
+}
+
+void hiopProfiler::reset()
+{
+  regions_.clear();
+  current_ = -1;
+}
+
+int hiopProfiler::enter(const char* name)
+{
+  //look for the region among the children of the current region; there are only a few of them
+  int id = -1;
+  if(current_>=0) {
+    for(int child : regions_[current_].children) {
+      if(regions_[child].name == name) { id = child; break; }
+    }
+  } else {
+    for(int r=0; r<(int)regions_.size(); r++) {
+      if(regions_[r].parent<0 && regions_[r].name == name) { id = r; break; }
+    }
+  }
+  if(id<0) {
+    Region reg;
+    reg.name = name;
+    reg.parent = current_;
+    reg.calls = 0;
+    reg.tm_incl = reg.tm_children = 0.;
+    reg.bytes = reg.flops = 0.;
+    reg.tm_start = 0.;
+    id = regions_.size();
+    regions_.push_back(reg);
+    if(current_>=0) regions_[current_].children.push_back(id);
+  }
+  current_ = id;
+  regions_[id].tm_start = wtime();
+  return id;
+}
+
+void hiopProfiler::leave(int id)
+{
+  assert(id>=0 && id<(int)regions_.size());
+  assert(id==current_ && "profiler regions should be left in the reverse order of entering");
+  Region& reg = regions_[id];
+  const double tm = wtime() - reg.tm_start;
+  reg.tm_incl += tm;
+  reg.calls++;
+  if(reg.parent>=0) regions_[reg.parent].tm_children += tm;
+  current_ = reg.parent;
+}
+
+void hiopProfiler::add_work(int id, double bytes, double flops)
+{
+  assert(id>=0 && id<(int)regions_.size());
+  regions_[id].bytes += bytes;
+  regions_[id].flops += flops;
+}
+
+std::string hiopProfiler::path(int id) const
+{
+  std::string p = regions_[id].name;
+  for(int r=regions_[id].parent; r>=0; r=regions_[r].parent) {
+    p = regions_[r].name + "/" + p;
+  }
+  return p;
+}
+
+void hiopProfiler::reduce(MPI_Comm comm, std::vector<Stats>& stats, int& num_ranks) const
+{
+  const int nstats = 5;
+  int rank=0;
+  num_ranks=1;
+#ifdef HIOP_USE_MPI
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &num_ranks);
+#endif
+
+  //the regions of rank 0 are matched on the other ranks by their paths
+  std::vector<int> ids;
+#ifdef HIOP_USE_MPI
+  std::string paths;
+  if(0==rank) {
+    for(int r=0; r<(int)regions_.size(); r++) paths += path(r) + '\n';
+  }
+  int len = paths.size();
+  MPI_Bcast(&len, 1, MPI_INT, 0, comm);
+  std::vector<char> buf(paths.begin(), paths.end());
+  buf.resize(len+1, '\0');
+  MPI_Bcast(buf.data(), len, MPI_CHAR, 0, comm);
+
+  std::map<std::string, int> local;
+  for(int r=0; r<(int)regions_.size(); r++) local[path(r)] = r;
+  size_t start=0;
+  for(int k=0; k<len; k++) {
+    if(buf[k]!='\n') continue;
+    std::map<std::string, int>::const_iterator it = local.find(std::string(&buf[start], k-start));
+    ids.push_back(it==local.end() ? -1 : it->second);
+    start = k+1;
+  }
+#else
+  for(int r=0; r<(int)regions_.size(); r++) ids.push_back(r);
+#endif
+
+  const int nreg = ids.size();
+  std::vector<double> vals(nstats*nreg, 0.);
+  for(int k=0; k<nreg; k++) {
+    if(ids[k]<0) continue;
+    const Region& reg = regions_[ids[k]];
+    double* v = &vals[nstats*k];
+    v[0] = reg.calls;
+    v[1] = reg.tm_incl;
+    v[2] = reg.tm_incl - reg.tm_children;
+    v[3] = reg.bytes;
+    v[4] = reg.flops;
+  }
+
+  std::vector<double> vmin(vals), vmax(vals), vsum(vals);
+#ifdef HIOP_USE_MPI
+  if(nreg>0) {
+    MPI_Reduce(vals.data(), vmin.data(), nstats*nreg, MPI_DOUBLE, MPI_MIN, 0, comm);
+    MPI_Reduce(vals.data(), vmax.data(), nstats*nreg, MPI_DOUBLE, MPI_MAX, 0, comm);
+    MPI_Reduce(vals.data(), vsum.data(), nstats*nreg, MPI_DOUBLE, MPI_SUM, 0, comm);
+  }
+#endif
+  stats.resize(nreg);
+  for(int k=0; k<nreg; k++) {
+    for(int s=0; s<nstats; s++) {
+      stats[k].min[s] = vmin[nstats*k+s];
+      stats[k].max[s] = vmax[nstats*k+s];
+      stats[k].avg[s] = vsum[nstats*k+s]/num_ranks;
+    }
+  }
+}
+
+void hiopProfiler::write_json(FILE* f, int id, const std::vector<Stats>& stats, int indent) const
+{
+  static const char* keys[5] = {"calls", "incl_sec", "excl_sec", "bytes", "flops"};
+  const Stats& st = stats[id];
+  fprintf(f, "%*s{\"name\": ", indent, "");
+  write_json_string(f, regions_[id].name);
+  for(int s=0; s<5; s++) {
+    fprintf(f, ", \"%s\": [%.9g, %.9g, %.9g]", keys[s], st.min[s], st.avg[s], st.max[s]);
+  }
+  fprintf(f, ", \"children\": [");
+  const std::vector<int>& children = regions_[id].children;
+  for(size_t c=0; c<children.size(); c++) {
+    fprintf(f, "%s\n", c>0 ? "," : "");
+    write_json(f, children[c], stats, indent+2);
+  }
+  if(!children.empty()) fprintf(f, "\n%*s", indent, "");
+  fprintf(f, "]}");
+}
+
+/* The aggregated regions are laid out as nested complete ("X") events: a region starts at 
+ * 'ts' (microseconds) and its children follow each other from the start of the parent. The
+ * tracks 0, 1, and 2 show the average, minimum, and maximum over the ranks. */
+void hiopProfiler::write_trace(FILE* f, int id, const std::vector<Stats>& stats, 
+			       int tid, double ts, bool& first) const
+{
+  const Stats& st = stats[id];
+  const double* v = tid==0 ? st.avg : (tid==1 ? st.min : st.max);
+  fprintf(f, "%s\n  {\"name\": ", first ? "" : ",");
+  first = false;
+  write_json_string(f, regions_[id].name);
+  fprintf(f, ", \"cat\": \"hiop\", \"ph\": \"X\", \"pid\": 0, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f, "
+	  "\"args\": {\"calls\": %.9g, \"excl_sec\": %.9g, \"bytes\": %.9g, \"flops\": %.9g}}",
+	  tid, ts, 1e6*v[1], v[0], v[2], v[3], v[4]);
+  for(int child : regions_[id].children) {
+    const double* vc = tid==0 ? stats[child].avg : (tid==1 ? stats[child].min : stats[child].max);
+    write_trace(f, child, stats, tid, ts, first);
+    ts += 1e6*vc[1];
+  }
+}
+
+bool hiopProfiler::write(const std::string& format, const char* filename, MPI_Comm comm) const
+{
+  assert(current_<0 && "all the regions should be left before writing the profile");
+  std::vector<Stats> stats;
+  int num_ranks;
+  reduce(comm, stats, num_ranks);
+
+  int rank=0;
+#ifdef HIOP_USE_MPI
+  MPI_Comm_rank(comm, &rank);
+#endif
+  if(rank!=0) return true;
+
+  FILE* f = fopen(filename, "w");
+  if(NULL==f) return false;
+  if(format=="json") {
+    fprintf(f, "{\"num_ranks\": %d,\n \"stats\": \"[min, avg, max] over the ranks\",\n \"regions\": [", 
+	    num_ranks);
+    bool first = true;
+    for(int r=0; r<(int)stats.size(); r++) {
+      if(regions_[r].parent>=0) continue;
+      fprintf(f, "%s\n", first ? "" : ",");
+      write_json(f, r, stats, 2);
+      first = false;
+    }
+    fprintf(f, "]}\n");
+  } else {
+    assert(format=="chrome");
+    static const char* tracks[3] = {"avg over ranks", "min over ranks", "max over ranks"};
+    fprintf(f, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    bool first = true;
+    for(int tid=0; tid<(num_ranks>1 ? 3 : 1); tid++) {
+      fprintf(f, "%s\n  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": %d, "
+	      "\"args\": {\"name\": \"%s\"}}", first ? "" : ",", tid, tracks[tid]);
+      first = false;
+      double ts = 0.;
+      for(int r=0; r<(int)stats.size(); r++) {
+	if(regions_[r].parent>=0) continue;
+	write_trace(f, r, stats, tid, ts, first);
+	ts += 1e6*(tid==0 ? stats[r].avg[1] : (tid==1 ? stats[r].min[1] : stats[r].max[1]));
+      }
+    }
+    fprintf(f, "\n]}\n");
+  }
+  fclose(f);
+  return true;
+}
+
+hiopProfSession::hiopProfSession(hiopProfiler& prof, const std::string& format,
+				 MPI_Comm comm, hiopLogger* log)
+  : prof_(prof), format_(format), comm_(comm), log_(log), id_(-1)
+{
+  prof_.reset();
+  prof_.set_enabled(format_=="json" || format_=="chrome");
+  if(prof_.enabled()) id_ = prof_.enter("run");
+}
+
+hiopProfSession::~hiopProfSession()
+{
+  if(id_<0) return;
+  prof_.leave(id_);
+  const char* filename = format_=="json" ? "hiop_profile.json" : "hiop_profile_trace.json";
+  if(prof_.write(format_, filename, comm_)) {
+    if(log_) log_->printf(hovSummary, "Profile of the regions written to '%s'\n", filename);
+  } else {
+    if(log_) log_->printf(hovWarning, "Could not write the profile to '%s'\n", filename);
+  }
+  prof_.set_enabled(false);
+}
+
+} //end namespace
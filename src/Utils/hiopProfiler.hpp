@@ -0,0 +1,178 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#ifndef HIOP_PROFILER
+#define HIOP_PROFILER
+
+#include "hiopMPI.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace hiop
+{
+class hiopLogger;
+
+/** Aggregates the time spent in named, nestable regions of the code.
+ *
+ * The regions form a tree: a region entered while another one is active is a child of the
+ * latter, so the same name under different parents is accounted separately. For each region
+ * the number of calls, the inclusive time, the exclusive time (inclusive minus the time in
+ * the children), and the bytes moved and flops done (when the caller knows them) are
+ * accumulated. The regions are entered and left using hiopProfRegion objects and the whole
+ * tree is reported by hiopProfSession, see below. A disabled profiler costs one branch per
+ * region.
+ */
+class hiopProfiler
+{
+public:
+  hiopProfiler();
+  ~hiopProfiler();
+
+  inline bool enabled() const { return enabled_; }
+  void set_enabled(bool enabled) { enabled_ = enabled; }
+
+  /** Removes all regions and their statistics */
+  void reset();
+
+  /** Enters the region 'name' as a child of the current region and returns its id */
+  int enter(const char* name);
+  /** Leaves the region 'id', which should be the current region */
+  void leave(int id);
+  /** Adds to the bytes and flops of the region 'id' */
+  void add_work(int id, double bytes, double flops);
+
+  /** Writes the statistics of the regions reduced (min/avg/max) over the ranks of 'comm' as
+   * JSON ('format' is "json") or as Chrome trace events ('format' is "chrome"), which can be
+   * visualized in chrome://tracing or https://ui.perfetto.dev. Only rank 0 writes and only 
+   * the regions entered on rank 0 are reported. Collective on 'comm'. */
+  bool write(const std::string& format, const char* filename, MPI_Comm comm) const;
+private:
+  struct Region
+  {
+    std::string name;
+    int parent;
+    std::vector<int> children;
+    long long calls;
+    double tm_incl, tm_children; //seconds
+    double bytes, flops;
+    double tm_start;
+  };
+  /** statistics of a region reduced over the ranks */
+  struct Stats
+  {
+    double min[5], avg[5], max[5]; //calls, inclusive, exclusive, bytes, flops
+  };
+
+  void reduce(MPI_Comm comm, std::vector<Stats>& stats, int& num_ranks) const;
+  void write_json(FILE* f, int id, const std::vector<Stats>& stats, int indent) const;
+  void write_trace(FILE* f, int id, const std::vector<Stats>& stats, 
+		   int tid, double ts, bool& first) const;
+  std::string path(int id) const;
+private:
+  bool enabled_;
+  std::vector<Region> regions_;
+  int current_; //innermost active region, -1 if none
+};
+
+/** Enters a region of the profiler when constructed and leaves it when destroyed, so that
+ * the region is also left on early returns. 'stop' leaves the region before the destruction.
+ *
+ * Usage: hiopProfRegion reg(nlp->prof, "kkt.update"); 
+ */
+class hiopProfRegion
+{
+public:
+  hiopProfRegion(hiopProfiler& prof, const char* name)
+    : prof_(prof), id_(prof.enabled() ? prof.enter(name) : -1)
+  {
+  }
+  ~hiopProfRegion()
+  {
+    stop();
+  }
+  inline void stop()
+  {
+    if(id_>=0) prof_.leave(id_);
+    id_ = -1;
+  }
+  /** bytes moved and flops performed in this region, when known */
+  inline void add_work(double bytes, double flops)
+  {
+    if(id_>=0) prof_.add_work(id_, bytes, flops);
+  }
+private:
+  hiopProfRegion(const hiopProfRegion&);
+  hiopProfRegion& operator=(const hiopProfRegion&);
+  hiopProfiler& prof_;
+  int id_;
+};
+
+/** The outermost region of a profiling session, e.g., of a solver run. The profiler is reset
+ * and enabled when 'format' is "json" or "chrome" (disabled when it is "off"). On destruction 
+ * the region is left and the report is written to 'hiop_profile.json' (JSON) or 
+ * 'hiop_profile_trace.json' (Chrome trace). Collective on 'comm' when enabled.
+ */
+class hiopProfSession
+{
+public:
+  hiopProfSession(hiopProfiler& prof, const std::string& format, MPI_Comm comm, hiopLogger* log);
+  ~hiopProfSession();
+private:
+  hiopProfSession(const hiopProfSession&);
+  hiopProfSession& operator=(const hiopProfSession&);
+  hiopProfiler& prof_;
+  std::string format_;
+  MPI_Comm comm_;
+  hiopLogger* log_;
+  int id_;
+};
+
+} //end namespace
+#endif
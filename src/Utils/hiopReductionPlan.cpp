@@ -0,0 +1,178 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#include "hiopReductionPlan.hpp"
+
+#include <cassert>
+#include <cmath>
+
+namespace hiop
+{
+
+#ifdef HIOP_USE_MPI
+MPI_Datatype hiopReductionPlan::pair_type_ = MPI_DATATYPE_NULL;
+MPI_Op hiopReductionPlan::mixed_op_ = MPI_OP_NULL;
+#endif
+
+hiopReductionPlan::hiopReductionPlan(MPI_Comm comm)
+  : comm_(comm), resolved_(false)
+{
+}
+
+hiopReductionPlan::~hiopReductionPlan()
+{
+}
+
+int hiopReductionPlan::add_sum(const double& local, const double& replicated/*=0.*/)
+{
+  assert(!resolved_ && "call 'clear' before reusing the plan");
+  vals_.push_back(local);
+  replicated_.push_back(replicated);
+  ops_.push_back(redSum);
+  return vals_.size()-1;
+}
+
+int hiopReductionPlan::add_max(const double& local)
+{
+  assert(!resolved_ && "call 'clear' before reusing the plan");
+  vals_.push_back(local);
+  replicated_.push_back(0.);
+  ops_.push_back(redMax);
+  return vals_.size()-1;
+}
+
+int hiopReductionPlan::add_min(const double& local)
+{
+  assert(!resolved_ && "call 'clear' before reusing the plan");
+  vals_.push_back(local);
+  replicated_.push_back(0.);
+  ops_.push_back(redMin);
+  return vals_.size()-1;
+}
+
+void hiopReductionPlan::clear()
+{
+  vals_.clear();
+  replicated_.clear();
+  ops_.clear();
+  resolved_ = false;
+}
+
+#ifdef HIOP_USE_MPI
+/* Creates the pair type and the mixed op and attaches to MPI_COMM_SELF an attribute whose delete
+ * callback ('freeMixedOp') frees them at the beginning of MPI_Finalize */
+void hiopReductionPlan::createMixedOp()
+{
+  int ierr, keyval;
+  ierr = MPI_Type_contiguous(2, MPI_DOUBLE, &pair_type_); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Type_commit(&pair_type_); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Op_create(&hiopReductionPlan::mixedReduce, 1, &mixed_op_); assert(MPI_SUCCESS==ierr);
+
+  ierr = MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, &hiopReductionPlan::freeMixedOp, &keyval, NULL);
+  assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Comm_set_attr(MPI_COMM_SELF, keyval, NULL); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Comm_free_keyval(&keyval); assert(MPI_SUCCESS==ierr);
+}
+
+int hiopReductionPlan::freeMixedOp(MPI_Comm comm, int keyval, void* attr, void* extra_state)
+{
+  if(mixed_op_!=MPI_OP_NULL) MPI_Op_free(&mixed_op_);
+  if(pair_type_!=MPI_DATATYPE_NULL) MPI_Type_free(&pair_type_);
+  return MPI_SUCCESS;
+}
+
+// the elements are (op, value) pairs; the op is the same in 'in' and 'inout'
+void hiopReductionPlan::mixedReduce(void* in, void* inout, int* len, MPI_Datatype* dtype)
+{
+  const double* a = static_cast<const double*>(in);
+  double* b = static_cast<double*>(inout);
+  for(int i=0; i<*len; i++) {
+    const int op = (int)b[2*i];
+    assert(op == (int)a[2*i]);
+    if(op==redSum)      b[2*i+1] += a[2*i+1];
+    else if(op==redMax) b[2*i+1] = fmax(b[2*i+1], a[2*i+1]);
+    else                b[2*i+1] = fmin(b[2*i+1], a[2*i+1]);
+  }
+}
+#endif
+
+void hiopReductionPlan::resolve()
+{
+  assert(!resolved_);
+  const int n = vals_.size();
+#ifdef HIOP_USE_MPI
+  if(n>0) {
+    int ierr;
+    bool same_op = true;
+    for(int i=1; i<n && same_op; i++) same_op = ops_[i]==ops_[0];
+
+    if(same_op) {
+      MPI_Op op = ops_[0]==redSum ? MPI_SUM : (ops_[0]==redMax ? MPI_MAX : MPI_MIN);
+      ierr = MPI_Allreduce(MPI_IN_PLACE, vals_.data(), n, MPI_DOUBLE, op, comm_); 
+      assert(MPI_SUCCESS==ierr);
+    } else {
+      if(MPI_OP_NULL==mixed_op_) {
+	createMixedOp();
+      }
+      buf_.resize(2*n); 
+      buf_g_.resize(2*n);
+      for(int i=0; i<n; i++) {
+	buf_[2*i] = ops_[i];
+	buf_[2*i+1] = vals_[i];
+      }
+      ierr = MPI_Allreduce(buf_.data(), buf_g_.data(), n, pair_type_, mixed_op_, comm_); 
+      assert(MPI_SUCCESS==ierr);
+      for(int i=0; i<n; i++) vals_[i] = buf_g_[2*i+1];
+    }
+  }
+#endif
+  for(int i=0; i<n; i++) vals_[i] += replicated_[i];
+  resolved_ = true;
+}
+
+} //end of namespace
@@ -0,0 +1,127 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+/**
+ * @file hiopReductionPlan.hpp
+ *
+ * Batching of the global (MPI) reductions of scalar quantities computed locally on each rank.
+ */
+
+#ifndef HIOP_REDUCTION_PLAN
+#define HIOP_REDUCTION_PLAN
+
+#include "hiopMPI.hpp"
+
+#include <vector>
+#include <cassert>
+
+namespace hiop
+{
+
+/** 
+ * Collects local partial results (sums, maxima, and minima) and resolves all of them with
+ * a single collective over the communicator passed in the constructor. 
+ *
+ * Each add_xxx method returns the index of the slot used by the quantity, which is to be 
+ * used with 'get' once 'resolve' was called. The optional 'replicated' addend of 'add_sum' 
+ * is meant for contributions that are identical on all ranks (for example one-norms of 
+ * vectors not distributed across ranks): it is not reduced, but added to the global sum.
+ *
+ * When all the slots use the same operation, the reduction is done with the corresponding
+ * predefined MPI operation; otherwise a user-defined MPI operation, created once per process,
+ * is used.
+ */
+class hiopReductionPlan
+{
+public:
+  hiopReductionPlan(MPI_Comm comm);
+  virtual ~hiopReductionPlan();
+
+  int add_sum(const double& local, const double& replicated=0.);
+  int add_max(const double& local);
+  int add_min(const double& local);
+
+  /* Reduces all the slots added since the last 'clear' in one collective. */
+  void resolve();
+
+  inline double get(int idx) const
+  {
+    assert(resolved_);
+    assert(idx>=0 && idx<(int)vals_.size());
+    return vals_[idx];
+  }
+  inline int size() const { return vals_.size(); }
+  /* Empties the plan so that it can be reused for a new set of reductions */
+  void clear();
+private:
+  enum ReductionOp { redSum=0, redMax=1, redMin=2 };
+
+  MPI_Comm comm_;
+  //local values, overwritten by the global values by 'resolve'
+  std::vector<double> vals_;
+  std::vector<double> replicated_;
+  std::vector<int> ops_;
+  bool resolved_;
+#ifdef HIOP_USE_MPI
+  //buffers of (op, value) pairs for the mixed-operations reduction
+  std::vector<double> buf_, buf_g_;
+  //the pair type and the user-defined op are created once per process, when first needed, 
+  //and are shared by all the plans; they are freed by MPI_Finalize (see 'freeMixedOp')
+  static MPI_Datatype pair_type_;
+  static MPI_Op mixed_op_;
+  static void createMixedOp();
+  static void mixedReduce(void* in, void* inout, int* len, MPI_Datatype* dtype);
+  static int freeMixedOp(MPI_Comm comm, int keyval, void* attr, void* extra_state);
+#endif
+private:
+  hiopReductionPlan(const hiopReductionPlan&) {};
+  hiopReductionPlan& operator=(const hiopReductionPlan&) {return *this;};
+};
+
+} //end of namespace
+#endif
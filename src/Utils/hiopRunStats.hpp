@@ -247,6 +247,8 @@ public:
   int nEvalHessL;
   
   int nIter;
+  //number of line searches ended by an accepted second-order correction
+  int nSOCAccepted;
 
   hiopRunKKTSolStats kkt;
   hiopLinSolStats linsolv;
@@ -256,6 +258,7 @@ public:
     nEvalObj = nEvalGrad_f = nEvalCons_eq = nEvalCons_ineq =  nEvalJac_con_eq = nEvalJac_con_ineq = 0;
     nEvalHessL = 0;
     nIter = 0; 
+    nSOCAccepted = 0;
   }
 
   inline std::string get_summary(int masterRank=0) {
@@ -316,6 +319,7 @@ public:
     ss << "Fcn/deriv #: obj " << nEvalObj <<  " grad " << nEvalGrad_f 
        << " eq cons " << nEvalCons_eq << " ineq cons " << nEvalCons_ineq 
        << " eq Jac " << nEvalJac_con_eq << " ineq Jac " << nEvalJac_con_ineq << std::endl;
+    ss << "Second-order corrections accepted: " << nSOCAccepted << std::endl;
 
     return ss.str();
   }
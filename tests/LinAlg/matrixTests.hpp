@@ -583,6 +583,69 @@ public:
     return reduceReturn(fail, &A);
   }
 
+  /*
+   * The largest entry of each row is on rank 0 so that the maximum
+   * is taken across ranks when A is distributed.
+   */
+  virtual int matrixRowMaxAbsValue(
+      hiop::hiopMatrix& A,
+      hiop::hiopVector& x,
+      const int rank=0)
+  {
+    const local_ordinal_type M = getNumLocRows(&A);
+    const local_ordinal_type last_col_idx = getNumLocCols(&A)-1;
+    assert(getLocalSize(&x) == M && "Did you pass in vectors of the correct sizes?");
+    int fail = 0;
+
+    A.setToConstant(one);
+    if (rank == 0)
+    {
+      for (local_ordinal_type i=0; i<M; i++)
+        setLocalElement(&A, i, last_col_idx, -(i+two));
+    }
+    A.row_max_abs_value(x);
+
+    fail += verifyAnswer(&x,
+      [=] (local_ordinal_type i) -> real_type
+      {
+        return i + two;
+      });
+
+    printMessage(fail, __func__, rank);
+    return reduceReturn(fail, &A);
+  }
+
+  /*
+   * Scales and then inverse scales the rows of A
+   */
+  virtual int matrixScaleRow(
+      hiop::hiopMatrix& A,
+      hiop::hiopVector& x,
+      const int rank=0)
+  {
+    const local_ordinal_type M = getNumLocRows(&A);
+    assert(getLocalSize(&x) == M && "Did you pass in vectors of the correct sizes?");
+    const real_type A_val = two;
+    int fail = 0;
+
+    A.setToConstant(A_val);
+    for (local_ordinal_type i=0; i<M; i++)
+      setLocalElement(&x, i, i+one);
+
+    A.scale_row(x, false);
+    fail += verifyAnswer(&A,
+      [=] (local_ordinal_type i, local_ordinal_type j) -> real_type
+      {
+        return A_val * (i+one);
+      });
+
+    A.scale_row(x, true);
+    fail += verifyAnswer(&A, A_val);
+
+    printMessage(fail, __func__, rank);
+    return reduceReturn(fail, &A);
+  }
+
   /*
    * Set bottom right value to ensure that all values
    * are checked.
@@ -658,6 +721,10 @@ protected:
       local_ordinal_type i,
       local_ordinal_type j,
       real_type val) = 0;
+  virtual void setLocalElement(
+      hiop::hiopVector* x,
+      const local_ordinal_type i,
+      const real_type val) = 0;
   virtual real_type getLocalElement(
       const hiop::hiopMatrix* a,
       local_ordinal_type i,
@@ -59,6 +59,8 @@
 #include "matrixTests.hpp"
 #include "hiopVectorPar.hpp"
 
+#include <vector>
+
 namespace hiop { namespace tests {
 
 class MatrixTestsDense : public MatrixTests
@@ -136,6 +138,99 @@ public:
     return reduceReturn(fail, &A);
   }
 
+  /**
+   * Tests that the view returned by `new_rows_view` shares the storage of the
+   * rows of A, including rows allocated past A.m()
+   *
+   * @pre A has at least one extra row allocated
+   */
+  int matrixNewRowsView(
+      hiopMatrixDense &A,
+      const int rank)
+  {
+    const local_ordinal_type num_rows = A.m();
+    const real_type A_val = one;
+    const real_type view_val = two;
+    int fail = 0;
+
+    A.setToConstant(A_val);
+    hiopMatrixDense* view = A.new_rows_view(1, num_rows);
+    if(view == nullptr)
+    {
+      printMessage(++fail, __func__, rank);
+      return reduceReturn(fail, &A);
+    }
+    if(view->m() != num_rows || view->n() != A.n())
+      fail++;
+
+    // Writing to the view changes all rows of A except the first one
+    view->setToConstant(view_val);
+    fail += verifyAnswer(&A,
+      [=](local_ordinal_type i, local_ordinal_type j) -> real_type
+      {
+        (void)j; // j is unused
+        return (i == 0) ? A_val : view_val;
+      });
+    delete view;
+
+    // Rows past the allocated storage are not available
+    view = A.new_rows_view(2, num_rows);
+    if(view != nullptr)
+    {
+      fail++;
+      delete view;
+    }
+
+    printMessage(fail, __func__, rank);
+    return reduceReturn(fail, &A);
+  }
+
+  /**
+   * Tests W = beta*W + alpha*A*A^T computed in the upper triangle of W, and
+   * the packing of the upper triangle used to reduce it
+   *
+   * @pre W is local, square, and has as many rows as A
+   */
+  int matrixSymTimesMatTrans(
+      hiopMatrixDense &W,
+      hiopMatrixDense &A,
+      const int rank)
+  {
+    assert(W.m() == A.m() && W.n() == A.m());
+    const local_ordinal_type num_rows = A.m();
+    const global_ordinal_type N = A.n();
+    const real_type W_val = two,
+          alpha = half,
+          beta = two;
+    int fail = 0;
+
+    // row i of A is i+1, hence (A*A^T)_ij = (i+1)*(j+1)*N
+    for(local_ordinal_type i=0; i<num_rows; i++)
+      for(local_ordinal_type j=0; j<getNumLocCols(&A); j++)
+        setLocalElement(&A, i, j, i+1);
+    W.setToConstant(W_val);
+    A.symTimesMatTrans(beta, W, alpha);
+    fail += verifyAnswer(&W,
+      [=](local_ordinal_type i, local_ordinal_type j) -> real_type
+      {
+        return j<i ? W_val : beta*W_val + alpha*(i+1)*(j+1)*N;
+      });
+
+    // unpacking restores only the upper triangle
+    std::vector<real_type> packed(num_rows*(num_rows+1)/2);
+    W.packUpperTriangle(packed.data());
+    W.setToZero();
+    W.unpackUpperTriangle(packed.data());
+    fail += verifyAnswer(&W,
+      [=](local_ordinal_type i, local_ordinal_type j) -> real_type
+      {
+        return j<i ? zero : beta*W_val + alpha*(i+1)*(j+1)*N;
+      });
+
+    printMessage(fail, __func__, rank);
+    return reduceReturn(fail, &A);
+  }
+
   /**
    * Tests function that copies rows from source to destination starting from
    * `dst_start_idx` in the same order.
@@ -441,7 +536,7 @@ private:
   virtual void setLocalElement(
       hiop::hiopVector *_x,
       const local_ordinal_type i,
-      const real_type val);
+      const real_type val) override;
   virtual void setLocalRow(
       hiop::hiopMatrixDense *A,
       const local_ordinal_type row,
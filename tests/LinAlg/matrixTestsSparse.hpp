@@ -59,6 +59,7 @@
 
 #include <iostream>
 #include <functional>
+#include <vector>
 
 #include <hiopMatrixSparseTriplet.hpp>
 #include <hiopVectorPar.hpp>
@@ -211,6 +212,63 @@ public:
     return fail;
   }
   
+  /// Test function that returns the maximum absolute value of each row; the largest
+  /// entry of row i is the last nonzero of the row
+  bool matrixRowMaxAbsValue(hiop::hiopMatrixSparse& A, hiop::hiopVector& x)
+  {
+    assert(getLocalSize(&x) == A.m() && "Did you pass in vectors of the correct sizes?");
+    const local_ordinal_type nnz = A.numberOfNonzeros();
+    const local_ordinal_type* iRow = getRowIndices(&A);
+    auto val = getMatrixData(&A);
+
+    int fail = 0;
+
+    A.setToConstant(one);
+    std::vector<bool> row_has_nnz(A.m(), false);
+    for(local_ordinal_type k = 0; k < nnz; k++)
+    {
+      row_has_nnz[iRow[k]] = true;
+      if(k == nnz-1 || iRow[k+1] != iRow[k])
+        val[k] = -(iRow[k] + two);
+    }
+    A.row_max_abs_value(x);
+
+    fail += verifyAnswer(&x,
+      [&] (local_ordinal_type i) -> real_type
+      {
+        return row_has_nnz[i] ? i + two : zero;
+      });
+
+    printMessage(fail, __func__);
+    return fail;
+  }
+
+  /// Test function that scales and then inverse scales the rows of the matrix
+  bool matrixScaleRow(hiop::hiopMatrixSparse& A, hiop::hiopVector& x)
+  {
+    assert(getLocalSize(&x) == A.m() && "Did you pass in vectors of the correct sizes?");
+    const local_ordinal_type nnz = A.numberOfNonzeros();
+    const local_ordinal_type* iRow = getRowIndices(&A);
+    auto val = getMatrixData(&A);
+    const real_type A_val = two;
+
+    int fail = 0;
+
+    A.setToConstant(A_val);
+    for(local_ordinal_type i = 0; i < A.m(); i++)
+      setLocalElement(&x, i, i + one);
+
+    A.scale_row(x, false);
+    for(local_ordinal_type k = 0; k < nnz; k++)
+      fail += !isEqual(val[k], A_val * (iRow[k] + one));
+
+    A.scale_row(x, true);
+    fail += verifyAnswer(&A, A_val);
+
+    printMessage(fail, __func__);
+    return fail;
+  }
+
   /// Test method that checks if matrix elements are finite
   bool matrixIsFinite(hiop::hiopMatrixSparse& A)
   {
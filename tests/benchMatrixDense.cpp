@@ -0,0 +1,158 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause).
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to
+// endorse or promote products derived from this software without specific prior written
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC
+// nor any of their employees, makes any warranty, express or implied, or assumes any
+// liability or responsibility for the accuracy, completeness, or usefulness of any
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or
+// imply its endorsement, recommendation, or favoring by the United States Government or
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed
+// herein do not necessarily state or reflect those of the United States Government or
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or
+// product endorsement purposes.
+
+/**
+ * @file benchMatrixDense.cpp
+ *
+ * Microbenchmark of the kernels of hiopMatrixDenseRowMajor used to assemble the reduced MDS 
+ * KKT matrix (addToSymDenseMatrixUpperTriangle, transAddToSymDenseMatrixUpperTriangle and
+ * addUpperTriangleToSymDenseMatrixUpperTriangle) against straightforward double-indexed loops.
+ * The results of the kernels are checked against the ones of the loops.
+ *
+ * Usage: benchMatrixDense.exe [n [num_repetitions]]
+ */
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <cassert>
+
+#include <hiopMatrixDenseRowMajor.hpp>
+#include <hiopTimer.hpp>
+
+using namespace hiop;
+
+/* reference implementations: block of W += alpha*A, block of W += alpha*A^T, and diagonal 
+ * block of W += alpha*upper triangle of A */
+static void ref_add(const hiopMatrixDense& A, int row_start, int col_start, double alpha, hiopMatrixDense& W)
+{
+  double** AM = A.local_data(); double** WM = W.local_data();
+  for(int i=0; i<A.m(); i++)
+    for(int j=0; j<A.n(); j++)
+      WM[i+row_start][j+col_start] += alpha*AM[i][j];
+}
+static void ref_trans_add(const hiopMatrixDense& A, int row_start, int col_start, double alpha, hiopMatrixDense& W)
+{
+  double** AM = A.local_data(); double** WM = W.local_data();
+  for(int ir=0; ir<A.m(); ir++)
+    for(int jc=0; jc<A.n(); jc++)
+      WM[jc+row_start][ir+col_start] += alpha*AM[ir][jc];
+}
+static void ref_add_upper(const hiopMatrixDense& A, int diag_start, double alpha, hiopMatrixDense& W)
+{
+  double** AM = A.local_data(); double** WM = W.local_data();
+  for(int i=0; i<A.n(); i++)
+    for(int j=i; j<A.m(); j++)
+      WM[i+diag_start][j+diag_start] += alpha*AM[i][j];
+}
+
+static double max_diff(const hiopMatrixDense& X, const hiopMatrixDense& Y)
+{
+  double d=0.;
+  for(int i=0; i<X.m(); i++)
+    for(int j=0; j<X.n(); j++)
+      d = std::max(d, std::fabs(X.local_data()[i][j]-Y.local_data()[i][j]));
+  return d;
+}
+
+int main(int argc, char** argv)
+{
+#ifdef HIOP_USE_MPI
+  int err = MPI_Init(&argc, &argv); assert(MPI_SUCCESS==err);
+#endif
+  int n = 2000, nrep = 5;
+  if(argc>1) n = std::max(1, atoi(argv[1]));
+  if(argc>2) nrep = std::max(1, atoi(argv[2]));
+
+  //the source blocks are n x n/2 (and n/2 x n for the transposed kernel) placed in the upper 
+  //triangle of a (2n) x (2n) matrix, as the dense Hessian and Jacobian blocks of the MDS KKT
+  const int m = n/2+1;
+  hiopMatrixDenseRowMajor A(n, n), B(m, n), Bt(n, m);
+  hiopMatrixDenseRowMajor W1(2*n+m, 2*n+m), W2(2*n+m, 2*n+m);
+  for(int i=0; i<n; i++)
+    for(int j=0; j<n; j++)
+      A.local_data()[i][j] = std::sin(1.+i+0.5*j);
+  for(int i=0; i<m; i++)
+    for(int j=0; j<n; j++)
+      B.local_data()[i][j] = Bt.local_data()[j][i] = std::cos(1.+0.3*i+j);
+  W1.setToZero(); W2.setToZero();
+
+  hiopTimer t_ref[3], t_new[3];
+  for(int rep=0; rep<nrep; rep++) {
+    t_ref[0].start(); ref_add_upper(A, 0, 0.5, W1);            t_ref[0].stop();
+    t_new[0].start(); A.addUpperTriangleToSymDenseMatrixUpperTriangle(0, 0.5, W2); t_new[0].stop();
+
+    t_ref[1].start(); ref_add(Bt, 0, n, 1.5, W1);               t_ref[1].stop();
+    t_new[1].start(); Bt.addToSymDenseMatrixUpperTriangle(0, n, 1.5, W2);        t_new[1].stop();
+
+    t_ref[2].start(); ref_trans_add(B, 0, n+m, -1., W1);        t_ref[2].stop();
+    t_new[2].start(); B.transAddToSymDenseMatrixUpperTriangle(0, n+m, -1., W2);   t_new[2].stop();
+  }
+
+  const char* names[3] = {"addUpperTriangleToSymDenseMatrixUpperTriangle", 
+			  "addToSymDenseMatrixUpperTriangle", 
+			  "transAddToSymDenseMatrixUpperTriangle"};
+  printf("n=%d  repetitions=%d\n", n, nrep);
+  for(int k=0; k<3; k++) {
+    printf("%-48s  loops %10.6f sec   kernel %10.6f sec   speedup %6.2f\n", names[k], 
+	   t_ref[k].getElapsedTime()/nrep, t_new[k].getElapsedTime()/nrep, 
+	   t_ref[k].getElapsedTime()/std::max(1e-12, t_new[k].getElapsedTime()));
+  }
+
+  const double diff = max_diff(W1, W2);
+  int fail = diff > 1e-10*nrep;
+  if(fail) {
+    printf("kernels results differ from the reference loops: max abs diff %g\n", diff);
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return fail;
+}
@@ -0,0 +1,218 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause).
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to
+// endorse or promote products derived from this software without specific prior written
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC
+// nor any of their employees, makes any warranty, express or implied, or assumes any
+// liability or responsibility for the accuracy, completeness, or usefulness of any
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or
+// imply its endorsement, recommendation, or favoring by the United States Government or
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed
+// herein do not necessarily state or reflect those of the United States Government or
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or
+// product endorsement purposes.
+
+/**
+ * @file testKKTLinSysBlock.cpp
+ *
+ * Checks that the directions computed by 'computeDirectionsBlock' for several residuals match,
+ * residual by residual, the directions computed by 'computeDirections', for the MDS XYcYd and the
+ * dense XYcYd and XDYcYd KKT linear systems. The residuals are the ones of the log-barrier
+ * problems with different mu at the same iterate of Ex4 from the MDS drivers.
+ *
+ * Usage: testKKTLinSysBlock.exe [ns [nd]]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "nlpMDSForm_ex4.hpp"
+
+#include <hiopNlpFormulation.hpp>
+#include <hiopIterate.hpp>
+#include <hiopResidual.hpp>
+#include <hiopLogBarProblem.hpp>
+#include <hiopPDPerturbation.hpp>
+#include <hiopKKTLinSysMDS.hpp>
+#include <hiopKKTLinSysDense.hpp>
+
+using namespace hiop;
+
+static double max_rel_diff(const hiopVector& x, const hiopVector& y)
+{
+  hiopVector* diff = x.new_copy();
+  diff->axpy(-1., y);
+  const double d = diff->infnorm() / (1.+y.infnorm());
+  delete diff;
+  return d;
+}
+
+static double max_rel_diff(const hiopIterate& x, const hiopIterate& y)
+{
+  double d = 0.;
+  d = std::max(d, max_rel_diff(*x.get_x(),   *y.get_x()));
+  d = std::max(d, max_rel_diff(*x.get_d(),   *y.get_d()));
+  d = std::max(d, max_rel_diff(*x.get_sxl(), *y.get_sxl()));
+  d = std::max(d, max_rel_diff(*x.get_yc(),  *y.get_yc()));
+  d = std::max(d, max_rel_diff(*x.get_yd(),  *y.get_yd()));
+  d = std::max(d, max_rel_diff(*x.get_zl(),  *y.get_zl()));
+  d = std::max(d, max_rel_diff(*x.get_zu(),  *y.get_zu()));
+  d = std::max(d, max_rel_diff(*x.get_vl(),  *y.get_vl()));
+  d = std::max(d, max_rel_diff(*x.get_vu(),  *y.get_vu()));
+  return d;
+}
+
+/* factorizes the KKT system at 'it' and compares the block and the single residual solves */
+static int check_kkt(const char* name, hiopKKTLinSys& kkt, hiopNlpFormulation& nlp, double mu,
+		     const hiopIterate& it, const hiopVector& gradf,
+		     const hiopMatrix& Jac_c, const hiopMatrix& Jac_d, hiopMatrix& Hess,
+		     const std::vector<const hiopResidual*>& resids)
+{
+  hiopPDPerturbation pd_perturb;
+  pd_perturb.initialize(&nlp);
+  pd_perturb.set_mu(mu);
+  kkt.set_PD_perturb_calc(&pd_perturb);
+  if(!kkt.update(&it, &gradf, &Jac_c, &Jac_d, &Hess)) {
+    printf("%s: factorization failed\n", name);
+    return 1;
+  }
+
+  const size_t nrhs = resids.size();
+  std::vector<hiopIterate*> dirs(nrhs), dirs_block(nrhs);
+  bool ok = true;
+  for(size_t k=0; k<nrhs; k++) {
+    dirs[k] = it.alloc_clone();
+    dirs_block[k] = it.alloc_clone();
+    ok = kkt.computeDirections(resids[k], dirs[k]) && ok;
+  }
+  ok = kkt.computeDirectionsBlock(resids, dirs_block) && ok;
+
+  double err = 0.;
+  for(size_t k=0; k<nrhs; k++) {
+    err = std::max(err, max_rel_diff(*dirs_block[k], *dirs[k]));
+    delete dirs[k];
+    delete dirs_block[k];
+  }
+  if(!ok || err>1e-10) {
+    printf("%s: block directions differ from the single residual directions: rel. error %12.5e%s\n",
+	   name, err, ok ? "" : " (solve failed)");
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char** argv)
+{
+#ifdef HIOP_USE_MPI
+  int err = MPI_Init(&argc, &argv); assert(MPI_SUCCESS==err);
+#endif
+  int ns = 40, nd = 10;
+  if(argc>1) ns = std::max(4, atoi(argv[1]));
+  if(argc>2) nd = std::max(1, atoi(argv[2]));
+
+  int fail = 0;
+  {
+    Ex4 problem(ns, nd);
+    hiopNlpMDS nlp(problem);
+    nlp.options->SetIntegerValue("verbosity_level", 0);
+    nlp.finalizeInitialization();
+
+    //an interior iterate
+    hiopIterate it(&nlp);
+    it.get_x()->setToConstant(1.);
+    it.projectPrimalsXIntoBounds(1e-2, 1e-2);
+
+    double* x = it.get_x()->local_data();
+    double f;
+    hiopVector* gradf = nlp.alloc_primal_vec();
+    hiopVector* c = nlp.alloc_dual_eq_vec();
+    hiopVector* d = nlp.alloc_dual_ineq_vec();
+    hiopMatrix *Jac_c, *Jac_d;
+    nlp.alloc_Jac_c_d(Jac_c, Jac_d);
+    hiopMatrix* Hess = nlp.alloc_Hess_Lagr();
+
+    bool bret = nlp.eval_f(x, true, f); assert(bret);
+    bret = nlp.eval_grad_f(x, false, gradf->local_data()); assert(bret);
+    bret = nlp.eval_c_d(x, false, c->local_data(), d->local_data()); assert(bret);
+    bret = nlp.eval_Jac_c_d(x, false, *Jac_c, *Jac_d); assert(bret);
+
+    it.get_d()->copyFrom(*d);
+    it.projectPrimalsDIntoBounds(1e-2, 1e-2);
+    it.determineSlacks();
+    it.setBoundsDualsToConstant(1.);
+    it.setEqualityDualsToConstant(0.5);
+    bret = nlp.eval_Hess_Lagr(x, false, 1., it.get_yc()->local_data(), it.get_yd()->local_data(),
+			      true, *Hess);
+    assert(bret);
+
+    //residuals of the log-barrier problems with different mu
+    const double mus[] = {1e-1, 1e-2, 1e-3};
+    hiopLogBarProblem logbar(&nlp);
+    std::vector<const hiopResidual*> resids;
+    for(double mu : mus) {
+      logbar.updateWithNlpInfo(it, mu, f, *c, *d, *gradf, *Jac_c, *Jac_d);
+      hiopResidual* resid = new hiopResidual(&nlp);
+      resid->update(it, f, *c, *d, *gradf, *Jac_c, *Jac_d, logbar);
+      resids.push_back(resid);
+    }
+
+    {
+      hiopKKTLinSysCompressedMDSXYcYd kkt(&nlp);
+      fail += check_kkt("KKT MDS XYcYd", kkt, nlp, mus[0], it, *gradf, *Jac_c, *Jac_d, *Hess, resids);
+    }
+    {
+      hiopKKTLinSysDenseXYcYd kkt(&nlp);
+      fail += check_kkt("KKT dense XYcYd", kkt, nlp, mus[0], it, *gradf, *Jac_c, *Jac_d, *Hess, resids);
+    }
+    {
+      hiopKKTLinSysDenseXDYcYd kkt(&nlp);
+      fail += check_kkt("KKT dense XDYcYd", kkt, nlp, mus[0], it, *gradf, *Jac_c, *Jac_d, *Hess, resids);
+    }
+    if(!fail) printf("block and single residual KKT directions match\n");
+
+    for(auto r : resids) delete r;
+    delete Hess; delete Jac_c; delete Jac_d;
+    delete gradf; delete c; delete d;
+  }
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return fail;
+}
@@ -0,0 +1,229 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause).
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to
+// endorse or promote products derived from this software without specific prior written
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC
+// nor any of their employees, makes any warranty, express or implied, or assumes any
+// liability or responsibility for the accuracy, completeness, or usefulness of any
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or
+// imply its endorsement, recommendation, or favoring by the United States Government or
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed
+// herein do not necessarily state or reflect those of the United States Government or
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or
+// product endorsement purposes.
+
+/**
+ * @file testKKTLinSysMDS.cpp
+ *
+ * Checks that the reduced MDS KKT matrix assembled incrementally across inertia correction
+ * retries (option 'mds_incremental_ic') matches the one assembled from scratch, for a sequence
+ * of close and of growing perturbations delta_wx. Also checks that the retries that change only
+ * delta_cc reuse the Schur blocks and match the from-scratch matrix. The problem is Ex4 from the 
+ * MDS drivers.
+ *
+ * Usage: testKKTLinSysMDS.exe [ns [nd]]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <cassert>
+
+#include "nlpMDSForm_ex4.hpp"
+
+#include <hiopNlpFormulation.hpp>
+#include <hiopKKTLinSysMDS.hpp>
+#include <hiopLinAlgFactory.hpp>
+
+using namespace hiop;
+
+/* exposes the assembly of the reduced matrix of the MDS KKT linear system */
+class hiopKKTLinSysMDSTest : public hiopKKTLinSysCompressedMDSXYcYd
+{
+public:
+  hiopKKTLinSysMDSTest(hiopNlpFormulation* nlp) 
+    : hiopKKTLinSysCompressedMDSXYcYd(nlp) 
+  {}
+
+  /* sets the blocks used by the assembly; Dx is set to small, varying values so that Hs+Dxs+delta_wx
+   * is of the magnitude of the perturbations */
+  void setBlocks(hiopMatrix* Hess, const hiopMatrix* Jac_c, const hiopMatrix* Jac_d, double scal_Dx)
+  {
+    HessMDS_ = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(Hess);
+    Jac_cMDS_ = dynamic_cast<const hiopMatrixMDS*>(Jac_c);
+    Jac_dMDS_ = dynamic_cast<const hiopMatrixMDS*>(Jac_d);
+    assert(HessMDS_ && Jac_cMDS_ && Jac_dMDS_);
+
+    if(NULL==Hxs_) Hxs_ = LinearAlgebraFactory::createVector(HessMDS_->n_sp());
+    double* Dxv = Dx_->local_data();
+    for(long long i=0; i<Dx_->get_local_size(); i++) 
+      Dxv[i] = scal_Dx*(1.+(i%7));
+  }
+
+  void assemble(hiopMatrixDense& M, const double& delta_wx, bool first_trial, bool incremental)
+  {
+    incremental_ic_ = incremental;
+    assembleReducedMatrix(M, delta_wx, first_trial);
+  }
+
+  /* assembly followed by the diagonal perturbations of the xd and the eq. blocks, as in 'update' */
+  void assemble(hiopMatrixDense& M, const double& delta_wx, const double& delta_cc,
+		bool first_trial, bool incremental)
+  {
+    assemble(M, delta_wx, first_trial, incremental);
+    const long long nxd = HessMDS_->n_de(), neq = Jac_cMDS_->m();
+    M.addSubDiagonal(0, nxd, delta_wx);
+    M.addSubDiagonal(nxd, neq, -delta_cc);
+  }
+
+  long long n_schur_assemblies() const { return n_schur_assemblies_; }
+};
+
+static double max_abs(const hiopMatrixDense& X)
+{
+  double d=0.;
+  for(int i=0; i<X.m(); i++)
+    for(int j=0; j<X.n(); j++)
+      d = std::max(d, std::fabs(X.local_data()[i][j]));
+  return d;
+}
+
+static double max_diff(const hiopMatrixDense& X, const hiopMatrixDense& Y)
+{
+  double d=0.;
+  for(int i=0; i<X.m(); i++)
+    for(int j=0; j<X.n(); j++)
+      d = std::max(d, std::fabs(X.local_data()[i][j]-Y.local_data()[i][j]));
+  return d;
+}
+
+int main(int argc, char** argv)
+{
+#ifdef HIOP_USE_MPI
+  int err = MPI_Init(&argc, &argv); assert(MPI_SUCCESS==err);
+#endif
+  int ns = 40, nd = 10;
+  if(argc>1) ns = std::max(4, atoi(argv[1]));
+  if(argc>2) nd = std::max(1, atoi(argv[2]));
+
+  int fail = 0;
+  {
+    Ex4 problem(ns, nd);
+    hiopNlpMDS nlp(problem);
+    nlp.finalizeInitialization();
+
+    hiopVector* x = nlp.alloc_primal_vec();
+    hiopVector* yc = nlp.alloc_dual_eq_vec();
+    hiopVector* yd = nlp.alloc_dual_ineq_vec();
+    x->setToConstant(1.); yc->setToConstant(0.5); yd->setToConstant(-0.5);
+    hiopMatrix *Jac_c, *Jac_d;
+    nlp.alloc_Jac_c_d(Jac_c, Jac_d);
+    hiopMatrix* Hess = nlp.alloc_Hess_Lagr();
+    bool bret = nlp.eval_Jac_c_d(x->local_data(), true, *Jac_c, *Jac_d); assert(bret);
+    bret = nlp.eval_Hess_Lagr(x->local_data(), false, 1., yc->local_data(), yd->local_data(), 
+			      true, *Hess); 
+    assert(bret);
+
+    const long long nxd = nd, n = nxd + nlp.m_eq() + nlp.m_ineq();
+    hiopMatrixDense* M_inc = LinearAlgebraFactory::createMatrixDense(n, n);
+    hiopMatrixDense* M_ref = LinearAlgebraFactory::createMatrixDense(n, n);
+
+    //perturbations of an IC sequence: close retries (the regime in which a difference-of-inverses
+    //update cancels) followed by the usual growth by a constant factor
+    const int ndeltas = 10;
+    double deltas[ndeltas];
+    for(int k=0; k<5; k++) deltas[k] = 1e-4*(1.+1e-10*k);
+    for(int k=5; k<ndeltas; k++) deltas[k] = deltas[k-1]*8.;
+
+    const double scal_Dx[] = {1e-2, 1e-8};
+    for(double scal : scal_Dx) {
+      hiopKKTLinSysMDSTest kkt(&nlp);
+      kkt.setBlocks(Hess, Jac_c, Jac_d, scal);
+      double err_max = 0.;
+      for(int k=0; k<ndeltas; k++) {
+	kkt.assemble(*M_inc, deltas[k], 0==k, true);
+	kkt.assemble(*M_ref, deltas[k], true, false);
+	err_max = std::max(err_max, max_diff(*M_inc, *M_ref) / (1.+max_abs(*M_ref)));
+      }
+      if(err_max>1e-14) {
+	printf("incremental reduced matrix differs from the one assembled from scratch: "
+	       "rel. error %12.5e (Dx scaling %g)\n", err_max, scal);
+	fail++;
+      }
+    }
+
+    //IC retries that change only delta_cc: the Schur blocks are computed once per delta_wx
+    {
+      hiopKKTLinSysMDSTest kkt(&nlp);
+      kkt.setBlocks(Hess, Jac_c, Jac_d, 1e-2);
+      const double deltas_wx[] = {0., 1e-4};
+      const double deltas_cc[] = {1e-8, 1e-6, 1e-4};
+      double err_max = 0.;
+      long long n_expected = 0;
+      bool first = true;
+      for(double delta_wx : deltas_wx) {
+	for(double delta_cc : deltas_cc) {
+	  kkt.assemble(*M_inc, delta_wx, delta_cc, first, true);
+	  first = false;
+	  kkt.assemble(*M_ref, delta_wx, delta_cc, true, false);
+	  err_max = std::max(err_max, max_diff(*M_inc, *M_ref) / (1.+max_abs(*M_ref)));
+	}
+	//one incremental and three from-scratch assemblies
+	n_expected += 4;
+      }
+      if(err_max>1e-14) {
+	printf("incremental reduced matrix differs from the one assembled from scratch for "
+	       "delta_cc-only retries: rel. error %12.5e\n", err_max);
+	fail++;
+      }
+      if(kkt.n_schur_assemblies() != n_expected) {
+	printf("delta_cc-only retries recomputed the Schur blocks: %lld assemblies, expected %lld\n",
+	       kkt.n_schur_assemblies(), n_expected);
+	fail++;
+      }
+    }
+    if(!fail) printf("incremental and from-scratch reduced MDS matrices match\n");
+
+    delete M_inc; delete M_ref;
+    delete Hess; delete Jac_c; delete Jac_d;
+    delete x; delete yc; delete yd;
+  }
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return fail;
+}
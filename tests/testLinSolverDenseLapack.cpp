@@ -0,0 +1,178 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause).
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to
+// endorse or promote products derived from this software without specific prior written
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC
+// nor any of their employees, makes any warranty, express or implied, or assumes any
+// liability or responsibility for the accuracy, completeness, or usefulness of any
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or
+// imply its endorsement, recommendation, or favoring by the United States Government or
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed
+// herein do not necessarily state or reflect those of the United States Government or
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or
+// product endorsement purposes.
+
+/**
+ * @file testLinSolverDenseLapack.cpp
+ *
+ * Checks the factorizations of hiopLinSolverIndefDenseLapack under the strategy 'auto' with a
+ * quasi-definite hint: the block Cholesky when the hint holds, and the fallbacks to Bunch-Kaufman
+ * of the whole matrix (the (1,1) block is not positive definite) and of the Schur complement 
+ * (the Schur complement is indefinite). The inertia and the residuals of the solves are compared 
+ * with the ones of the strategy 'ldl'. The solves with multiple right-hand sides are compared 
+ * with the solves of each right-hand side.
+ */
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "nlpDenseCons_empty.hpp"
+
+#include <hiopNlpFormulation.hpp>
+#include <hiopLinSolverIndefDenseLapack.hpp>
+
+using namespace hiop;
+
+/* factorizes the symmetric matrix 'A' (row-major, n x n), solves with the rhs A*e, and returns
+ * the number of negative eigenvalues and the error of the solution; 'err_block' is the largest
+ * difference between the solutions of a multiple right-hand side solve and the ones of the solves
+ * of each of its right-hand sides */
+static int factorize_and_solve(hiopNlpFormulation& nlp, const std::vector<double>& A, int n, int n11,
+			       double& err, double& err_block)
+{
+  hiopLinSolverIndefDenseLapack solver(n, &nlp);
+  if(n11>=0) solver.set_quasidefinite_hint(n11);
+  //only the upper triangle is passed to the solver, as by the KKT linear systems
+  double** MM = solver.sysMatrix().local_data();
+  for(int i=0; i<n; i++)
+    for(int j=0; j<n; j++)
+      MM[i][j] = j>=i ? A[i*n+j] : 0.;
+
+  const int neg = solver.matrixChanged();
+  err = 0.;
+  if(neg<0) return neg;
+
+  hiopVectorPar x(n);
+  double* xv = x.local_data();
+  for(int i=0; i<n; i++) {
+    xv[i] = 0.;
+    for(int j=0; j<n; j++) xv[i] += A[i*n+j];
+  }
+  if(!solver.solve(x)) return -1;
+  for(int i=0; i<n; i++) err = std::max(err, std::fabs(xv[i]-1.));
+
+  //the rows of X are the right-hand sides
+  const int nrhs=3;
+  hiopMatrixDense* X = LinearAlgebraFactory::createMatrixDense(nrhs, n);
+  double** XX = X->local_data();
+  for(int k=0; k<nrhs; k++)
+    for(int i=0; i<n; i++)
+      XX[k][i] = std::cos(1.+k*n+i);
+  if(!solver.solve(*X)) {
+    delete X;
+    return -1;
+  }
+  err_block = 0.;
+  for(int k=0; k<nrhs; k++) {
+    for(int i=0; i<n; i++)
+      xv[i] = std::cos(1.+k*n+i);
+    if(!solver.solve(x)) err_block = 1e+20;
+    for(int i=0; i<n; i++)
+      err_block = std::max(err_block, std::fabs(XX[k][i]-xv[i])/(1.+std::fabs(xv[i])));
+  }
+  delete X;
+  return neg;
+}
+
+int main(int argc, char** argv)
+{
+#ifdef HIOP_USE_MPI
+  int err = MPI_Init(&argc, &argv); assert(MPI_SUCCESS==err);
+#endif
+  int fail = 0;
+  {
+    EmptyProblem problem;
+    hiopNlpDenseConstraints nlp_auto(problem), nlp_ldl(problem);
+    nlp_auto.options->SetIntegerValue("verbosity_level", 0);
+    nlp_ldl.options->SetIntegerValue("verbosity_level", 0);
+    nlp_auto.options->SetStringValue("dense_fact_strategy", "auto");
+    nlp_ldl.options->SetStringValue("dense_fact_strategy", "ldl");
+
+    struct TestMatrix { const char* name; int n, n11, neg; std::vector<double> A; };
+    std::vector<TestMatrix> tests;
+    tests.push_back({"quasi-definite", 3, 1, 2, {4,1,1, 1,-1,0, 1,0,-2}});
+    tests.push_back({"(1,1) block not positive definite", 3, 2, 2, {4,2,1, 2,-1,1, 1,1,-1}});
+    tests.push_back({"indefinite Schur complement", 3, 1, 1, {4,1,1, 1,-1,0, 1,0,1}});
+
+    //larger matrices: [A B^T; B C] with A = diag(a) + 0.1 and C = -diag(c) + 0.1 for which one
+    //entry of 'a' (or of 'c') is negative
+    const int n1=12, n2=8, n=n1+n2;
+    for(int t=0; t<2; t++) {
+      TestMatrix tm = {t==0 ? "(1,1) block not positive definite, n=20" : "indefinite Schur complement, n=20",
+		       n, n1, n2+(t==0 ? 1 : -1), std::vector<double>(n*n)};
+      for(int i=0; i<n; i++)
+	for(int j=0; j<n; j++) {
+	  double v;
+	  if(i<n1 && j<n1)        v = 0.1 + (i==j ? 2.+i : 0.);
+	  else if(i>=n1 && j>=n1) v = 0.1 + (i==j ? -(2.+i) : 0.);
+	  else                    v = 0.05*std::sin(1.+i*j);
+	  tm.A[i*n+j] = v;
+	}
+      if(t==0) tm.A[3*n+3] = -5.;
+      else     tm.A[(n1+2)*n+n1+2] = 30.;
+      tests.push_back(tm);
+    }
+
+    for(const TestMatrix& tm : tests) {
+      double err_auto, err_ldl, err_blk_auto, err_blk_ldl;
+      const int neg_auto = factorize_and_solve(nlp_auto, tm.A, tm.n, tm.n11, err_auto, err_blk_auto);
+      const int neg_ldl  = factorize_and_solve(nlp_ldl,  tm.A, tm.n, -1, err_ldl, err_blk_ldl);
+      const bool ok = neg_auto==tm.neg && neg_ldl==tm.neg && err_auto<1e-10 && err_ldl<1e-10 &&
+	err_blk_auto<1e-12 && err_blk_ldl<1e-12;
+      printf("%-44s neg.eig.: auto %2d, ldl %2d (expected %2d)  error: auto %10.3e, ldl %10.3e  "
+	     "multiple rhs: auto %10.3e, ldl %10.3e %s\n",
+	     tm.name, neg_auto, neg_ldl, tm.neg, err_auto, err_ldl, err_blk_auto, err_blk_ldl, ok ? "" : " FAILED");
+      if(!ok) fail++;
+    }
+  }
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return fail;
+}
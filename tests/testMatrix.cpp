@@ -129,6 +129,7 @@ int main(int argc, char** argv)
     hiop::hiopMatrixDenseRowMajor A_mxk_local(M_global, K_global);
     hiop::hiopMatrixDenseRowMajor A_kxn_local(K_global, N_global);
     hiop::hiopMatrixDenseRowMajor A_mxn_local(M_global, N_global);
+    hiop::hiopMatrixDenseRowMajor A_mxm_local(M_global, M_global);
 
     // Vectors with shape of the form:
     // x_<size>_<distributed or local>
@@ -167,8 +168,11 @@ int main(int argc, char** argv)
 
     fail += test.matrixTransTimesMat(A_mxk_local, A_kxn, A_mxn, rank);
     fail += test.matrixTimesMatTrans(A_kxm, A_kxn_local, A_nxm, rank);
+    fail += test.matrixSymTimesMatTrans(A_mxm_local, A_mxn, rank);
     fail += test.matrixAddMatrix(A_mxn, B_mxn, rank);
     fail += test.matrixMaxAbsValue(A_mxn, rank);
+    fail += test.matrixRowMaxAbsValue(A_mxn, x_m_nodist, rank);
+    fail += test.matrixScaleRow(A_mxn, x_m_nodist, rank);
     fail += test.matrixIsFinite(A_mxn, rank);
     fail += test.matrixNumRows(A_mxn, M_global, rank);
     fail += test.matrixNumCols(A_mxn, N_global, rank);
@@ -181,6 +185,8 @@ int main(int argc, char** argv)
     // one extra row for this purpose.
     hiop::hiopMatrixDenseRowMajor A_mxn_extra_row(M_global, N_global, n_partition, comm, M_global+1);
     fail += test.matrixAppendRow(A_mxn_extra_row, x_n_dist, rank);
+    hiop::hiopMatrixDenseRowMajor A_mxn_view_row(M_global, N_global, n_partition, comm, M_global+1);
+    fail += test.matrixNewRowsView(A_mxn_view_row, rank);
     fail += test.matrixCopyRowsFrom(A_kxn, A_mxn, rank);
     fail += test.matrixCopyRowsFromSelect(A_mxn, A_kxn, rank);
     fail += test.matrixShiftRows(A_mxn, rank);
@@ -56,9 +56,12 @@
 #include <iostream>
 #include <cassert>
 #include <cstring>
+#include <cmath>
+#include <algorithm>
 
 #include <hiopVector.hpp>
 #include <hiopMatrixDenseRowMajor.hpp>
+#include <hiopMatrixSparseCSR.hpp>
 #include "LinAlg/matrixTestsSparseTriplet.hpp"
 
 /// Generate a sparse matrix in triplet format
@@ -127,6 +130,8 @@ int main(int argc, char** argv)
     fail += test.matrixTimesVec(mxn_sparse, vec_m, vec_n);
     fail += test.matrixTransTimesVec(mxn_sparse, vec_m, vec_n);
     fail += test.matrixMaxAbsValue(mxn_sparse);
+    fail += test.matrixRowMaxAbsValue(mxn_sparse, vec_m);
+    fail += test.matrixScaleRow(mxn_sparse, vec_m);
     fail += test.matrixIsFinite(mxn_sparse);
 
     // Need a dense matrix to store the output of the following tests
@@ -152,6 +157,66 @@ int main(int argc, char** argv)
     fail += test.tripletAddMDinvNtransToSymDeMatUTri(mxn_sparse, m2xn_sparse, vec_n, W_dense, i_offset, j_offset);
   }
 
+  // Test Sparse CSR Matrix (same storage of the nonzeros as the triplet matrix)
+  {
+    std::cout << "Testing hiopMatrixSparseCSR" << "\n";
+    hiop::tests::MatrixTestsSparseTriplet test;
+
+    local_ordinal_type entries_per_row = 5;
+    local_ordinal_type nnz = M_local * entries_per_row;
+
+    hiop::hiopMatrixSparseCSR mxn_sparse(M_local, N_local, nnz);
+
+    initializeSparseTriplet(mxn_sparse, entries_per_row);
+  
+    hiop::hiopVectorPar vec_m(M_global);
+    hiop::hiopVectorPar vec_n(N_global);
+
+    fail += test.matrixNumRows(mxn_sparse, M_global);
+    fail += test.matrixNumCols(mxn_sparse, N_global);
+    fail += test.matrixSetToZero(mxn_sparse);
+    fail += test.matrixSetToConstant(mxn_sparse);
+    fail += test.matrixTimesVec(mxn_sparse, vec_m, vec_n);
+    fail += test.matrixTransTimesVec(mxn_sparse, vec_m, vec_n);
+    fail += test.matrixMaxAbsValue(mxn_sparse);
+    fail += test.matrixRowMaxAbsValue(mxn_sparse, vec_m);
+    fail += test.matrixScaleRow(mxn_sparse, vec_m);
+    fail += test.matrixIsFinite(mxn_sparse);
+
+    // The products need to match the ones of the triplet matrix for distinct values
+    hiop::hiopMatrixSparseTriplet mxn_triplet(M_local, N_local, nnz);
+    initializeSparseTriplet(mxn_triplet, entries_per_row);
+    for(local_ordinal_type k=0; k<nnz; k++)
+      mxn_sparse.M()[k] = mxn_triplet.M()[k] = 1.+k;
+    for(local_ordinal_type i=0; i<M_local; i++) vec_m.local_data()[i] = 1./(1.+i);
+    for(local_ordinal_type j=0; j<N_local; j++) vec_n.local_data()[j] = 1./(1.+j);
+
+    hiop::hiopVectorPar y_m(M_global), y_n(N_global);
+    y_m.setToConstant(one);
+    y_n.setToConstant(one);
+    mxn_sparse.timesVec(half, y_m, two, vec_n);
+    vec_m.setToConstant(one);
+    mxn_triplet.timesVec(half, vec_m, two, vec_n);
+    double err = 0.;
+    for(local_ordinal_type i=0; i<M_local; i++)
+      err = std::max(err, std::fabs(y_m.local_data()[i]-vec_m.local_data()[i]));
+    if(err > 1e-12) {
+      std::cout << "hiopMatrixSparseCSR timesVec does not match the triplet matrix\n";
+      fail++;
+    }
+    for(local_ordinal_type i=0; i<M_local; i++) vec_m.local_data()[i] = 1./(1.+i);
+    mxn_sparse.transTimesVec(half, y_n, two, vec_m);
+    vec_n.setToConstant(one);
+    mxn_triplet.transTimesVec(half, vec_n, two, vec_m);
+    err = 0.;
+    for(local_ordinal_type j=0; j<N_local; j++)
+      err = std::max(err, std::fabs(y_n.local_data()[j]-vec_n.local_data()[j]));
+    if(err > 1e-12) {
+      std::cout << "hiopMatrixSparseCSR transTimesVec does not match the triplet matrix\n";
+      fail++;
+    }
+  }
+
   // Test RAJA matrix
   {
     // Code here ...
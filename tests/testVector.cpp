@@ -105,6 +105,10 @@ int main(int argc, char** argv)
 
   int fail = 0;
 
+  // exercise the threaded kernels also on the short test vectors
+  hiop::hiopOmpParams omp_params;
+  omp_params.set(0, 0);
+
   // Test parallel vector
   {
     hiop::hiopVectorPar x(Nglobal, n_partition, comm);
@@ -115,6 +119,9 @@ int main(int argc, char** argv)
 
     // Allocate a vector smaller than x for testing copying operations
     hiop::hiopVectorPar x_smaller(Mglobal, m_partition, comm);
+    for(hiop::hiopVectorPar* v : {&x, &y, &z, &a, &b, &x_smaller}) {
+      v->set_omp_params(&omp_params);
+    }
     hiop::tests::VectorTestsPar test;
 
     fail += test.vectorGetSize(x, Nglobal, rank);